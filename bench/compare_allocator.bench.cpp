@@ -0,0 +1,118 @@
+#include <benchmark/benchmark.h>
+#include <cstddef>
+#include <memory_resource>
+#include <random>
+#include <vector>
+
+#include "../src/d_ary_heap.hpp"
+#include "../src/priority_queue.hpp"
+
+using namespace custom_cont;
+
+// 内存资源的种类。
+enum class ResourceTyp {
+    // 不使用内存资源，使用默认的分配器。
+    DEFAULT,
+    // 每个周期使用一个新的单调缓冲区，它的初始缓冲区在所有周期之间复用，周期结束时一次性释放。
+    MONOTONIC,
+    // 所有周期共用一个非线程安全的内存池。
+    POOL
+};
+
+// 生成包含num_data个随机整数的数据集。
+std::vector<int> genIntsForTest(size_t num_data, int seed = 1995)
+{
+    std::mt19937 rand_gen(seed);
+    std::uniform_int_distribution<int> rand_dist;
+    std::vector<int> dataset(num_data);
+    for (auto& data : dataset) {
+        data = rand_dist(rand_gen);
+    }
+    return dataset;
+}
+
+// 每个周期构造一个空的最小堆，插入state.range(0)个节点后全部取出，再析构堆，模拟每次搜索请求使用一个短暂的堆。
+template <int d, ResourceTyp resource_typ>
+void benchHeapCycle(benchmark::State& state)
+{
+    auto num_nodes = static_cast<size_t>(state.range(0));
+    const auto nodes = genIntsForTest(num_nodes);
+    std::vector<std::byte> buffer(64 * num_nodes + 4096);
+    std::pmr::unsynchronized_pool_resource pool;
+    for (auto _ : state) {
+        if constexpr (resource_typ == ResourceTyp::DEFAULT) {
+            auto min_heap = createEmptyMinDHeap<int, d>();
+            for (int node : nodes) {
+                min_heap.push(node);
+            }
+            while (!min_heap.empty()) {
+                benchmark::DoNotOptimize(min_heap.popAndReturn());
+            }
+        } else {
+            std::pmr::monotonic_buffer_resource arena(buffer.data(), buffer.size());
+            auto min_heap = pmr::createEmptyMinDHeap<int, d>(
+                resource_typ == ResourceTyp::MONOTONIC ? static_cast<std::pmr::memory_resource*>(&arena) : &pool);
+            for (int node : nodes) {
+                min_heap.push(node);
+            }
+            while (!min_heap.empty()) {
+                benchmark::DoNotOptimize(min_heap.popAndReturn());
+            }
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * num_nodes);
+}
+
+// 每个周期构造一个空的最小优先队列，插入state.range(0)个元素和它们的优先级后全部取出，再析构队列。
+template <int d, ResourceTyp resource_typ>
+void benchPriQueueCycle(benchmark::State& state)
+{
+    auto num_elements = static_cast<size_t>(state.range(0));
+    const auto priorities = genIntsForTest(num_elements);
+    std::vector<std::byte> buffer(128 * num_elements + 4096);
+    std::pmr::unsynchronized_pool_resource pool;
+    for (auto _ : state) {
+        if constexpr (resource_typ == ResourceTyp::DEFAULT) {
+            auto min_pri_queue = createEmptyMinPriQueue<int, int, d>();
+            for (size_t i = 0; i < num_elements; i++) {
+                min_pri_queue.push(static_cast<int>(i), priorities[i]);
+            }
+            while (!min_pri_queue.empty()) {
+                benchmark::DoNotOptimize(min_pri_queue.popAndReturn());
+            }
+        } else {
+            std::pmr::monotonic_buffer_resource arena(buffer.data(), buffer.size());
+            auto min_pri_queue = pmr::createEmptyMinPriQueue<int, int, d>(
+                resource_typ == ResourceTyp::MONOTONIC ? static_cast<std::pmr::memory_resource*>(&arena) : &pool);
+            for (size_t i = 0; i < num_elements; i++) {
+                min_pri_queue.push(static_cast<int>(i), priorities[i]);
+            }
+            while (!min_pri_queue.empty()) {
+                benchmark::DoNotOptimize(min_pri_queue.popAndReturn());
+            }
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * num_elements);
+}
+
+int main(int argc, char** argv)
+{
+    // ----------------------------------------------------------------------------
+    // d_ary_heap
+    BENCHMARK_TEMPLATE(benchHeapCycle, 4, ResourceTyp::DEFAULT)->RangeMultiplier(16)->Range(16, 1 << 16);
+    BENCHMARK_TEMPLATE(benchHeapCycle, 4, ResourceTyp::MONOTONIC)->RangeMultiplier(16)->Range(16, 1 << 16);
+    BENCHMARK_TEMPLATE(benchHeapCycle, 4, ResourceTyp::POOL)->RangeMultiplier(16)->Range(16, 1 << 16);
+    // ----------------------------------------------------------------------------
+    // priority_queue
+    BENCHMARK_TEMPLATE(benchPriQueueCycle, 4, ResourceTyp::DEFAULT)->RangeMultiplier(16)->Range(16, 1 << 16);
+    BENCHMARK_TEMPLATE(benchPriQueueCycle, 4, ResourceTyp::MONOTONIC)->RangeMultiplier(16)->Range(16, 1 << 16);
+    BENCHMARK_TEMPLATE(benchPriQueueCycle, 4, ResourceTyp::POOL)->RangeMultiplier(16)->Range(16, 1 << 16);
+    // ----------------------------------------------------------------------------
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv)) {
+        return 1;
+    }
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
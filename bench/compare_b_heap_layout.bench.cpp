@@ -0,0 +1,118 @@
+#include <algorithm>
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "../src/d_ary_heap.hpp"
+#include "../src/heap_layout.hpp"
+
+using namespace custom_cont;
+
+// 可以统计下沉路径所访问的内存页数量的最小堆。
+template <int d, typename Layout>
+class PageCountingMinHeap : public DAryHeap<uint64_t, d, std::greater<uint64_t>, Layout> {
+    using Heap = DAryHeap<uint64_t, d, std::greater<uint64_t>, Layout>;
+
+public:
+    PageCountingMinHeap()
+        : Heap(d, std::greater<uint64_t>(), std::vector<uint64_t>())
+    {
+    }
+    // 返回移除堆顶节点时空位从堆顶下移到叶节点的路径上，所比较的每组兄弟节点和堆顶节点共访问了多少个内存页。
+    size_t pagesOnPopPath() const
+    {
+        auto page_of = [](const uint64_t& node) { return reinterpret_cast<uintptr_t>(&node) / MEMORY_PAGE_SIZE; };
+        std::vector<uintptr_t> pages { page_of(this->nodeAt(0)) };
+        size_t pos = 0;
+        while (!this->isLeafNode(pos)) {
+            size_t first_child_pos = this->getChildNodePos(pos, 0);
+            // 子节点的位置是数组中的位置，分页布局中会超过节点数量，因此以endPos()为界。
+            size_t last_child_pos = std::min(first_child_pos + d, this->endPos()) - 1;
+            pages.push_back(page_of(this->nodeAt(first_child_pos)));
+            pages.push_back(page_of(this->nodeAt(last_child_pos)));
+            pos = this->getBestChildNodePos(pos);
+        }
+        std::sort(pages.begin(), pages.end());
+        return static_cast<size_t>(std::unique(pages.begin(), pages.end()) - pages.begin());
+    }
+};
+
+// 在包含state.range(0)个随机键的最小堆上反复取出堆顶并插入一个更大的随机键（hold模型），堆的大小保持不变。
+// 计时结束后再执行若干次同样的操作，统计每次移除堆顶节点时下沉路径访问的内存页数量。
+template <int d, typename Layout>
+void benchHold(benchmark::State& state)
+{
+    auto num_nodes = static_cast<size_t>(state.range(0));
+    std::mt19937_64 rand_gen(1995);
+    PageCountingMinHeap<d, Layout> min_heap;
+    min_heap.reserve(num_nodes);
+    for (size_t i = 0; i < num_nodes; i++) {
+        min_heap.push(rand_gen());
+    }
+    for (auto _ : state) {
+        uint64_t top_key = min_heap.popAndReturn();
+        benchmark::DoNotOptimize(top_key);
+        min_heap.push(top_key + (rand_gen() >> 8));
+    }
+    state.SetItemsProcessed(state.iterations());
+    constexpr size_t NUM_SAMPLES = 1 << 12;
+    size_t num_pages = 0;
+    for (size_t i = 0; i < NUM_SAMPLES; i++) {
+        num_pages += min_heap.pagesOnPopPath();
+        uint64_t top_key = min_heap.popAndReturn();
+        min_heap.push(top_key + (rand_gen() >> 8));
+    }
+    state.counters["pages_per_pop"] = static_cast<double>(num_pages) / NUM_SAMPLES;
+}
+
+// 节点数组最多占用的内存（字节），超过它的用例被跳过。
+constexpr size_t MAX_HEAP_BYTES = size_t(10) << 30;
+
+// 返回使用布局Layout存储num_nodes个节点时节点数组占用的内存（字节）。分页布局中每页只有一部分位置存放节点，
+// 以8字节的节点为例，4KB的页在d = 2、4、8时分别存放510、340和72个节点，10^9个节点约占用8GB、12GB和57GB。
+template <int d, typename Layout>
+size_t heapBytes(size_t num_nodes)
+{
+    if constexpr (Layout::PADDED) {
+        return (Layout::template nodePos<sizeof(uint64_t), d>(num_nodes) + d) * sizeof(uint64_t);
+    } else {
+        return num_nodes * sizeof(uint64_t);
+    }
+}
+
+// 堆中有10^6到10^9个节点，跳过节点数组超过MAX_HEAP_BYTES的用例（d = 4和d = 8时的分页布局中的10^9个节点）。
+template <int d, typename Layout>
+void heapSizes(benchmark::internal::Benchmark* bench)
+{
+    for (int64_t num_nodes : { 1000000LL, 10000000LL, 100000000LL, 1000000000LL }) {
+        if (heapBytes<d, Layout>(static_cast<size_t>(num_nodes)) <= MAX_HEAP_BYTES) {
+            bench->Arg(num_nodes);
+        }
+    }
+}
+
+int main(int argc, char** argv)
+{
+    benchmark::SetDefaultTimeUnit(benchmark::TimeUnit::kNanosecond);
+    // ----------------------------------------------------------------------------
+    // d = 2 (4KB的页可以容纳8层，共510个节点)
+    BENCHMARK_TEMPLATE(benchHold, 2, ImplicitLayout)->Apply(heapSizes<2, ImplicitLayout>)->Iterations(1 << 22);
+    BENCHMARK_TEMPLATE(benchHold, 2, BHeapLayout<>)->Apply(heapSizes<2, BHeapLayout<>>)->Iterations(1 << 22);
+    // ----------------------------------------------------------------------------
+    // d = 4 (4KB的页可以容纳4层，共340个节点)
+    BENCHMARK_TEMPLATE(benchHold, 4, ImplicitLayout)->Apply(heapSizes<4, ImplicitLayout>)->Iterations(1 << 22);
+    BENCHMARK_TEMPLATE(benchHold, 4, BHeapLayout<>)->Apply(heapSizes<4, BHeapLayout<>>)->Iterations(1 << 22);
+    // ----------------------------------------------------------------------------
+    // d = 8 (4KB的页可以容纳2层，共72个节点)
+    BENCHMARK_TEMPLATE(benchHold, 8, ImplicitLayout)->Apply(heapSizes<8, ImplicitLayout>)->Iterations(1 << 22);
+    BENCHMARK_TEMPLATE(benchHold, 8, BHeapLayout<>)->Apply(heapSizes<8, BHeapLayout<>>)->Iterations(1 << 22);
+    // ----------------------------------------------------------------------------
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv)) {
+        return 1;
+    }
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
@@ -0,0 +1,102 @@
+#include <benchmark/benchmark.h>
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include "../src/calendar_queue.hpp"
+#include "../src/d_ary_heap.hpp"
+
+using namespace custom_cont;
+
+// 事件时间增量的分布。
+enum class Increment {
+    // 均值为1的指数分布。
+    EXPONENTIAL,
+    // 0到2之间的均匀分布。
+    UNIFORM,
+    // 双峰分布：90%的增量服从均值为0.01的指数分布，10%的增量服从均值为100的指数分布。
+    BIMODAL,
+    // 形状参数为1.1的帕累托分布，重尾，偶尔出现极大的增量。
+    PARETO
+};
+
+constexpr size_t NUM_STEPS = 1 << 18;
+
+// 生成num_data个服从分布increment的时间增量。
+std::vector<double> genIncrementsForTest(Increment increment, size_t num_data, int seed = 1995)
+{
+    std::mt19937 rand_gen(seed);
+    std::exponential_distribution<double> exp_dist(1.0);
+    std::uniform_real_distribution<double> uniform_dist(0.0, 2.0);
+    std::uniform_int_distribution<int> mode_dist(0, 9);
+    std::vector<double> dataset(num_data);
+    for (auto& data : dataset) {
+        if (increment == Increment::EXPONENTIAL) {
+            data = exp_dist(rand_gen);
+        } else if (increment == Increment::UNIFORM) {
+            data = uniform_dist(rand_gen);
+        } else if (increment == Increment::PARETO) {
+            data = std::exp(exp_dist(rand_gen) / 1.1) - 1.0;
+        } else {
+            data = mode_dist(rand_gen) == 0 ? 100.0 * exp_dist(rand_gen) : 0.01 * exp_dist(rand_gen);
+        }
+    }
+    return dataset;
+}
+
+// hold模型：在保持state.range(0)个事件的事件表中，反复取出最早的事件，再插入一个比它晚一个随机增量的事件。
+template <typename TQueue>
+void holdQueue(benchmark::State& state, Increment increment, TQueue queue)
+{
+    auto num_events = static_cast<size_t>(state.range(0));
+    for (double time : genIncrementsForTest(increment, num_events, 2024)) {
+        queue.push(time);
+    }
+    const auto increments = genIncrementsForTest(increment, NUM_STEPS);
+    size_t step_idx = 0;
+    for (auto _ : state) {
+        double now = queue.popAndReturn();
+        queue.push(now + increments[step_idx]);
+        step_idx = (step_idx + 1) % NUM_STEPS;
+    }
+}
+
+// 在CalendarQueue上执行holdQueue。
+template <Increment increment>
+void benchCalendarQueue(benchmark::State& state)
+{
+    holdQueue(state, increment, createEmptyCalendarQueue<double>());
+}
+
+// 在每个父节点最多有d个子节点的最小堆上执行holdQueue。
+template <Increment increment, int d>
+void benchHeap(benchmark::State& state)
+{
+    holdQueue(state, increment, createEmptyMinDHeap<double, d>());
+}
+
+int main(int argc, char** argv)
+{
+    benchmark::SetDefaultTimeUnit(benchmark::TimeUnit::kNanosecond);
+    // ----------------------------------------------------------------------------
+    // calendar_queue
+    BENCHMARK_TEMPLATE(benchCalendarQueue, Increment::EXPONENTIAL)->Arg(1 << 4)->Arg(1 << 10)->Arg(1 << 16)->Arg(1 << 20);
+    BENCHMARK_TEMPLATE(benchCalendarQueue, Increment::UNIFORM)->Arg(1 << 4)->Arg(1 << 10)->Arg(1 << 16)->Arg(1 << 20);
+    BENCHMARK_TEMPLATE(benchCalendarQueue, Increment::BIMODAL)->Arg(1 << 4)->Arg(1 << 10)->Arg(1 << 16)->Arg(1 << 20);
+    BENCHMARK_TEMPLATE(benchCalendarQueue, Increment::PARETO)->Arg(1 << 4)->Arg(1 << 10)->Arg(1 << 16)->Arg(1 << 20);
+    // ----------------------------------------------------------------------------
+    // d_ary_heap
+    BENCHMARK_TEMPLATE(benchHeap, Increment::EXPONENTIAL, 2)->Arg(1 << 4)->Arg(1 << 10)->Arg(1 << 16)->Arg(1 << 20);
+    BENCHMARK_TEMPLATE(benchHeap, Increment::EXPONENTIAL, 4)->Arg(1 << 4)->Arg(1 << 10)->Arg(1 << 16)->Arg(1 << 20);
+    BENCHMARK_TEMPLATE(benchHeap, Increment::UNIFORM, 4)->Arg(1 << 4)->Arg(1 << 10)->Arg(1 << 16)->Arg(1 << 20);
+    BENCHMARK_TEMPLATE(benchHeap, Increment::BIMODAL, 4)->Arg(1 << 4)->Arg(1 << 10)->Arg(1 << 16)->Arg(1 << 20);
+    BENCHMARK_TEMPLATE(benchHeap, Increment::PARETO, 4)->Arg(1 << 4)->Arg(1 << 10)->Arg(1 << 16)->Arg(1 << 20);
+    // ----------------------------------------------------------------------------
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv)) {
+        return 1;
+    }
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
@@ -0,0 +1,113 @@
+#include <benchmark/benchmark.h>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "../src/concurrent_priority_queue.hpp"
+#include "../src/priority_queue.hpp"
+
+using namespace custom_cont;
+
+// 队列中初始元素的数量。
+constexpr int NUM_INITIAL_ELEMENTS = 1 << 16;
+// 每个线程预先生成的增量的数量。
+constexpr size_t NUM_INCREMENTS = 1 << 16;
+// 最多使用的线程数。
+constexpr int MAX_THREADS = 32;
+
+// 生成num_data个0到999之间的随机整数。
+std::vector<int> genIntsForTest(size_t num_data, int seed = 1995)
+{
+    std::mt19937 rand_gen(seed);
+    std::uniform_int_distribution<int> rand_dist(0, 999);
+    std::vector<int> dataset(num_data);
+    for (auto& data : dataset) {
+        data = rand_dist(rand_gen);
+    }
+    return dataset;
+}
+
+// 用一个互斥锁保护的PriQueue，作为对比。
+class LockedPriQueue {
+    std::mutex mutex_;
+    PriQueue<int, int, std::hash<int>, 4, std::greater<>> pri_queue_ { createEmptyMinPriQueue<int, int, 4>() };
+
+public:
+    void push(int element, int pri)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        pri_queue_.push(element, pri);
+    }
+    bool tryPop(std::pair<int, int>& node)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (pri_queue_.empty()) {
+            return false;
+        }
+        node = pri_queue_.popAndReturn();
+        return true;
+    }
+};
+
+// 多个线程同时反复从队列中取出第一个元素，再以增加了一个随机增量的优先级将它重新插入，统计吞吐量。
+template <typename TQueue, typename CreateQueue>
+void holdQueue(benchmark::State& state, CreateQueue create_queue)
+{
+    static std::unique_ptr<TQueue> queue;
+    if (state.thread_index() == 0) {
+        queue = create_queue();
+        const auto priorities = genIntsForTest(NUM_INITIAL_ELEMENTS);
+        for (int i = 0; i < NUM_INITIAL_ELEMENTS; i++) {
+            queue->push(i, priorities[i]);
+        }
+    }
+    const auto increments = genIntsForTest(NUM_INCREMENTS, state.thread_index() + 1);
+    size_t step_idx = 0;
+    for (auto _ : state) {
+        std::pair<int, int> node;
+        if (queue->tryPop(node)) {
+            queue->push(node.first, node.second + increments[step_idx]);
+        }
+        step_idx = (step_idx + 1) % NUM_INCREMENTS;
+    }
+    state.SetItemsProcessed(state.iterations());
+    if (state.thread_index() == 0) {
+        queue.reset();
+    }
+}
+
+// 在平面合并的ConcurrentPriQueue上执行holdQueue。
+void benchConcurrentPriQueue(benchmark::State& state)
+{
+    using TQueue = ConcurrentPriQueue<PriQueue<int, int, std::hash<int>, 4, std::greater<>>>;
+    holdQueue<TQueue>(state, [&state]() {
+        return std::make_unique<TQueue>(createEmptyMinPriQueue<int, int, 4>(), state.threads());
+    });
+}
+
+// 在LockedPriQueue上执行holdQueue。
+void benchLockedPriQueue(benchmark::State& state)
+{
+    holdQueue<LockedPriQueue>(state, []() { return std::make_unique<LockedPriQueue>(); });
+}
+
+int main(int argc, char** argv)
+{
+    benchmark::SetDefaultTimeUnit(benchmark::TimeUnit::kNanosecond);
+    // ----------------------------------------------------------------------------
+    // concurrent_priority_queue
+    BENCHMARK(benchConcurrentPriQueue)->ThreadRange(1, MAX_THREADS)->UseRealTime();
+    // ----------------------------------------------------------------------------
+    // priority_queue
+    BENCHMARK(benchLockedPriQueue)->ThreadRange(1, MAX_THREADS)->UseRealTime();
+    // ----------------------------------------------------------------------------
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv)) {
+        return 1;
+    }
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
@@ -1,5 +1,6 @@
 #include <algorithm>
 #include <benchmark/benchmark.h>
+#include <iterator>
 #include <tuple>
 #include <vector>
 
@@ -11,7 +12,9 @@ using namespace custom_cont;
 
 // 用于测试的容器的种类。
 enum class Container { CustomHeap,
+    CustomHeapBottomUp,
     CustomPriQueue,
+    CustomPriQueueBottomUp,
     STDPriQueue };
 
 // 适用于bench d ary heap的fixture，包含测试数据集和一些工具函数。
@@ -50,6 +53,12 @@ public:
             createEmptyMinPriQueue<MyNode, int, MyNodeHasher>(),
             createEmptyMaxPriQueue<MyNode, int, MyNodeHasher>());
     }
+    // 设置一组容器移除堆顶节点时所使用的修复策略。
+    template <typename TConts>
+    static void setPopStrategy(TConts& containers, PopStrategy pop_strategy)
+    {
+        std::apply([&](auto&... container) { (container.setPopStrategy(pop_strategy), ...); }, containers);
+    }
     // 对容器进行count次pop操作。
     template <typename TCont>
     static void containerPop(TCont& container, size_t count)
@@ -138,8 +147,12 @@ void benchPushThenPop(benchmark::State& state)
     const auto& nodes = fixture.getNodesForTest();
     const auto& priorities = fixture.getPrioritiesForTest();
     for (auto _ : state) {
-        if (cont_type == Container::CustomHeap) {
-            auto [min_heap_str, max_heap_str, min_heap_node, max_heap_node] = fixture.createHeap();
+        if (cont_type == Container::CustomHeap || cont_type == Container::CustomHeapBottomUp) {
+            auto heaps = fixture.createHeap();
+            if (cont_type == Container::CustomHeapBottomUp) {
+                BenchDAryHeapFixture::setPopStrategy(heaps, PopStrategy::BOTTOM_UP);
+            }
+            auto& [min_heap_str, max_heap_str, min_heap_node, max_heap_node] = heaps;
             BenchDAryHeapFixture::containerPush(min_heap_str, strings, count);
             BenchDAryHeapFixture::containerPush(max_heap_str, strings, count);
             BenchDAryHeapFixture::containerPush(min_heap_node, nodes, count);
@@ -149,8 +162,12 @@ void benchPushThenPop(benchmark::State& state)
             BenchDAryHeapFixture::containerPop(min_heap_node, count);
             BenchDAryHeapFixture::containerPop(max_heap_node, count);
 
-        } else if (cont_type == Container::CustomPriQueue) {
-            auto [min_pri_queue_str, max_pri_queue_str, min_pri_queue_node, max_pri_queue_node] = fixture.createPriorityQueue();
+        } else if (cont_type == Container::CustomPriQueue || cont_type == Container::CustomPriQueueBottomUp) {
+            auto pri_queues = fixture.createPriorityQueue();
+            if (cont_type == Container::CustomPriQueueBottomUp) {
+                BenchDAryHeapFixture::setPopStrategy(pri_queues, PopStrategy::BOTTOM_UP);
+            }
+            auto& [min_pri_queue_str, max_pri_queue_str, min_pri_queue_node, max_pri_queue_node] = pri_queues;
             BenchDAryHeapFixture::containerPush(min_pri_queue_str, strings, strings, count);
             BenchDAryHeapFixture::containerPush(max_pri_queue_str, strings, strings, count);
             BenchDAryHeapFixture::containerPush(min_pri_queue_node, nodes, priorities, count);
@@ -173,6 +190,53 @@ void benchPushThenPop(benchmark::State& state)
     }
 }
 
+// 向种类为cont type的容器中插入count个节点后取出前k个节点，逐个调用popAndReturn或者调用一次popN。
+template <Container cont_type, size_t count, size_t k, bool use_pop_n>
+void benchPopTopK(benchmark::State& state)
+{
+    const auto& nodes = fixture.getNodesForTest();
+    const auto& priorities = fixture.getPrioritiesForTest();
+    auto min_heap_node = createEmptyMinDHeap<MyNode>();
+    auto min_pri_queue_node = createEmptyMinPriQueue<MyNode, int, MyNodeHasher>();
+    std::vector<MyNode> popped_nodes;
+    std::vector<std::pair<MyNode, int>> popped_nodes_with_pri;
+    popped_nodes.reserve(k);
+    popped_nodes_with_pri.reserve(k);
+    for (auto _ : state) {
+        // 在暂停计时期间准备容器，旧的容器也在此时被清空。
+        state.PauseTiming();
+        popped_nodes.clear();
+        popped_nodes_with_pri.clear();
+        if constexpr (cont_type == Container::CustomHeap) {
+            min_heap_node = createEmptyMinDHeap<MyNode>();
+            BenchDAryHeapFixture::containerPush(min_heap_node, nodes, count);
+        } else {
+            min_pri_queue_node = createEmptyMinPriQueue<MyNode, int, MyNodeHasher>();
+            BenchDAryHeapFixture::containerPush(min_pri_queue_node, nodes, priorities, count);
+        }
+        state.ResumeTiming();
+        if constexpr (cont_type == Container::CustomHeap) {
+            if constexpr (use_pop_n) {
+                min_heap_node.popN(k, std::back_inserter(popped_nodes));
+            } else {
+                for (size_t i = 0; i < k; i++) {
+                    popped_nodes.push_back(min_heap_node.popAndReturn());
+                }
+            }
+        } else {
+            if constexpr (use_pop_n) {
+                min_pri_queue_node.popN(k, std::back_inserter(popped_nodes_with_pri));
+            } else {
+                for (size_t i = 0; i < k; i++) {
+                    popped_nodes_with_pri.push_back(min_pri_queue_node.popAndReturn());
+                }
+            }
+        }
+        benchmark::DoNotOptimize(popped_nodes.data());
+        benchmark::DoNotOptimize(popped_nodes_with_pri.data());
+    }
+}
+
 int main(int argc, char** argv)
 {
     benchmark::SetDefaultTimeUnit(benchmark::TimeUnit::kMillisecond);
@@ -207,6 +271,26 @@ int main(int argc, char** argv)
     BENCHMARK_TEMPLATE(benchPush, Container::CustomPriQueue, 7000);
     BENCHMARK_TEMPLATE(benchPushThenPop, Container::CustomPriQueue, 7000);
     // ----------------------------------------------------------------------------
+    // bottom-up pop strategy
+    BENCHMARK_TEMPLATE(benchPushThenPop, Container::CustomHeapBottomUp, 1000);
+    BENCHMARK_TEMPLATE(benchPushThenPop, Container::CustomHeapBottomUp, 7000);
+    BENCHMARK_TEMPLATE(benchPushThenPop, Container::CustomPriQueueBottomUp, 1000);
+    BENCHMARK_TEMPLATE(benchPushThenPop, Container::CustomPriQueueBottomUp, 7000);
+    // ----------------------------------------------------------------------------
+    // popN vs popAndReturn
+    BENCHMARK_TEMPLATE(benchPopTopK, Container::CustomHeap, 7000, 70, false);
+    BENCHMARK_TEMPLATE(benchPopTopK, Container::CustomHeap, 7000, 70, true);
+    BENCHMARK_TEMPLATE(benchPopTopK, Container::CustomHeap, 7000, 1000, false);
+    BENCHMARK_TEMPLATE(benchPopTopK, Container::CustomHeap, 7000, 1000, true);
+    BENCHMARK_TEMPLATE(benchPopTopK, Container::CustomHeap, 7000, 7000, false);
+    BENCHMARK_TEMPLATE(benchPopTopK, Container::CustomHeap, 7000, 7000, true);
+    BENCHMARK_TEMPLATE(benchPopTopK, Container::CustomPriQueue, 7000, 70, false);
+    BENCHMARK_TEMPLATE(benchPopTopK, Container::CustomPriQueue, 7000, 70, true);
+    BENCHMARK_TEMPLATE(benchPopTopK, Container::CustomPriQueue, 7000, 1000, false);
+    BENCHMARK_TEMPLATE(benchPopTopK, Container::CustomPriQueue, 7000, 1000, true);
+    BENCHMARK_TEMPLATE(benchPopTopK, Container::CustomPriQueue, 7000, 7000, false);
+    BENCHMARK_TEMPLATE(benchPopTopK, Container::CustomPriQueue, 7000, 7000, true);
+    // ----------------------------------------------------------------------------
     benchmark::Initialize(&argc, argv);
     if (benchmark::ReportUnrecognizedArguments(argc, argv)) {
         return 1;
@@ -36,6 +36,13 @@ public:
         return std::make_tuple(createEmptyMinDHeap<std::string>(d), createEmptyMaxDHeap<std::string>(d),
             createEmptyMinDHeap<MyNode>(d), createEmptyMaxDHeap<MyNode>(d));
     }
+    // 构造空的D ary heap用于测试，其中d在编译期确定。
+    template <int d>
+    static auto createStaticHeap()
+    {
+        return std::make_tuple(createEmptyMinDHeap<std::string, d>(), createEmptyMaxDHeap<std::string, d>(),
+            createEmptyMinDHeap<MyNode, d>(), createEmptyMaxDHeap<MyNode, d>());
+    }
     // 对容器进行count次pop操作。
     template <typename TCont>
     static void containerPop(TCont& container, size_t count)
@@ -122,6 +129,40 @@ void benchPushThenPop(benchmark::State& state)
     }
 }
 
+// 对d在编译期确定的D-ary heap执行count次push操作。
+template <int d, size_t count>
+void benchStaticPush(benchmark::State& state)
+{
+    const auto& strings = fixture.getStringsForTest();
+    const auto& nodes = fixture.getNodesForTest();
+    for (auto _ : state) {
+        auto [min_heap_str, max_heap_str, min_heap_node, max_heap_node] = fixture.createStaticHeap<d>();
+        BenchDAryHeapFixture::containerPush(min_heap_str, strings, count);
+        BenchDAryHeapFixture::containerPush(max_heap_str, strings, count);
+        BenchDAryHeapFixture::containerPush(min_heap_node, nodes, count);
+        BenchDAryHeapFixture::containerPush(max_heap_node, nodes, count);
+    }
+}
+
+// 对d在编译期确定的D-ary heap执行count次push和pop操作。
+template <int d, size_t count>
+void benchStaticPushThenPop(benchmark::State& state)
+{
+    const auto& strings = fixture.getStringsForTest();
+    const auto& nodes = fixture.getNodesForTest();
+    for (auto _ : state) {
+        auto [min_heap_str, max_heap_str, min_heap_node, max_heap_node] = fixture.createStaticHeap<d>();
+        BenchDAryHeapFixture::containerPush(min_heap_str, strings, count);
+        BenchDAryHeapFixture::containerPush(max_heap_str, strings, count);
+        BenchDAryHeapFixture::containerPush(min_heap_node, nodes, count);
+        BenchDAryHeapFixture::containerPush(max_heap_node, nodes, count);
+        BenchDAryHeapFixture::containerPop(min_heap_str, count);
+        BenchDAryHeapFixture::containerPop(max_heap_str, count);
+        BenchDAryHeapFixture::containerPop(min_heap_node, count);
+        BenchDAryHeapFixture::containerPop(max_heap_node, count);
+    }
+}
+
 int main(int argc, char** argv)
 {
     benchmark::SetDefaultTimeUnit(benchmark::TimeUnit::kMillisecond);
@@ -138,6 +179,18 @@ int main(int argc, char** argv)
     BENCHMARK_TEMPLATE(benchPush, 10, 7000);
     BENCHMARK_TEMPLATE(benchPushThenPop, 10, 7000);
     // ----------------------------------------------------------------------------
+    // d_ary_heap with compile-time d
+    BENCHMARK_TEMPLATE(benchStaticPush, 2, 7000);
+    BENCHMARK_TEMPLATE(benchStaticPushThenPop, 2, 7000);
+    BENCHMARK_TEMPLATE(benchStaticPush, 4, 7000);
+    BENCHMARK_TEMPLATE(benchStaticPushThenPop, 4, 7000);
+    BENCHMARK_TEMPLATE(benchStaticPush, 6, 7000);
+    BENCHMARK_TEMPLATE(benchStaticPushThenPop, 6, 7000);
+    BENCHMARK_TEMPLATE(benchStaticPush, 8, 7000);
+    BENCHMARK_TEMPLATE(benchStaticPushThenPop, 8, 7000);
+    BENCHMARK_TEMPLATE(benchStaticPush, 10, 7000);
+    BENCHMARK_TEMPLATE(benchStaticPushThenPop, 10, 7000);
+    // ----------------------------------------------------------------------------
     benchmark::Initialize(&argc, argv);
     if (benchmark::ReportUnrecognizedArguments(argc, argv)) {
         return 1;
@@ -0,0 +1,67 @@
+#include <benchmark/benchmark.h>
+#include <random>
+#include <vector>
+
+#include "../src/d_ary_heap.hpp"
+
+using namespace custom_cont;
+
+// 生成包含num_data个类型为T的随机数的数据集。
+template <typename T>
+std::vector<T> genDatasetForTest(size_t num_data, int seed = 1995)
+{
+    std::mt19937_64 rand_gen(seed);
+    std::vector<T> dataset(num_data);
+    for (auto& data : dataset) {
+        data = static_cast<T>(rand_gen() % (1u << 30));
+    }
+    return dataset;
+}
+
+// 在包含state.range(0)个节点的最小堆上反复执行pop和push操作，堆的大小保持不变，统计每次操作所需的时间。
+template <typename T, int d, typename Layout>
+void benchPopThenPush(benchmark::State& state)
+{
+    auto num_nodes = static_cast<size_t>(state.range(0));
+    auto min_heap = DAryHeap<T, d, std::greater<T>, Layout>(d, std::greater<T>(), genDatasetForTest<T>(num_nodes));
+    auto nodes_to_push = genDatasetForTest<T>(1 << 16, 2024);
+    size_t push_idx = 0;
+    for (auto _ : state) {
+        auto top_node = min_heap.popAndReturn();
+        // 新节点总是比刚弹出的节点大，使它有机会下沉到堆的深处。
+        min_heap.push(top_node + nodes_to_push[push_idx]);
+        push_idx = (push_idx + 1) & ((1 << 16) - 1);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+// 不同规模的堆：约为L2缓存大小、约为LLC大小、远超过LLC大小。
+void heapSizes(benchmark::internal::Benchmark* bench)
+{
+    bench->Arg(1 << 16)->Arg(1 << 22)->Arg(1 << 27);
+}
+
+int main(int argc, char** argv)
+{
+    benchmark::SetDefaultTimeUnit(benchmark::TimeUnit::kNanosecond);
+    // ----------------------------------------------------------------------------
+    // int, d = 16 (每组兄弟节点恰好占满一个缓存行)
+    BENCHMARK_TEMPLATE(benchPopThenPush, int, 16, ImplicitLayout)->Apply(heapSizes);
+    BENCHMARK_TEMPLATE(benchPopThenPush, int, 16, CacheAlignedLayout)->Apply(heapSizes);
+    // ----------------------------------------------------------------------------
+    // double, d = 8 (每组兄弟节点恰好占满一个缓存行)
+    BENCHMARK_TEMPLATE(benchPopThenPush, double, 8, ImplicitLayout)->Apply(heapSizes);
+    BENCHMARK_TEMPLATE(benchPopThenPush, double, 8, CacheAlignedLayout)->Apply(heapSizes);
+    // ----------------------------------------------------------------------------
+    // int, d = 4
+    BENCHMARK_TEMPLATE(benchPopThenPush, int, 4, ImplicitLayout)->Apply(heapSizes);
+    BENCHMARK_TEMPLATE(benchPopThenPush, int, 4, CacheAlignedLayout)->Apply(heapSizes);
+    // ----------------------------------------------------------------------------
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv)) {
+        return 1;
+    }
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
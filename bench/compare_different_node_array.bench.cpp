@@ -0,0 +1,70 @@
+#include <benchmark/benchmark.h>
+#include <random>
+#include <vector>
+
+#include "../src/priority_queue.hpp"
+#include "../test/test_data_generator.h"
+
+using namespace custom_cont;
+
+// 生成num_data个编号互不相同的MyNode，g和h随机。
+std::vector<MyNode> genNodesForTest(size_t num_data, int seed = 1995)
+{
+    std::mt19937 rand_gen(seed);
+    std::uniform_int_distribution<int> rand_dist(0, 1 << 20);
+    std::vector<MyNode> nodes;
+    nodes.reserve(num_data);
+    for (size_t i = 0; i < num_data; i++) {
+        nodes.emplace_back(static_cast<int>(i), rand_dist(rand_gen), rand_dist(rand_gen));
+    }
+    return nodes;
+}
+
+// 在包含state.range(0)个节点的最小优先队列上反复执行pop和push操作，队列的大小保持不变，统计每次操作所需的时间。
+template <int d, template <typename, typename, typename> class NodeArray>
+void benchPopThenPush(benchmark::State& state)
+{
+    auto nodes = genNodesForTest(static_cast<size_t>(state.range(0)));
+    std::vector<int> priorities;
+    priorities.reserve(nodes.size());
+    for (const auto& node : nodes) {
+        priorities.push_back(node.f_);
+    }
+    auto min_pri_queue = PriQueue<MyNode, int, MyNodeHasher, d, std::greater<>, ImplicitLayout, NodeArray>(
+        d, PriQueueTyp::MIN_PRI_QUEUE, std::greater<> {}, nodes, priorities);
+    std::mt19937 rand_gen(2024);
+    std::uniform_int_distribution<int> rand_dist(0, 1 << 20);
+    for (auto _ : state) {
+        auto [node, pri] = min_pri_queue.popAndReturn();
+        // 新的优先级总是比刚弹出的大，使节点有机会下沉到堆的深处。
+        min_pri_queue.push(std::move(node), pri + rand_dist(rand_gen));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+// 不同规模的队列。
+void queueSizes(benchmark::internal::Benchmark* bench)
+{
+    bench->Arg(1 << 10)->Arg(1 << 16)->Arg(1 << 20);
+}
+
+int main(int argc, char** argv)
+{
+    benchmark::SetDefaultTimeUnit(benchmark::TimeUnit::kNanosecond);
+    // ----------------------------------------------------------------------------
+    // d = 4
+    BENCHMARK_TEMPLATE(benchPopThenPush, 4, AosNodeArray)->Apply(queueSizes);
+    BENCHMARK_TEMPLATE(benchPopThenPush, 4, SoaNodeArray)->Apply(queueSizes);
+    // ----------------------------------------------------------------------------
+    // d = 16 (SoA下16个int优先级恰好占满一个缓存行，并且可以使用向量指令选择子节点)
+    BENCHMARK_TEMPLATE(benchPopThenPush, 16, AosNodeArray)->Apply(queueSizes);
+    BENCHMARK_TEMPLATE(benchPopThenPush, 16, SoaNodeArray)->Apply(queueSizes);
+    // ----------------------------------------------------------------------------
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv)) {
+        return 1;
+    }
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
@@ -0,0 +1,184 @@
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include "../src/indexed_priority_queue.hpp"
+#include "../src/lazy_priority_queue.hpp"
+#include "../src/priority_queue.hpp"
+#include "../src/radix_priority_queue.hpp"
+
+using namespace custom_cont;
+
+// 以邻接表(CSR)形式存储的有向图。
+struct Graph {
+    // 第v个顶点的出边为edge_targets_[edge_offsets_[v]]到edge_targets_[edge_offsets_[v+1]-1]。
+    std::vector<size_t> edge_offsets_;
+    std::vector<int> edge_targets_;
+    std::vector<int> edge_weights_;
+    size_t numVertices() const { return edge_offsets_.size() - 1; }
+};
+
+// 生成包含num_vertices个顶点、每个顶点有out_degree条随机出边的图，边的权重为1到1000之间的整数。
+Graph genGraphForTest(size_t num_vertices, size_t out_degree, int seed = 1995)
+{
+    std::mt19937 rand_gen(seed);
+    std::uniform_int_distribution<int> vertex_dist(0, static_cast<int>(num_vertices) - 1);
+    std::uniform_int_distribution<int> weight_dist(1, 1000);
+    Graph graph;
+    graph.edge_offsets_.reserve(num_vertices + 1);
+    for (size_t v = 0; v < num_vertices; v++) {
+        graph.edge_offsets_.push_back(graph.edge_targets_.size());
+        for (size_t i = 0; i < out_degree; i++) {
+            graph.edge_targets_.push_back(vertex_dist(rand_gen));
+            graph.edge_weights_.push_back(weight_dist(rand_gen));
+        }
+    }
+    graph.edge_offsets_.push_back(graph.edge_targets_.size());
+    return graph;
+}
+
+const auto graph = genGraphForTest(1 << 18, 8);
+
+// 使用优先队列pri_queue从第0个顶点开始运行Dijkstra算法，返回所有顶点的最短距离之和。
+template <typename TPriQueue>
+int64_t runDijkstra(TPriQueue& pri_queue)
+{
+    constexpr int INF = std::numeric_limits<int>::max();
+    std::vector<int> dists(graph.numVertices(), INF);
+    dists[0] = 0;
+    pri_queue.push(0, 0);
+    int64_t sum_of_dists = 0;
+    while (!pri_queue.empty()) {
+        auto [vertex, dist] = pri_queue.popAndReturn();
+        sum_of_dists += dist;
+        for (size_t e = graph.edge_offsets_[vertex]; e < graph.edge_offsets_[vertex + 1]; e++) {
+            int target = graph.edge_targets_[e];
+            int new_dist = dist + graph.edge_weights_[e];
+            if (new_dist >= dists[target]) {
+                continue;
+            }
+            if (dists[target] == INF) {
+                pri_queue.push(target, new_dist);
+            } else {
+                pri_queue.updatePriority(target, new_dist);
+            }
+            dists[target] = new_dist;
+        }
+    }
+    return sum_of_dists;
+}
+
+// 使用优先队列pri_queue从第0个顶点开始运行Dijkstra算法，通过插入时返回的句柄更新顶点的距离。
+template <typename TPriQueue>
+int64_t runDijkstraWithHandles(TPriQueue& pri_queue)
+{
+    constexpr int INF = std::numeric_limits<int>::max();
+    std::vector<int> dists(graph.numVertices(), INF);
+    std::vector<typename TPriQueue::Handle> handles(graph.numVertices());
+    dists[0] = 0;
+    handles[0] = pri_queue.push(0, 0);
+    int64_t sum_of_dists = 0;
+    while (!pri_queue.empty()) {
+        auto [vertex, dist] = pri_queue.popAndReturn();
+        sum_of_dists += dist;
+        for (size_t e = graph.edge_offsets_[vertex]; e < graph.edge_offsets_[vertex + 1]; e++) {
+            int target = graph.edge_targets_[e];
+            int new_dist = dist + graph.edge_weights_[e];
+            if (new_dist >= dists[target]) {
+                continue;
+            }
+            if (dists[target] == INF) {
+                handles[target] = pri_queue.push(target, new_dist);
+            } else {
+                pri_queue.updatePriority(handles[target], new_dist);
+            }
+            dists[target] = new_dist;
+        }
+    }
+    return sum_of_dists;
+}
+
+// 使用以哈希表记录元素位置的PriQueue运行Dijkstra算法。
+template <int d>
+void benchPriQueue(benchmark::State& state)
+{
+    for (auto _ : state) {
+        auto pri_queue = createEmptyMinPriQueue<int, int, d>();
+        benchmark::DoNotOptimize(runDijkstra(pri_queue));
+    }
+}
+
+// 使用PriQueue运行Dijkstra算法，通过句柄更新优先级。
+template <int d>
+void benchPriQueueWithHandles(benchmark::State& state)
+{
+    for (auto _ : state) {
+        auto pri_queue = createEmptyMinPriQueue<int, int, d>();
+        benchmark::DoNotOptimize(runDijkstraWithHandles(pri_queue));
+    }
+}
+
+// 使用采用延迟删除的LazyPriQueue运行Dijkstra算法，更新距离时插入新的节点而不移动旧的节点。
+template <int d>
+void benchLazyPriQueue(benchmark::State& state)
+{
+    for (auto _ : state) {
+        auto pri_queue = createEmptyMinLazyPriQueue<int, int, d>();
+        benchmark::DoNotOptimize(runDijkstra(pri_queue));
+    }
+}
+
+// 使用优先级单调的RadixPriQueue运行Dijkstra算法。
+void benchRadixPriQueue(benchmark::State& state)
+{
+    for (auto _ : state) {
+        auto pri_queue = createEmptyMinRadixPriQueue<int, int>();
+        benchmark::DoNotOptimize(runDijkstra(pri_queue));
+    }
+}
+
+// 使用以数组记录元素位置的IndexedPriQueue运行Dijkstra算法。
+template <int d>
+void benchIndexedPriQueue(benchmark::State& state)
+{
+    for (auto _ : state) {
+        auto pri_queue = createEmptyMinIndexedPriQueue<int, int, d>(graph.numVertices());
+        benchmark::DoNotOptimize(runDijkstra(pri_queue));
+    }
+}
+
+int main(int argc, char** argv)
+{
+    benchmark::SetDefaultTimeUnit(benchmark::TimeUnit::kMillisecond);
+    // ----------------------------------------------------------------------------
+    // PriQueue
+    BENCHMARK_TEMPLATE(benchPriQueue, 2);
+    BENCHMARK_TEMPLATE(benchPriQueue, 4);
+    BENCHMARK_TEMPLATE(benchPriQueue, 8);
+    BENCHMARK_TEMPLATE(benchPriQueueWithHandles, 2);
+    BENCHMARK_TEMPLATE(benchPriQueueWithHandles, 4);
+    BENCHMARK_TEMPLATE(benchPriQueueWithHandles, 8);
+    // ----------------------------------------------------------------------------
+    // LazyPriQueue
+    BENCHMARK_TEMPLATE(benchLazyPriQueue, 2);
+    BENCHMARK_TEMPLATE(benchLazyPriQueue, 4);
+    BENCHMARK_TEMPLATE(benchLazyPriQueue, 8);
+    // ----------------------------------------------------------------------------
+    // RadixPriQueue
+    BENCHMARK(benchRadixPriQueue);
+    // ----------------------------------------------------------------------------
+    // IndexedPriQueue
+    BENCHMARK_TEMPLATE(benchIndexedPriQueue, 2);
+    BENCHMARK_TEMPLATE(benchIndexedPriQueue, 4);
+    BENCHMARK_TEMPLATE(benchIndexedPriQueue, 8);
+    // ----------------------------------------------------------------------------
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv)) {
+        return 1;
+    }
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
@@ -0,0 +1,133 @@
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <cstring>
+#include <random>
+#include <vector>
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include "../src/d_ary_heap.hpp"
+#include "../src/heap_layout.hpp"
+
+using namespace custom_cont;
+
+// 堆中的节点数量。
+constexpr size_t NUM_KEYS = 100000000;
+
+// 统计当前线程在用户态发生的dTLB读缺失次数的计数器，内核不允许使用性能计数器时isValid()返回false。
+class DtlbMissCounter {
+    int fd_ { -1 };
+
+public:
+    DtlbMissCounter()
+    {
+#if defined(__linux__)
+        perf_event_attr attr;
+        std::memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        attr.type = PERF_TYPE_HW_CACHE;
+        attr.config = PERF_COUNT_HW_CACHE_DTLB | (PERF_COUNT_HW_CACHE_OP_READ << 8)
+            | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+        attr.disabled = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        fd_ = static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+#endif
+    }
+    ~DtlbMissCounter()
+    {
+#if defined(__linux__)
+        if (fd_ >= 0) {
+            close(fd_);
+        }
+#endif
+    }
+    bool isValid() const noexcept { return fd_ >= 0; }
+    void start()
+    {
+#if defined(__linux__)
+        if (fd_ >= 0) {
+            ioctl(fd_, PERF_EVENT_IOC_RESET, 0);
+            ioctl(fd_, PERF_EVENT_IOC_ENABLE, 0);
+        }
+#endif
+    }
+    // 停止计数并返回start()之后的缺失次数。
+    uint64_t stop()
+    {
+        uint64_t count = 0;
+#if defined(__linux__)
+        if (fd_ >= 0) {
+            ioctl(fd_, PERF_EVENT_IOC_DISABLE, 0);
+            if (read(fd_, &count, sizeof(count)) != sizeof(count)) {
+                count = 0;
+            }
+        }
+#endif
+        return count;
+    }
+};
+
+// 生成包含num_data个随机整数的数据集。
+std::vector<uint64_t> genKeysForTest(size_t num_data, uint64_t seed = 1995)
+{
+    std::mt19937_64 rand_gen(seed);
+    std::vector<uint64_t> dataset(num_data);
+    for (auto& data : dataset) {
+        data = rand_gen();
+    }
+    return dataset;
+}
+
+// 在包含NUM_KEYS个随机键的最小堆上反复取出堆顶并插入一个新的随机键（hold模型），堆的大小保持不变，
+// 每次取出都会沿着一条到叶节点的路径下沉。同时统计每次操作的dTLB读缺失次数。
+template <int d, typename Layout>
+void benchHold(benchmark::State& state)
+{
+    auto min_heap = DAryHeap<uint64_t, d, std::greater<uint64_t>, Layout>(d, std::greater<uint64_t>(),
+        std::vector<uint64_t>());
+    {
+        auto keys = genKeysForTest(NUM_KEYS);
+        min_heap.reserve(keys.size());
+        min_heap.pushRange(keys.begin(), keys.end());
+    }
+    std::mt19937_64 rand_gen(20240801);
+    DtlbMissCounter counter;
+    counter.start();
+    for (auto _ : state) {
+        uint64_t top_key = min_heap.popAndReturn();
+        benchmark::DoNotOptimize(top_key);
+        min_heap.push(top_key + (rand_gen() >> 8));
+    }
+    uint64_t num_misses = counter.stop();
+    state.SetItemsProcessed(state.iterations());
+    if (counter.isValid()) {
+        state.counters["dTLB_misses_per_op"] = benchmark::Counter(static_cast<double>(num_misses),
+            benchmark::Counter::kAvgIterations);
+    } else {
+        state.SetLabel("dTLB counter unavailable");
+    }
+}
+
+int main(int argc, char** argv)
+{
+    // ----------------------------------------------------------------------------
+    // d_ary_heap
+    BENCHMARK_TEMPLATE(benchHold, 4, ImplicitLayout)->Iterations(1 << 22);
+    BENCHMARK_TEMPLATE(benchHold, 4, HugePageLayout)->Iterations(1 << 22);
+    BENCHMARK_TEMPLATE(benchHold, 8, ImplicitLayout)->Iterations(1 << 22);
+    BENCHMARK_TEMPLATE(benchHold, 8, HugePageLayout)->Iterations(1 << 22);
+    // ----------------------------------------------------------------------------
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv)) {
+        return 1;
+    }
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
@@ -0,0 +1,98 @@
+#include <benchmark/benchmark.h>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "../src/d_ary_heap.hpp"
+#include "../src/inline_d_ary_heap.hpp"
+
+using namespace custom_cont;
+
+// 对象内最多可以存放的节点数量。
+constexpr size_t INLINE_CAPACITY = 64;
+
+// 生成包含num_data个随机整数的数据集。
+std::vector<int> genIntsForTest(size_t num_data, int seed = 1995)
+{
+    std::mt19937 rand_gen(seed);
+    std::uniform_int_distribution<int> rand_dist;
+    std::vector<int> dataset(num_data);
+    for (auto& data : dataset) {
+        data = rand_dist(rand_gen);
+    }
+    return dataset;
+}
+
+// 生成包含num_data个随机字符串的数据集。
+std::vector<std::string> genStringsForTest(size_t num_data)
+{
+    std::vector<std::string> dataset;
+    dataset.reserve(num_data);
+    for (int value : genIntsForTest(num_data)) {
+        dataset.push_back(std::to_string(value));
+    }
+    return dataset;
+}
+
+// 构造空的最小堆，use_inline为true时前INLINE_CAPACITY个节点存储于对象内的缓冲区中。
+template <typename T, int d, bool use_inline>
+auto createHeap()
+{
+    if constexpr (use_inline) {
+        return createEmptyMinInlineDHeap<T, INLINE_CAPACITY, d>();
+    } else {
+        return createEmptyMinDHeap<T, d>();
+    }
+}
+
+// 每个周期构造一个空的最小堆，插入state.range(0)个节点后全部取出，再析构堆，模拟每次请求使用一个很小的堆。
+template <typename T, int d, bool use_inline>
+void benchHeapCycle(benchmark::State& state, const std::vector<T>& dataset)
+{
+    auto num_nodes = static_cast<size_t>(state.range(0));
+    const std::vector<T> nodes(dataset.begin(), dataset.begin() + num_nodes);
+    for (auto _ : state) {
+        auto min_heap = createHeap<T, d, use_inline>();
+        for (const auto& node : nodes) {
+            min_heap.push(node);
+        }
+        while (!min_heap.empty()) {
+            benchmark::DoNotOptimize(min_heap.popAndReturn());
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * num_nodes);
+}
+
+template <int d, bool use_inline>
+void benchIntHeapCycle(benchmark::State& state)
+{
+    static const auto dataset = genIntsForTest(256);
+    benchHeapCycle<int, d, use_inline>(state, dataset);
+}
+
+template <int d, bool use_inline>
+void benchStringHeapCycle(benchmark::State& state)
+{
+    static const auto dataset = genStringsForTest(256);
+    benchHeapCycle<std::string, d, use_inline>(state, dataset);
+}
+
+int main(int argc, char** argv)
+{
+    // ----------------------------------------------------------------------------
+    // int
+    BENCHMARK_TEMPLATE(benchIntHeapCycle, 4, false)->RangeMultiplier(2)->Range(8, 256);
+    BENCHMARK_TEMPLATE(benchIntHeapCycle, 4, true)->RangeMultiplier(2)->Range(8, 256);
+    // ----------------------------------------------------------------------------
+    // std::string
+    BENCHMARK_TEMPLATE(benchStringHeapCycle, 4, false)->RangeMultiplier(2)->Range(8, 256);
+    BENCHMARK_TEMPLATE(benchStringHeapCycle, 4, true)->RangeMultiplier(2)->Range(8, 256);
+    // ----------------------------------------------------------------------------
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv)) {
+        return 1;
+    }
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
@@ -0,0 +1,137 @@
+#include <algorithm>
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "../src/concurrent_multi_queue.hpp"
+#include "../src/d_ary_heap.hpp"
+
+using namespace custom_cont;
+
+// 队列中初始节点的数量。
+constexpr size_t NUM_INITIAL_NODES = 1 << 16;
+// 每个线程预先生成的增量的数量。
+constexpr size_t NUM_INCREMENTS = 1 << 16;
+// 统计排名误差时取出的节点数量。
+constexpr size_t NUM_RANK_SAMPLES = 1 << 14;
+
+// 生成num_data个0到2^20之间的随机整数。
+std::vector<uint64_t> genIntsForTest(size_t num_data, int seed = 1995)
+{
+    std::mt19937 rand_gen(seed);
+    std::uniform_int_distribution<uint64_t> rand_dist(0, 1 << 20);
+    std::vector<uint64_t> dataset(num_data);
+    for (auto& data : dataset) {
+        data = rand_dist(rand_gen);
+    }
+    return dataset;
+}
+
+// 计算依次取出的节点popped的平均排名误差：前一半节点中的每一个被取出时，队列中比它更小的节点的数量。比它更小的
+// 节点只统计之后被取出的，由于取出的顺序接近有序，后一半节点足以覆盖它们。
+double meanRankError(const std::vector<uint64_t>& popped)
+{
+    std::vector<uint64_t> sorted_values(popped);
+    std::sort(sorted_values.begin(), sorted_values.end());
+    // 以树状数组记录已经遍历过的节点。
+    std::vector<size_t> tree(sorted_values.size() + 1, 0);
+    double sum_rank_errors = 0.0;
+    for (size_t i = popped.size(); i-- > 0;) {
+        size_t ord = std::lower_bound(sorted_values.begin(), sorted_values.end(), popped[i]) - sorted_values.begin();
+        if (i < popped.size() / 2) {
+            for (size_t pos = ord; pos > 0; pos -= pos & (~pos + 1)) {
+                sum_rank_errors += static_cast<double>(tree[pos]);
+            }
+        }
+        for (size_t pos = ord + 1; pos < tree.size(); pos += pos & (~pos + 1)) {
+            tree[pos] += 1;
+        }
+    }
+    return sum_rank_errors / static_cast<double>(popped.size() / 2);
+}
+
+// 多个线程同时反复从队列中取出一个节点，再插入一个比它大一个随机增量的节点，统计吞吐量和排名误差。
+template <int shards_per_thread>
+void benchMultiQueue(benchmark::State& state)
+{
+    static std::unique_ptr<ConcurrentMultiQueue<uint64_t>> multi_queue;
+    if (state.thread_index() == 0) {
+        multi_queue = std::make_unique<ConcurrentMultiQueue<uint64_t>>(state.threads(), shards_per_thread);
+        for (uint64_t node : genIntsForTest(NUM_INITIAL_NODES)) {
+            multi_queue->push(node);
+        }
+    }
+    const auto increments = genIntsForTest(NUM_INCREMENTS, state.thread_index() + 1);
+    size_t step_idx = 0;
+    for (auto _ : state) {
+        uint64_t node = 0;
+        multi_queue->tryPop(node);
+        multi_queue->push(node + increments[step_idx]);
+        step_idx = (step_idx + 1) % NUM_INCREMENTS;
+    }
+    state.SetItemsProcessed(state.iterations());
+    if (state.thread_index() == 0) {
+        std::vector<uint64_t> popped(NUM_RANK_SAMPLES);
+        for (auto& node : popped) {
+            multi_queue->tryPop(node);
+        }
+        state.counters["rank_error"] = meanRankError(popped);
+        multi_queue.reset();
+    }
+}
+
+// 用一个互斥锁保护的最小堆，作为对比。
+struct LockedHeap {
+    std::mutex mutex_;
+    DAryHeap<uint64_t, 4, std::greater<uint64_t>> heap_ { createEmptyMinDHeap<uint64_t, 4>() };
+};
+
+// 在LockedHeap上执行同样的操作。
+void benchLockedHeap(benchmark::State& state)
+{
+    static std::unique_ptr<LockedHeap> locked_heap;
+    if (state.thread_index() == 0) {
+        locked_heap = std::make_unique<LockedHeap>();
+        for (uint64_t node : genIntsForTest(NUM_INITIAL_NODES)) {
+            locked_heap->heap_.push(node);
+        }
+    }
+    const auto increments = genIntsForTest(NUM_INCREMENTS, state.thread_index() + 1);
+    size_t step_idx = 0;
+    for (auto _ : state) {
+        std::lock_guard<std::mutex> lock(locked_heap->mutex_);
+        uint64_t node = locked_heap->heap_.popAndReturn();
+        locked_heap->heap_.push(node + increments[step_idx]);
+        step_idx = (step_idx + 1) % NUM_INCREMENTS;
+    }
+    state.SetItemsProcessed(state.iterations());
+    if (state.thread_index() == 0) {
+        locked_heap.reset();
+    }
+}
+
+int main(int argc, char** argv)
+{
+    benchmark::SetDefaultTimeUnit(benchmark::TimeUnit::kNanosecond);
+    // 线程数从1开始倍增到硬件线程数（至少为8）。
+    int max_threads = std::max(static_cast<int>(std::thread::hardware_concurrency()), 8);
+    // ----------------------------------------------------------------------------
+    // concurrent_multi_queue
+    BENCHMARK_TEMPLATE(benchMultiQueue, 2)->ThreadRange(1, max_threads)->UseRealTime();
+    BENCHMARK_TEMPLATE(benchMultiQueue, 4)->ThreadRange(1, max_threads)->UseRealTime();
+    // ----------------------------------------------------------------------------
+    // d_ary_heap
+    BENCHMARK(benchLockedHeap)->ThreadRange(1, max_threads)->UseRealTime();
+    // ----------------------------------------------------------------------------
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv)) {
+        return 1;
+    }
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
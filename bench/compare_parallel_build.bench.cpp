@@ -0,0 +1,131 @@
+#include <benchmark/benchmark.h>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "../src/d_ary_heap.hpp"
+#include "../src/priority_queue.hpp"
+
+using namespace custom_cont;
+
+// 生成包含num_data个随机整数的数据集。
+std::vector<int> genIntsForTest(size_t num_data, int seed = 1995)
+{
+    std::mt19937 rand_gen(seed);
+    std::uniform_int_distribution<int> rand_dist;
+    std::vector<int> dataset(num_data);
+    for (auto& data : dataset) {
+        data = rand_dist(rand_gen);
+    }
+    return dataset;
+}
+
+// 使用state.range(1)个线程从state.range(0)个随机节点构造最小堆，计时包括复制节点。
+template <int d>
+void benchHeapBuild(benchmark::State& state)
+{
+    auto num_nodes = static_cast<size_t>(state.range(0));
+    auto num_threads = static_cast<size_t>(state.range(1));
+    const auto nodes = genIntsForTest(num_nodes);
+    for (auto _ : state) {
+        auto min_heap = buildMinDHeap<int, d>(nodes, num_threads);
+        benchmark::DoNotOptimize(min_heap);
+        // 在暂停计时期间析构堆。
+        state.PauseTiming();
+        min_heap = DAryHeap<int, d, std::greater<int>>();
+        state.ResumeTiming();
+    }
+    state.SetItemsProcessed(state.iterations() * num_nodes);
+}
+
+// 使用state.range(1)个线程从state.range(0)个元素和随机的优先级构造最小优先队列，计时包括建立索引。
+template <int d>
+void benchPriQueueBuild(benchmark::State& state)
+{
+    auto num_elements = static_cast<size_t>(state.range(0));
+    auto num_threads = static_cast<size_t>(state.range(1));
+    std::vector<int> elements(num_elements);
+    for (size_t i = 0; i < num_elements; i++) {
+        elements[i] = static_cast<int>(i);
+    }
+    const auto priorities = genIntsForTest(num_elements);
+    for (auto _ : state) {
+        auto min_pri_queue = buildMinPriQueue<int, int, d>(elements, priorities, num_threads);
+        benchmark::DoNotOptimize(min_pri_queue);
+        state.PauseTiming();
+        min_pri_queue = createEmptyMinPriQueue<int, int, d>();
+        state.ResumeTiming();
+    }
+    state.SetItemsProcessed(state.iterations() * num_elements);
+}
+
+// 从state.range(0)个字符串元素和随机的优先级构造最小优先队列，move_inputs为true时移动输入的数组，否则复制其中的
+// 元素和优先级。计时不包括准备输入数组。
+template <int d, bool move_inputs>
+void benchPriQueueBuildStrings(benchmark::State& state)
+{
+    auto num_elements = static_cast<size_t>(state.range(0));
+    std::vector<std::string> elements(num_elements);
+    for (size_t i = 0; i < num_elements; i++) {
+        elements[i] = "element_with_a_long_name_" + std::to_string(i);
+    }
+    const auto priorities = genIntsForTest(num_elements);
+    for (auto _ : state) {
+        state.PauseTiming();
+        auto elements_copy = elements;
+        auto priorities_copy = priorities;
+        state.ResumeTiming();
+        if constexpr (move_inputs) {
+            auto min_pri_queue
+                = buildMinPriQueue<std::string, int, d>(std::move(elements_copy), std::move(priorities_copy));
+            benchmark::DoNotOptimize(min_pri_queue);
+            state.PauseTiming();
+        } else {
+            auto min_pri_queue = buildMinPriQueue<std::string, int, d>(elements_copy, priorities_copy);
+            benchmark::DoNotOptimize(min_pri_queue);
+            state.PauseTiming();
+        }
+        // 在暂停计时期间析构队列和输入的数组。
+        elements_copy = std::vector<std::string>();
+        state.ResumeTiming();
+    }
+    state.SetItemsProcessed(state.iterations() * num_elements);
+}
+
+// 堆中有16M个节点，线程数量从1到8。
+void heapThreadCounts(benchmark::internal::Benchmark* bench)
+{
+    for (int num_threads : { 1, 2, 4, 8 }) {
+        bench->Args({ 1 << 24, num_threads });
+    }
+}
+
+// 队列中有4M个元素，线程数量从1到8。
+void priQueueThreadCounts(benchmark::internal::Benchmark* bench)
+{
+    for (int num_threads : { 1, 2, 4, 8 }) {
+        bench->Args({ 1 << 22, num_threads });
+    }
+}
+
+int main(int argc, char** argv)
+{
+    benchmark::SetDefaultTimeUnit(benchmark::TimeUnit::kMillisecond);
+    // ----------------------------------------------------------------------------
+    // d_ary_heap
+    BENCHMARK_TEMPLATE(benchHeapBuild, 4)->Apply(heapThreadCounts)->UseRealTime();
+    // ----------------------------------------------------------------------------
+    // priority_queue
+    BENCHMARK_TEMPLATE(benchPriQueueBuild, 4)->Apply(priQueueThreadCounts)->UseRealTime();
+    BENCHMARK_TEMPLATE(benchPriQueueBuildStrings, 4, false)->Arg(1 << 20);
+    BENCHMARK_TEMPLATE(benchPriQueueBuildStrings, 4, true)->Arg(1 << 20);
+    // ----------------------------------------------------------------------------
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv)) {
+        return 1;
+    }
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
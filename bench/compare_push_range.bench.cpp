@@ -0,0 +1,108 @@
+#include <benchmark/benchmark.h>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "../src/d_ary_heap.hpp"
+#include "../src/priority_queue.hpp"
+
+using namespace custom_cont;
+
+// 生成包含num_data个随机整数的数据集。
+std::vector<int> genIntsForTest(size_t num_data, int seed = 1995)
+{
+    std::mt19937 rand_gen(seed);
+    std::uniform_int_distribution<int> rand_dist;
+    std::vector<int> dataset(num_data);
+    for (auto& data : dataset) {
+        data = rand_dist(rand_gen);
+    }
+    return dataset;
+}
+
+// 向包含state.range(0)个节点的最小堆中插入state.range(1)个节点，逐个push或者使用pushRange。
+template <int d, bool use_push_range>
+void benchHeapInsertBatch(benchmark::State& state)
+{
+    auto num_old_nodes = static_cast<size_t>(state.range(0));
+    auto num_new_nodes = static_cast<size_t>(state.range(1));
+    const auto old_nodes = genIntsForTest(num_old_nodes);
+    const auto new_nodes = genIntsForTest(num_new_nodes, 2024);
+    auto min_heap = buildMinDHeap<int, d>(old_nodes);
+    for (auto _ : state) {
+        // 在暂停计时期间重新构建堆，旧的堆也在此时被析构。
+        state.PauseTiming();
+        min_heap = buildMinDHeap<int, d>(old_nodes);
+        state.ResumeTiming();
+        if constexpr (use_push_range) {
+            min_heap.pushRange(new_nodes.begin(), new_nodes.end());
+        } else {
+            for (const auto& node : new_nodes) {
+                min_heap.push(node);
+            }
+        }
+        benchmark::DoNotOptimize(min_heap);
+    }
+    state.SetItemsProcessed(state.iterations() * num_new_nodes);
+}
+
+// 向包含state.range(0)个元素的最小优先队列中插入state.range(1)个元素，逐个push或者使用pushRange。
+template <int d, bool use_push_range>
+void benchPriQueueInsertBatch(benchmark::State& state)
+{
+    auto num_old_elements = static_cast<size_t>(state.range(0));
+    auto num_new_elements = static_cast<size_t>(state.range(1));
+    std::vector<int> old_elements(num_old_elements), new_elements(num_new_elements);
+    for (size_t i = 0; i < num_old_elements; i++) {
+        old_elements[i] = static_cast<int>(i);
+    }
+    for (size_t i = 0; i < num_new_elements; i++) {
+        new_elements[i] = static_cast<int>(num_old_elements + i);
+    }
+    const auto old_priorities = genIntsForTest(num_old_elements);
+    const auto new_priorities = genIntsForTest(num_new_elements, 2024);
+    auto min_pri_queue = buildMinPriQueue<int, int, d>(old_elements, old_priorities);
+    for (auto _ : state) {
+        state.PauseTiming();
+        min_pri_queue = buildMinPriQueue<int, int, d>(old_elements, old_priorities);
+        state.ResumeTiming();
+        if constexpr (use_push_range) {
+            min_pri_queue.pushRange(new_elements.begin(), new_elements.end(), new_priorities.begin());
+        } else {
+            for (size_t i = 0; i < num_new_elements; i++) {
+                min_pri_queue.push(new_elements[i], new_priorities[i]);
+            }
+        }
+        benchmark::DoNotOptimize(min_pri_queue);
+    }
+    state.SetItemsProcessed(state.iterations() * num_new_elements);
+}
+
+// 堆中原有1M个节点，新节点的数量从堆大小的1/256到与堆大小相同。
+void batchSizes(benchmark::internal::Benchmark* bench)
+{
+    for (int shift : { 8, 6, 4, 2, 0 }) {
+        bench->Args({ 1 << 20, (1 << 20) >> shift });
+    }
+}
+
+int main(int argc, char** argv)
+{
+    benchmark::SetDefaultTimeUnit(benchmark::TimeUnit::kMillisecond);
+    // ----------------------------------------------------------------------------
+    // d_ary_heap
+    BENCHMARK_TEMPLATE(benchHeapInsertBatch, 4, false)->Apply(batchSizes);
+    BENCHMARK_TEMPLATE(benchHeapInsertBatch, 4, true)->Apply(batchSizes);
+    // ----------------------------------------------------------------------------
+    // priority_queue
+    BENCHMARK_TEMPLATE(benchPriQueueInsertBatch, 4, false)->Apply(batchSizes);
+    BENCHMARK_TEMPLATE(benchPriQueueInsertBatch, 4, true)->Apply(batchSizes);
+    // ----------------------------------------------------------------------------
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv)) {
+        return 1;
+    }
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
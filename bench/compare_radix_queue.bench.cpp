@@ -0,0 +1,107 @@
+#include <benchmark/benchmark.h>
+#include <random>
+#include <vector>
+
+#include "../src/d_ary_heap.hpp"
+#include "../src/priority_queue.hpp"
+#include "../src/radix_priority_queue.hpp"
+#include "../test/test_data_generator.h"
+
+using namespace custom_cont;
+
+// 生成num_nodes个g和h均为0到999之间的整数的节点。
+std::vector<MyNode> genNodesForTest(size_t num_nodes, int seed = 1995)
+{
+    std::mt19937 rand_gen(seed);
+    std::uniform_int_distribution<int> rand_dist(0, 999);
+    std::vector<MyNode> nodes;
+    for (size_t i = 0; i < num_nodes; i++) {
+        nodes.emplace_back(static_cast<int>(i), rand_dist(rand_gen), rand_dist(rand_gen));
+    }
+    return nodes;
+}
+
+// 生成num_steps个0到999之间的整数，作为每次取出节点后g的增量。
+std::vector<int> genStepsForTest(size_t num_steps, int seed = 2024)
+{
+    std::mt19937 rand_gen(seed);
+    std::uniform_int_distribution<int> rand_dist(0, 999);
+    std::vector<int> steps(num_steps);
+    for (auto& step : steps) {
+        step = rand_dist(rand_gen);
+    }
+    return steps;
+}
+
+constexpr size_t NUM_STEPS = 1 << 18;
+const auto steps = genStepsForTest(NUM_STEPS);
+
+// 在保持state.range(0)个节点的优先队列中，反复取出f最小的节点，将它的g增加一个随机量后重新插入，
+// 优先级单调不减。TPriQueue: 以节点为元素、以f为优先级的优先队列。
+template <typename TPriQueue>
+void holdPriQueue(benchmark::State& state, TPriQueue pri_queue)
+{
+    const auto nodes = genNodesForTest(static_cast<size_t>(state.range(0)));
+    for (const auto& node : nodes) {
+        pri_queue.push(node, node.f_);
+    }
+    size_t step_idx = 0;
+    for (auto _ : state) {
+        auto [node, pri] = pri_queue.popAndReturn();
+        MyNode next_node(node.node_id_, node.g_ + steps[step_idx], node.h_);
+        pri_queue.push(next_node, next_node.f_);
+        step_idx = (step_idx + 1) % NUM_STEPS;
+    }
+}
+
+// 在RadixPriQueue上执行holdPriQueue。
+void benchRadixPriQueue(benchmark::State& state)
+{
+    holdPriQueue(state, createEmptyMinRadixPriQueue<MyNode, int, MyNodeHasher>());
+}
+
+// 在每个父节点最多有d个子节点的PriQueue上执行holdPriQueue。
+template <int d>
+void benchPriQueue(benchmark::State& state)
+{
+    holdPriQueue(state, createEmptyMinPriQueue<MyNode, int, d, MyNodeHasher>());
+}
+
+// 在每个父节点最多有d个子节点的DAryHeap上执行同样的操作，节点按照f比较大小，堆中不记录节点的位置。
+template <int d>
+void benchHeap(benchmark::State& state)
+{
+    auto min_heap = buildMinDHeap<MyNode, d>(genNodesForTest(static_cast<size_t>(state.range(0))));
+    size_t step_idx = 0;
+    for (auto _ : state) {
+        MyNode node = min_heap.popAndReturn();
+        min_heap.push(MyNode(node.node_id_, node.g_ + steps[step_idx], node.h_));
+        step_idx = (step_idx + 1) % NUM_STEPS;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    benchmark::SetDefaultTimeUnit(benchmark::TimeUnit::kNanosecond);
+    // ----------------------------------------------------------------------------
+    // RadixPriQueue
+    BENCHMARK(benchRadixPriQueue)->Arg(1 << 10)->Arg(1 << 16)->Arg(1 << 20);
+    // ----------------------------------------------------------------------------
+    // PriQueue
+    BENCHMARK_TEMPLATE(benchPriQueue, 2)->Arg(1 << 10)->Arg(1 << 16)->Arg(1 << 20);
+    BENCHMARK_TEMPLATE(benchPriQueue, 4)->Arg(1 << 10)->Arg(1 << 16)->Arg(1 << 20);
+    BENCHMARK_TEMPLATE(benchPriQueue, 8)->Arg(1 << 10)->Arg(1 << 16)->Arg(1 << 20);
+    // ----------------------------------------------------------------------------
+    // d_ary_heap
+    BENCHMARK_TEMPLATE(benchHeap, 2)->Arg(1 << 10)->Arg(1 << 16)->Arg(1 << 20);
+    BENCHMARK_TEMPLATE(benchHeap, 4)->Arg(1 << 10)->Arg(1 << 16)->Arg(1 << 20);
+    BENCHMARK_TEMPLATE(benchHeap, 8)->Arg(1 << 10)->Arg(1 << 16)->Arg(1 << 20);
+    // ----------------------------------------------------------------------------
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv)) {
+        return 1;
+    }
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
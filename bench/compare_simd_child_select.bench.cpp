@@ -0,0 +1,89 @@
+#include <benchmark/benchmark.h>
+#include <random>
+#include <vector>
+
+#include "../src/d_ary_heap.hpp"
+
+using namespace custom_cont;
+
+// 与std::greater<int>功能相同，但无法被识别，因此堆只能逐个比较子节点。
+struct ScalarGreater {
+    bool operator()(const int& lhs, const int& rhs) const { return lhs > rhs; }
+};
+
+// 生成包含num_data个随机整数的数据集。
+std::vector<int> genIntsForTest(size_t num_data, int seed = 1995)
+{
+    std::mt19937 rand_gen(seed);
+    std::uniform_int_distribution<int> rand_dist;
+    std::vector<int> dataset(num_data);
+    for (auto& data : dataset) {
+        data = rand_dist(rand_gen);
+    }
+    return dataset;
+}
+
+const auto ints = genIntsForTest(1000000);
+
+// 对d在编译期确定、比较函数为Compare的最小堆执行count次push操作再执行count次pop操作。
+template <int d, typename Compare, size_t count>
+void benchPushThenPop(benchmark::State& state)
+{
+    for (auto _ : state) {
+        auto min_heap = DAryHeap<int, d, Compare>(d, Compare(), std::vector<int>());
+        for (size_t i = 0; i < count; i++) {
+            min_heap.push(ints[i]);
+        }
+        for (size_t i = 0; i < count; i++) {
+            min_heap.pop();
+        }
+        benchmark::DoNotOptimize(min_heap);
+    }
+}
+
+// 对d在编译期确定、比较函数为Compare的最小堆只执行count次pop操作。
+template <int d, typename Compare, size_t count>
+void benchPop(benchmark::State& state)
+{
+    const auto nodes = std::vector<int>(ints.begin(), ints.begin() + count);
+    for (auto _ : state) {
+        state.PauseTiming();
+        auto min_heap = DAryHeap<int, d, Compare>(d, Compare(), nodes);
+        state.ResumeTiming();
+        for (size_t i = 0; i < count; i++) {
+            min_heap.pop();
+        }
+        benchmark::DoNotOptimize(min_heap);
+    }
+}
+
+int main(int argc, char** argv)
+{
+    benchmark::SetDefaultTimeUnit(benchmark::TimeUnit::kMillisecond);
+    // ----------------------------------------------------------------------------
+    // push then pop
+    BENCHMARK_TEMPLATE(benchPushThenPop, 2, std::greater<int>, 100000);
+    BENCHMARK_TEMPLATE(benchPushThenPop, 4, ScalarGreater, 100000);
+    BENCHMARK_TEMPLATE(benchPushThenPop, 4, std::greater<int>, 100000);
+    BENCHMARK_TEMPLATE(benchPushThenPop, 8, ScalarGreater, 100000);
+    BENCHMARK_TEMPLATE(benchPushThenPop, 8, std::greater<int>, 100000);
+    BENCHMARK_TEMPLATE(benchPushThenPop, 16, ScalarGreater, 100000);
+    BENCHMARK_TEMPLATE(benchPushThenPop, 16, std::greater<int>, 100000);
+    // ----------------------------------------------------------------------------
+    // pop only
+    BENCHMARK_TEMPLATE(benchPop, 2, std::greater<int>, 1000000);
+    BENCHMARK_TEMPLATE(benchPop, 4, ScalarGreater, 1000000);
+    BENCHMARK_TEMPLATE(benchPop, 4, std::greater<int>, 1000000);
+    BENCHMARK_TEMPLATE(benchPop, 8, ScalarGreater, 1000000);
+    BENCHMARK_TEMPLATE(benchPop, 8, std::greater<int>, 1000000);
+    BENCHMARK_TEMPLATE(benchPop, 16, ScalarGreater, 1000000);
+    BENCHMARK_TEMPLATE(benchPop, 16, std::greater<int>, 1000000);
+    // ----------------------------------------------------------------------------
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv)) {
+        return 1;
+    }
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
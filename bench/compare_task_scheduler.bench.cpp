@@ -0,0 +1,185 @@
+#include <atomic>
+#include <benchmark/benchmark.h>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "../src/d_ary_heap.hpp"
+#include "../src/work_stealing_scheduler.hpp"
+
+using namespace custom_cont;
+
+// 每轮提交的任务数量。
+constexpr int NUM_TASKS = 1 << 14;
+// 任务优先级的取值范围为[0, NUM_PRIORITIES)。
+constexpr int NUM_PRIORITIES = 100;
+
+// 所有工作线程共用一个由互斥锁保护的堆的调度器，作为对比。
+class GlobalLockScheduler {
+    struct Task {
+        int pri_;
+        std::function<void()> func_;
+    };
+    struct TaskCmp {
+        bool operator()(const Task& lhs, const Task& rhs) const { return lhs.pri_ < rhs.pri_; }
+    };
+
+    std::mutex mutex_;
+    std::condition_variable task_cv_, idle_cv_;
+    DAryHeap<Task, 4, TaskCmp> heap_ { 4, TaskCmp(), std::vector<Task>() };
+    size_t num_unfinished_ { 0 };
+    bool stopping_ { false };
+    std::vector<std::thread> threads_;
+
+public:
+    explicit GlobalLockScheduler(size_t num_workers)
+    {
+        for (size_t i = 0; i < num_workers; i++) {
+            threads_.emplace_back([this]() { this->runWorker(); });
+        }
+    }
+    ~GlobalLockScheduler()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stopping_ = true;
+        }
+        task_cv_.notify_all();
+        for (auto& thread : threads_) {
+            thread.join();
+        }
+    }
+    template <typename Func>
+    void submitTo(size_t, int pri, Func&& func)
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            heap_.push(Task { pri, std::forward<Func>(func) });
+            num_unfinished_ += 1;
+        }
+        task_cv_.notify_one();
+    }
+    void waitIdle()
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        idle_cv_.wait(lock, [this]() { return num_unfinished_ == 0; });
+    }
+
+private:
+    void runWorker()
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        while (true) {
+            task_cv_.wait(lock, [this]() { return stopping_ || !heap_.empty(); });
+            if (heap_.empty()) {
+                return;
+            }
+            Task task = heap_.popAndReturn();
+            lock.unlock();
+            task.func_();
+            lock.lock();
+            num_unfinished_ -= 1;
+            if (num_unfinished_ == 0) {
+                idle_cv_.notify_all();
+            }
+        }
+    }
+};
+
+// 执行一小段计算，模拟任务的工作量。
+void doWork(int pri)
+{
+    uint64_t x = static_cast<uint64_t>(pri) + 1;
+    for (int i = 0; i < 200; i++) {
+        x = x * 6364136223846793005ULL + 1442695040888963407ULL;
+    }
+    benchmark::DoNotOptimize(x);
+}
+
+// 根据每个任务提交和开始执行的时刻计算发生优先级倒置的任务所占的比例：一个任务开始执行时，如果有优先级更高的任务
+// 已经提交但尚未开始执行，则认为它发生了优先级倒置。
+double inversionRatio(const std::vector<int>& priorities, const std::vector<uint64_t>& submit_ticks,
+    const std::vector<uint64_t>& start_ticks)
+{
+    // 按照时刻排列的事件，非负数表示提交第i个任务，负数表示第~i个任务开始执行。
+    std::vector<int> events(2 * priorities.size());
+    for (size_t i = 0; i < priorities.size(); i++) {
+        events[submit_ticks[i]] = static_cast<int>(i);
+        events[start_ticks[i]] = ~static_cast<int>(i);
+    }
+    std::vector<int> num_waiting(NUM_PRIORITIES, 0);
+    size_t num_inversions = 0;
+    for (int event : events) {
+        if (event >= 0) {
+            num_waiting[priorities[event]] += 1;
+            continue;
+        }
+        int pri = priorities[~event];
+        num_waiting[pri] -= 1;
+        for (int higher_pri = pri + 1; higher_pri < NUM_PRIORITIES; higher_pri++) {
+            if (num_waiting[higher_pri] > 0) {
+                num_inversions += 1;
+                break;
+            }
+        }
+    }
+    return static_cast<double>(num_inversions) / static_cast<double>(priorities.size());
+}
+
+// 每轮由外部线程提交NUM_TASKS个随机优先级的任务并等待它们执行完毕，统计吞吐量和优先级倒置的比例。
+// state.range(0)为工作线程的数量，skewed为true时所有任务都提交给第0个工作线程，否则轮流提交给各个工作线程。
+template <typename TScheduler, bool skewed>
+void benchScheduler(benchmark::State& state)
+{
+    auto num_workers = static_cast<size_t>(state.range(0));
+    TScheduler scheduler(num_workers);
+    std::mt19937 rand_gen(1995);
+    std::uniform_int_distribution<int> rand_dist(0, NUM_PRIORITIES - 1);
+    std::vector<int> priorities(NUM_TASKS);
+    for (auto& pri : priorities) {
+        pri = rand_dist(rand_gen);
+    }
+    std::vector<uint64_t> submit_ticks(NUM_TASKS), start_ticks(NUM_TASKS);
+    double sum_inversion_ratios = 0.0;
+    for (auto _ : state) {
+        std::atomic<uint64_t> clock { 0 };
+        for (int i = 0; i < NUM_TASKS; i++) {
+            int pri = priorities[i];
+            submit_ticks[i] = clock.fetch_add(1);
+            scheduler.submitTo(skewed ? 0 : i % num_workers, pri, [&clock, &start_ticks, pri, i]() {
+                start_ticks[i] = clock.fetch_add(1);
+                doWork(pri);
+            });
+        }
+        scheduler.waitIdle();
+        state.PauseTiming();
+        sum_inversion_ratios += inversionRatio(priorities, submit_ticks, start_ticks);
+        state.ResumeTiming();
+    }
+    state.SetItemsProcessed(state.iterations() * NUM_TASKS);
+    state.counters["inversion_ratio"] = sum_inversion_ratios / static_cast<double>(state.iterations());
+}
+
+int main(int argc, char** argv)
+{
+    benchmark::SetDefaultTimeUnit(benchmark::TimeUnit::kMillisecond);
+    // ----------------------------------------------------------------------------
+    // work_stealing_scheduler
+    BENCHMARK_TEMPLATE(benchScheduler, WorkStealingScheduler<int>, false)->RangeMultiplier(2)->Range(1, 8)->UseRealTime();
+    BENCHMARK_TEMPLATE(benchScheduler, WorkStealingScheduler<int>, true)->RangeMultiplier(2)->Range(1, 8)->UseRealTime();
+    // ----------------------------------------------------------------------------
+    // d_ary_heap
+    BENCHMARK_TEMPLATE(benchScheduler, GlobalLockScheduler, false)->RangeMultiplier(2)->Range(1, 8)->UseRealTime();
+    // ----------------------------------------------------------------------------
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv)) {
+        return 1;
+    }
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
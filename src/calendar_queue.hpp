@@ -0,0 +1,303 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <iterator>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace custom_cont {
+// 返回节点对应的时间，默认将节点直接转换为double。
+template <typename T>
+struct TimeOfNode {
+    double operator()(const T& node) const { return static_cast<double>(node); }
+};
+
+// 日历队列(calendar queue)，按照时间从小到大取出节点，接口与最小堆DAryHeap相同，适合作为离散事件仿真中的
+// 事件表。时间轴被划分为宽度相同的“天”，第v天（时间除以宽度向下取整为v）的节点存放在第v%N个桶中，桶中的节点
+// 按时间从大到小排列。取出节点时从当前所在的一天开始依次查看每个桶的末尾，在hold模型（取出最早的事件后插入
+// 一个稍晚的事件）中平均只需查看常数个桶。节点数量超出桶数量的两倍或不足一半时将桶的数量加倍或减半，并根据
+// 最早的若干个节点的平均间隔重新确定桶的宽度。节点的数量不变但时间的分布发生变化时，原来的宽度可能过小（取出时需要
+// 查看大量空桶）或过大（桶中的节点过多），因此在操作的平均开销过高时也会重新确定宽度。时间相同的节点按照插入的
+// 顺序取出。天的编号相对于重新分配节点时最早的节点的时间计算，超出范围时取范围的边界，时间相差极大的节点可能
+// 落在同一天中，此时依然按照时间顺序取出，只是插入时需要比较更多的节点。节点的时间不得为NaN。
+// T: 队列中的节点, TimeOf: 用于求解节点对应时间的函数。
+template <typename T, typename TimeOf = TimeOfNode<T>>
+class CalendarQueue {
+protected:
+    // 桶的最小数量。
+    static constexpr size_t MIN_NUM_BUCKETS = 2;
+    // 估计桶的宽度时采样的节点数量。
+    static constexpr size_t NUM_SAMPLES = 25;
+    // 检查桶的宽度是否合适之前至少需要取出的节点数量。
+    static constexpr size_t MIN_NUM_CHECKED_POPS = 64;
+    // 每次取出节点平均查看的桶与插入节点时平均比较的节点之和超过该值时，认为桶的宽度已不再合适。
+    static constexpr size_t MAX_AVG_COST = 8;
+    // 天的编号的绝对值上限，小于2^62，使当前所在的一天查看一整圈的桶时不会溢出。
+    static constexpr double MAX_ABS_DAY = 4.0e18;
+
+    // 用于求解节点对应时间的函数。
+    TimeOf time_of_;
+    // 队列中节点的个数。
+    size_t size_ { 0 };
+    // 每个桶对应的时间跨度。
+    double width_ { 1.0 };
+    // 计算天的编号时使用的时间原点，第0天从该时间开始。
+    double origin_ { 0.0 };
+    // 所有的桶，数量始终为2的幂。
+    std::vector<std::vector<T>> buckets_;
+    // 当前所在的一天，队列中所有节点所在的天都不早于它。查看队首时会向后移动，因此声明为mutable。
+    mutable int64_t cur_day_ { 0 };
+    // 上一次确定桶的宽度之后取出的节点数量。
+    size_t num_pops_ { 0 };
+    // 上一次确定桶的宽度之后取出节点时查看的桶与插入节点时比较的节点的总数。
+    mutable size_t cost_ { 0 };
+
+public:
+    // 使用队列中的节点nodes来构造日历队列。
+    template <typename Nodes>
+    CalendarQueue(TimeOf time_of, Nodes&& nodes)
+        : time_of_(std::move(time_of))
+        , size_(nodes.size())
+    {
+        size_t num_buckets = MIN_NUM_BUCKETS;
+        while (num_buckets < size_) {
+            num_buckets *= 2;
+        }
+        if constexpr (std::is_same_v<std::decay_t<Nodes>, std::vector<T>> && std::is_rvalue_reference_v<Nodes&&>) {
+            this->rebuild(num_buckets, std::move(nodes));
+        } else if constexpr (std::is_rvalue_reference_v<Nodes&&>) {
+            this->rebuild(num_buckets,
+                std::vector<T>(std::make_move_iterator(std::begin(nodes)), std::make_move_iterator(std::end(nodes))));
+        } else {
+            this->rebuild(num_buckets, std::vector<T>(std::begin(nodes), std::end(nodes)));
+        }
+    }
+    CalendarQueue()
+        : buckets_(MIN_NUM_BUCKETS)
+    {
+    }
+    virtual ~CalendarQueue() = default;
+    CalendarQueue(const CalendarQueue&) = default;
+    CalendarQueue(CalendarQueue&&) = default;
+    CalendarQueue& operator=(const CalendarQueue&) = default;
+    CalendarQueue& operator=(CalendarQueue&&) = default;
+
+    // 返回队列中存储的节点的数量。
+    size_t size() const noexcept { return size_; }
+    // 判断队列是否为空。
+    bool empty() const noexcept { return size_ == 0; }
+    // 返回桶的数量。
+    size_t numBuckets() const noexcept { return buckets_.size(); }
+    // 返回每个桶对应的时间跨度。
+    double bucketWidth() const noexcept { return width_; }
+    // 将一个节点node插入队列中，时间复杂度：均摊O(1)。
+    template <typename TNode>
+    void push(TNode&& node)
+    {
+        // 队列为空时可以直接移动时间原点，不需要重新分配节点。
+        if (size_ == 0 && std::isfinite(time_of_(node))) {
+            origin_ = time_of_(node);
+        }
+        int64_t day = this->dayOf(node);
+        if (size_ == 0 || day < cur_day_) {
+            cur_day_ = day;
+        }
+        this->insertNode(day, std::forward<TNode>(node));
+        size_ += 1;
+        if (size_ > 2 * buckets_.size()) {
+            this->resize(2 * buckets_.size());
+        }
+    }
+    // 使用参数args构造一个节点并插入队列中，时间复杂度：均摊O(1)。
+    template <typename... Args>
+    void emplace(Args&&... args)
+    {
+        this->push(T(std::forward<Args>(args)...));
+    }
+    // 返回时间最早的节点，时间复杂度：均摊O(1)。
+    const T& top() const
+    {
+        if (size_ == 0) {
+            throw std::out_of_range("The calendar queue is empty!!!");
+        }
+        return buckets_[this->locateTop()].back();
+    }
+    // 移除时间最早的节点，时间复杂度：均摊O(1)。
+    void pop()
+    {
+        if (size_ == 0) {
+            throw std::out_of_range("The calendar queue is empty!!!");
+        }
+        buckets_[this->locateTop()].pop_back();
+        this->afterPop();
+    }
+    // 移除时间最早的节点并返回。
+    T popAndReturn()
+    {
+        if (size_ == 0) {
+            throw std::out_of_range("The calendar queue is empty!!!");
+        }
+        auto& bucket = buckets_[this->locateTop()];
+        T top_node = std::move(bucket.back());
+        bucket.pop_back();
+        this->afterPop();
+        return top_node;
+    }
+
+protected:
+    // 返回节点node所在的天，超出范围时返回范围的边界，节点的时间为NaN时抛出异常。
+    int64_t dayOf(const T& node) const
+    {
+        double time = time_of_(node);
+        if (std::isnan(time)) {
+            throw std::invalid_argument("Time of the node must not be NaN!!!");
+        }
+        double day = std::floor((time - origin_) / width_);
+        return static_cast<int64_t>(std::clamp(day, -MAX_ABS_DAY, MAX_ABS_DAY));
+    }
+    // 返回第day天的节点所在的桶的编号。
+    size_t bucketOf(int64_t day) const noexcept
+    {
+        return static_cast<size_t>(static_cast<uint64_t>(day) & (buckets_.size() - 1));
+    }
+    // 将第day天的节点node插入对应的桶中，放在时间相同的节点之前，使它们按照插入的顺序取出。
+    template <typename TNode>
+    void insertNode(int64_t day, TNode&& node)
+    {
+        auto& bucket = buckets_[this->bucketOf(day)];
+        double time = time_of_(node);
+        auto pos = std::lower_bound(bucket.begin(), bucket.end(), time,
+            [this](const T& lhs, double rhs) { return time_of_(lhs) > rhs; });
+        cost_ += bucket.size();
+        bucket.insert(pos, std::forward<TNode>(node));
+    }
+    // 返回时间最早的节点所在的桶的编号。从当前所在的一天开始查看一整圈的桶，若都没有当天的节点则直接在所有桶的
+    // 末尾中寻找时间最早的节点。
+    size_t locateTop() const
+    {
+        for (size_t i = 0; i < buckets_.size(); i++, cur_day_++) {
+            size_t bucket_idx = this->bucketOf(cur_day_);
+            const auto& bucket = buckets_[bucket_idx];
+            if (!bucket.empty() && this->dayOf(bucket.back()) <= cur_day_) {
+                cost_ += i;
+                return bucket_idx;
+            }
+        }
+        cost_ += 2 * buckets_.size();
+        size_t top_bucket_idx = buckets_.size();
+        for (size_t bucket_idx = 0; bucket_idx < buckets_.size(); bucket_idx++) {
+            const auto& bucket = buckets_[bucket_idx];
+            if (!bucket.empty()
+                && (top_bucket_idx == buckets_.size()
+                    || time_of_(bucket.back()) < time_of_(buckets_[top_bucket_idx].back()))) {
+                top_bucket_idx = bucket_idx;
+            }
+        }
+        cur_day_ = this->dayOf(buckets_[top_bucket_idx].back());
+        return top_bucket_idx;
+    }
+    // 移除节点后更新节点数量，节点过少时减少桶的数量，最近的操作开销过高时重新确定桶的宽度。
+    void afterPop()
+    {
+        size_ -= 1;
+        num_pops_ += 1;
+        if (buckets_.size() > MIN_NUM_BUCKETS && size_ < buckets_.size() / 2) {
+            this->resize(buckets_.size() / 2);
+        } else if (num_pops_ >= std::max(buckets_.size(), MIN_NUM_CHECKED_POPS)) {
+            if (cost_ > MAX_AVG_COST * num_pops_) {
+                this->resize(buckets_.size());
+            }
+            num_pops_ = 0;
+            cost_ = 0;
+        }
+    }
+    // 将桶的数量调整为num_buckets，并重新分配所有的节点。
+    void resize(size_t num_buckets)
+    {
+        std::vector<T> nodes;
+        nodes.reserve(size_);
+        // 从每个桶的末尾开始取出节点，保证时间相同的节点重新插入后依然按照原来的顺序取出。
+        for (auto& bucket : buckets_) {
+            std::move(bucket.rbegin(), bucket.rend(), std::back_inserter(nodes));
+        }
+        this->rebuild(num_buckets, std::move(nodes));
+    }
+    // 使用num_buckets个桶存放节点nodes，并根据最早的若干个节点的平均间隔重新确定桶的宽度。
+    void rebuild(size_t num_buckets, std::vector<T> nodes)
+    {
+        num_pops_ = 0;
+        // 以最早的有限时间作为时间原点，使天的编号不会因为时间本身过大而超出范围。
+        bool has_finite_time = false;
+        for (const auto& node : nodes) {
+            double time = time_of_(node);
+            if (std::isnan(time)) {
+                throw std::invalid_argument("Time of the node must not be NaN!!!");
+            }
+            if (std::isfinite(time) && (!has_finite_time || time < origin_)) {
+                origin_ = time;
+                has_finite_time = true;
+            }
+        }
+        this->estimateWidth(nodes);
+        buckets_.assign(num_buckets, std::vector<T>());
+        bool first_node = true;
+        for (auto& node : nodes) {
+            int64_t day = this->dayOf(node);
+            if (first_node || day < cur_day_) {
+                cur_day_ = day;
+                first_node = false;
+            }
+            this->insertNode(day, std::move(node));
+        }
+        cost_ = 0;
+    }
+    // 以最早的若干个节点的平均间隔的三倍作为桶的宽度，计算平均间隔时忽略大于两倍初始平均值的间隔，
+    // 间隔都为0或宽度不是有限值时保持原来的宽度。
+    void estimateWidth(const std::vector<T>& nodes)
+    {
+        size_t num_samples = std::min(nodes.size(), NUM_SAMPLES);
+        if (num_samples < 2) {
+            return;
+        }
+        std::vector<double> times;
+        times.reserve(nodes.size());
+        for (const auto& node : nodes) {
+            times.push_back(time_of_(node));
+        }
+        std::nth_element(times.begin(), times.begin() + (num_samples - 1), times.end());
+        std::sort(times.begin(), times.begin() + num_samples);
+        double avg_gap = (times[num_samples - 1] - times[0]) / static_cast<double>(num_samples - 1);
+        double sum_gaps = 0.0;
+        size_t num_gaps = 0;
+        for (size_t i = 1; i < num_samples; i++) {
+            double gap = times[i] - times[i - 1];
+            if (gap <= 2.0 * avg_gap) {
+                sum_gaps += gap;
+                num_gaps += 1;
+            }
+        }
+        double width = 3.0 * sum_gaps / static_cast<double>(num_gaps);
+        if (sum_gaps > 0.0 && std::isfinite(width)) {
+            width_ = width;
+        }
+    }
+};
+
+// 构建空的日历队列。
+template <typename T, typename TimeOf = TimeOfNode<T>>
+auto createEmptyCalendarQueue(TimeOf time_of = TimeOf())
+{
+    return CalendarQueue<T, TimeOf>(std::move(time_of), std::vector<T>());
+}
+
+// 使用队列中的节点nodes来构造日历队列。
+template <typename T, typename TimeOf = TimeOfNode<T>, typename Nodes>
+auto buildCalendarQueue(Nodes&& nodes, TimeOf time_of = TimeOf())
+{
+    return CalendarQueue<T, TimeOf>(std::move(time_of), std::forward<Nodes>(nodes));
+}
+}
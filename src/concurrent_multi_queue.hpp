@@ -0,0 +1,176 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include "d_ary_heap.hpp"
+
+namespace custom_cont {
+// 可被多个线程同时访问的松弛优先队列(MultiQueue)，由c*P个各自带锁的DAryHeap分片组成，P为线程数。插入时将节点
+// 放入随机的一个分片，取出时比较两个随机分片缓存的堆顶，从较优的分片中取出堆顶。每次操作只锁一个分片，锁被占用时
+// 换一个分片重试而不是等待，因此吞吐量随线程数近似线性增长，代价是取出的节点不一定是全局最优的：取出的节点的
+// 期望排名误差为O(c*P)。堆顶以原子变量的形式缓存，因此T必须是可平凡复制且可默认构造的类型，并且最好足够小，
+// 使得std::atomic<T>是无锁的。
+// T: 队列中的节点, D: 每个分片中的父节点最多可以有多少个子节点, Compare: 用于比较两节点大小的函数。
+template <typename T, int D = 4, typename Compare = std::greater<T>>
+class ConcurrentMultiQueue {
+    static_assert(std::is_trivially_copyable_v<T> && std::is_default_constructible_v<T>,
+        "Nodes of ConcurrentMultiQueue must be trivially copyable and default constructible!!!");
+
+protected:
+    // 每个分片中的堆。
+    using Heap = DAryHeap<T, D, Compare>;
+    // 带锁的分片，按照缓存行对齐以避免不同分片之间的伪共享。
+    struct alignas(64) Shard {
+        // 保护堆的锁。
+        std::mutex mutex_;
+        // 分片中的堆。
+        Heap heap_;
+        // 分片中节点的数量，可以在不加锁的情况下读取。
+        std::atomic<size_t> size_ { 0 };
+        // 缓存的堆顶节点，只在size_大于0时有意义。
+        std::atomic<T> top_ { T() };
+    };
+
+    // 用于比较两节点的函数。
+    Compare cmp_func_;
+    // 分片的数量。
+    size_t num_shards_ { 0 };
+    // 所有的分片。
+    std::unique_ptr<Shard[]> shards_;
+    // 连续多少次未能锁定分片后让出CPU，避免线程数超过核心数时空转耗尽持有锁的线程的时间片。
+    static constexpr size_t NUM_RETRIES_BEFORE_YIELD = 16;
+
+public:
+    // 构造供num_threads个线程使用的队列，每个线程对应shards_per_thread个分片。
+    ConcurrentMultiQueue(size_t num_threads, size_t shards_per_thread = 2, Compare cmp_func = Compare())
+        : cmp_func_(cmp_func)
+        , num_shards_(num_threads * shards_per_thread)
+    {
+        if (num_shards_ == 0) {
+            throw std::invalid_argument("Number of shards must be larger than 0!!!");
+        }
+        shards_ = std::make_unique<Shard[]>(num_shards_);
+        for (size_t i = 0; i < num_shards_; i++) {
+            shards_[i].heap_ = Heap(D, cmp_func, std::vector<T>());
+        }
+    }
+    virtual ~ConcurrentMultiQueue() = default;
+
+    // 返回分片的数量。
+    size_t numShards() const noexcept { return num_shards_; }
+    // 返回队列中存储的节点的数量，有其他线程同时修改队列时只是一个近似值。
+    size_t size() const noexcept
+    {
+        size_t size = 0;
+        for (size_t i = 0; i < num_shards_; i++) {
+            size += shards_[i].size_.load(std::memory_order_relaxed);
+        }
+        return size;
+    }
+    // 判断队列是否为空，有其他线程同时修改队列时只是一个近似值。
+    bool empty() const noexcept { return this->size() == 0; }
+    // 将一个节点node插入随机的一个分片中，线程安全。
+    void push(const T& node)
+    {
+        for (size_t num_retries = 0;; this->backoff(num_retries)) {
+            Shard& shard = shards_[this->randomShardIdx()];
+            std::unique_lock<std::mutex> lock(shard.mutex_, std::try_to_lock);
+            if (!lock.owns_lock()) {
+                continue;
+            }
+            shard.heap_.push(node);
+            this->updateCache(shard);
+            return;
+        }
+    }
+    // 从两个随机分片中较优的一个取出堆顶节点写入node并返回true，队列为空时返回false，线程安全。
+    bool tryPop(T& node)
+    {
+        for (size_t num_retries = 0;; this->backoff(num_retries)) {
+            Shard* shard = this->chooseShard();
+            if (shard == nullptr) {
+                return false;
+            }
+            std::unique_lock<std::mutex> lock(shard->mutex_, std::try_to_lock);
+            if (!lock.owns_lock() || shard->heap_.empty()) {
+                continue;
+            }
+            node = shard->heap_.popAndReturn();
+            this->updateCache(*shard);
+            return true;
+        }
+    }
+
+protected:
+    // 返回当前线程生成的一个随机的分片编号，每个线程使用各自的xorshift随机数生成器。
+    size_t randomShardIdx() const noexcept
+    {
+        thread_local uint64_t state = std::hash<std::thread::id>()(std::this_thread::get_id()) | 1;
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        return static_cast<size_t>(state % num_shards_);
+    }
+    // 记录一次失败的尝试，连续失败NUM_RETRIES_BEFORE_YIELD次后让出CPU。
+    static void backoff(size_t& num_retries) noexcept
+    {
+        num_retries += 1;
+        if (num_retries % NUM_RETRIES_BEFORE_YIELD == 0) {
+            std::this_thread::yield();
+        }
+    }
+    // 在持有分片的锁时更新它缓存的堆顶和节点数量。
+    void updateCache(Shard& shard) noexcept
+    {
+        if (!shard.heap_.empty()) {
+            shard.top_.store(shard.heap_.top(), std::memory_order_relaxed);
+        }
+        shard.size_.store(shard.heap_.size(), std::memory_order_release);
+    }
+    // 比较两个随机分片缓存的堆顶，返回较优的非空分片。两个分片都为空时依次查找其他非空的分片，所有分片都为空时
+    // 返回nullptr。
+    Shard* chooseShard()
+    {
+        Shard* shard_i = &shards_[this->randomShardIdx()];
+        Shard* shard_j = &shards_[this->randomShardIdx()];
+        bool has_top_i = shard_i->size_.load(std::memory_order_acquire) > 0;
+        bool has_top_j = shard_j->size_.load(std::memory_order_acquire) > 0;
+        if (has_top_i && has_top_j) {
+            T top_i = shard_i->top_.load(std::memory_order_relaxed);
+            T top_j = shard_j->top_.load(std::memory_order_relaxed);
+            return cmp_func_(top_i, top_j) ? shard_j : shard_i;
+        }
+        if (has_top_i || has_top_j) {
+            return has_top_i ? shard_i : shard_j;
+        }
+        for (size_t i = 0; i < num_shards_; i++) {
+            if (shards_[i].size_.load(std::memory_order_acquire) > 0) {
+                return &shards_[i];
+            }
+        }
+        return nullptr;
+    }
+};
+
+// 构建供num_threads个线程使用的空的最小松弛优先队列，每个线程对应shards_per_thread个分片。
+template <typename T, int D = 4>
+auto createEmptyMinMultiQueue(size_t num_threads, size_t shards_per_thread = 2)
+{
+    return ConcurrentMultiQueue<T, D, std::greater<T>>(num_threads, shards_per_thread);
+}
+
+// 构建供num_threads个线程使用的空的最大松弛优先队列，每个线程对应shards_per_thread个分片。
+template <typename T, int D = 4>
+auto createEmptyMaxMultiQueue(size_t num_threads, size_t shards_per_thread = 2)
+{
+    return ConcurrentMultiQueue<T, D, std::less<T>>(num_threads, shards_per_thread);
+}
+}
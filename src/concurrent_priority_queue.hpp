@@ -0,0 +1,303 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "priority_queue.hpp"
+
+namespace custom_cont {
+// 以平面合并(flat combining)的方式使PriQueue可被多个线程同时访问，保持严格的优先级顺序。每个线程将要执行的操作
+// 发布到一个槽位中，再尝试获取锁，获得锁的线程（合并者）依次执行所有槽位中等待的操作，其他线程只需等待自己的操作
+// 被执行。队列只被合并者访问，不会在多个核之间来回传递，同一批中的插入使用pushRange、出队使用popN批量执行。
+// 同一批中的操作同时处于等待状态，因此按照先插入、再更新和移除、最后出队的顺序执行依然是可线性化的。
+// 操作抛出的异常会被转交给发起操作的线程重新抛出。
+// TPriQueue: 被包装的优先队列，如PriQueue。
+template <typename TPriQueue>
+class ConcurrentPriQueue {
+protected:
+    // 节点，包含有元素的基本信息和优先级。
+    using Node = decltype(std::declval<TPriQueue&>().popAndReturn());
+    // 队列中的元素。
+    using T = std::decay_t<typename Node::first_type>;
+    // 元素的优先级。
+    using TPri = std::decay_t<typename Node::second_type>;
+
+    // 发布到槽位中的操作。
+    enum class OpType {
+        PUSH,
+        PUSH_OR_UPDATE,
+        UPDATE_PRIORITY,
+        ERASE,
+        POP
+    };
+    // 槽位的状态。
+    enum SlotState : int {
+        // 空闲，可以被任意线程占用。
+        FREE,
+        // 已被一个线程占用，正在写入操作。
+        CLAIMED,
+        // 操作已写入，等待合并者执行。
+        PENDING,
+        // 操作已被执行，等待发起操作的线程读取结果。
+        DONE
+    };
+    // 操作的参数和执行结果。
+    struct Payload {
+        // 操作的元素，出队时用于返回取出的元素。
+        std::optional<T> element_;
+        // 操作的优先级，出队时用于返回取出的元素的优先级。
+        std::optional<TPri> pri_;
+        // 插入或更新时表示元素是否为新插入的，出队时表示是否取出了元素。
+        bool succeeded_ { false };
+        // 执行操作时抛出的异常。
+        std::exception_ptr error_;
+    };
+    // 一个槽位，按照缓存行对齐以避免不同槽位之间的伪共享。
+    struct alignas(64) Slot {
+        // 槽位的状态。
+        std::atomic<int> state_ { FREE };
+        // 操作的种类。
+        OpType op_ { OpType::POP };
+        // 操作的参数和执行结果。
+        Payload payload_;
+    };
+
+    // 保护被包装的队列的锁，持有它的线程即为合并者。
+    std::mutex mutex_;
+    // 被包装的队列，只能由合并者访问。
+    TPriQueue pri_queue_;
+    // 队列中元素的数量，由合并者在每一批操作之后更新。
+    std::atomic<size_t> size_ { 0 };
+    // 槽位的数量。
+    size_t num_slots_ { 0 };
+    // 所有的槽位。
+    std::unique_ptr<Slot[]> slots_;
+    // 合并者使用的临时数组，在多批操作之间复用。
+    std::vector<Slot*> push_slots_, other_slots_, pop_slots_;
+    std::vector<T> batch_elements_;
+    std::vector<TPri> batch_priorities_;
+    std::vector<Node> popped_nodes_;
+
+public:
+    // 包装优先队列pri_queue，num_slots为槽位的数量，同时访问的线程数量超过它时多余的线程需要等待空闲的槽位。
+    explicit ConcurrentPriQueue(TPriQueue pri_queue, size_t num_slots = 2 * std::thread::hardware_concurrency())
+        : pri_queue_(std::move(pri_queue))
+        , size_(pri_queue_.size())
+        , num_slots_(std::max<size_t>(num_slots, 1))
+        , slots_(std::make_unique<Slot[]>(num_slots_))
+    {
+        // 一批最多包含num_slots_个操作，提前分配好临时数组，合并时收集槽位不会因为扩容而失败。
+        push_slots_.reserve(num_slots_);
+        other_slots_.reserve(num_slots_);
+        pop_slots_.reserve(num_slots_);
+        batch_elements_.reserve(num_slots_);
+        batch_priorities_.reserve(num_slots_);
+        popped_nodes_.reserve(num_slots_);
+    }
+    virtual ~ConcurrentPriQueue() = default;
+
+    // 返回队列中存储的元素的数量，有其他线程同时修改队列时只是一个近似值。
+    size_t size() const noexcept { return size_.load(std::memory_order_relaxed); }
+    // 判断队列是否为空，有其他线程同时修改队列时只是一个近似值。
+    bool empty() const noexcept { return this->size() == 0; }
+    // 将一个元素element和它的优先级pri插入队列中，元素已在队列中时抛出异常，线程安全。
+    void push(T element, TPri pri)
+    {
+        this->execute(OpType::PUSH, std::move(element), std::move(pri));
+    }
+    // 元素element在队列中时将它的优先级更新为pri，否则将它插入队列中，返回它是否为新插入的元素，线程安全。
+    bool pushOrUpdate(T element, TPri pri)
+    {
+        return this->execute(OpType::PUSH_OR_UPDATE, std::move(element), std::move(pri)).succeeded_;
+    }
+    // 将元素element对应的优先级更新为pri，元素不在队列中时抛出异常，线程安全。
+    void updatePriority(T element, TPri pri)
+    {
+        this->execute(OpType::UPDATE_PRIORITY, std::move(element), std::move(pri));
+    }
+    // 从队列中移除元素element，元素不在队列中时抛出异常，线程安全。
+    void erase(T element)
+    {
+        this->execute(OpType::ERASE, std::move(element), std::nullopt);
+    }
+    // 移除队列中的第一个元素并将它和它的优先级写入node，返回true，队列为空时返回false，线程安全。
+    bool tryPop(Node& node)
+    {
+        Payload result = this->execute(OpType::POP, std::nullopt, std::nullopt);
+        if (result.succeeded_) {
+            node = Node(std::move(*result.element_), std::move(*result.pri_));
+        }
+        return result.succeeded_;
+    }
+
+protected:
+    // 发布一个操作并等待它被执行，返回执行结果，操作抛出异常时在当前线程重新抛出。
+    Payload execute(OpType op, std::optional<T> element, std::optional<TPri> pri)
+    {
+        Slot& slot = this->claimSlot();
+        slot.op_ = op;
+        slot.payload_ = Payload { std::move(element), std::move(pri), false, nullptr };
+        slot.state_.store(PENDING, std::memory_order_release);
+        while (slot.state_.load(std::memory_order_acquire) != DONE) {
+            std::unique_lock<std::mutex> lock(mutex_, std::try_to_lock);
+            if (lock.owns_lock()) {
+                this->combine();
+            } else {
+                std::this_thread::yield();
+            }
+        }
+        Payload result = std::move(slot.payload_);
+        slot.payload_ = Payload();
+        slot.state_.store(FREE, std::memory_order_release);
+        if (result.error_) {
+            std::rethrow_exception(result.error_);
+        }
+        return result;
+    }
+    // 从当前线程对应的位置开始依次尝试占用一个空闲的槽位。
+    Slot& claimSlot()
+    {
+        size_t slot_idx = std::hash<std::thread::id>()(std::this_thread::get_id()) % num_slots_;
+        while (true) {
+            int expected_state = FREE;
+            if (slots_[slot_idx].state_.compare_exchange_weak(
+                    expected_state, CLAIMED, std::memory_order_acquire, std::memory_order_relaxed)) {
+                return slots_[slot_idx];
+            }
+            slot_idx = slot_idx + 1 == num_slots_ ? 0 : slot_idx + 1;
+            if (slot_idx == 0) {
+                std::this_thread::yield();
+            }
+        }
+    }
+    // 在持有锁时执行所有槽位中等待的操作。每类操作执行完后立即标记为已完成，执行过程中抛出的异常（如移动元素或
+    // 优先级时抛出的异常）会被交给本批中所有尚未完成的操作，它们同样被标记为已完成，等待的线程不会一直阻塞。
+    void combine() noexcept
+    {
+        push_slots_.clear();
+        other_slots_.clear();
+        pop_slots_.clear();
+        try {
+            for (size_t i = 0; i < num_slots_; i++) {
+                Slot& slot = slots_[i];
+                if (slot.state_.load(std::memory_order_acquire) != PENDING) {
+                    continue;
+                }
+                if (slot.op_ == OpType::PUSH) {
+                    push_slots_.push_back(&slot);
+                } else if (slot.op_ == OpType::POP) {
+                    pop_slots_.push_back(&slot);
+                } else {
+                    other_slots_.push_back(&slot);
+                }
+            }
+            this->combinePushes();
+            this->finishSlots(push_slots_);
+            for (Slot* slot : other_slots_) {
+                Payload& payload = slot->payload_;
+                try {
+                    if (slot->op_ == OpType::PUSH_OR_UPDATE) {
+                        payload.succeeded_
+                            = pri_queue_.pushOrUpdate(*payload.element_, std::move(*payload.pri_)).second;
+                    } else if (slot->op_ == OpType::UPDATE_PRIORITY) {
+                        pri_queue_.updatePriority(*payload.element_, std::move(*payload.pri_));
+                    } else {
+                        pri_queue_.erase(*payload.element_);
+                    }
+                } catch (...) {
+                    payload.error_ = std::current_exception();
+                }
+            }
+            this->finishSlots(other_slots_);
+            this->combinePops();
+            this->finishSlots(pop_slots_);
+        } catch (...) {
+            std::exception_ptr error = std::current_exception();
+            for (auto* slots : { &push_slots_, &other_slots_, &pop_slots_ }) {
+                for (Slot* slot : *slots) {
+                    slot->payload_.error_ = error;
+                }
+                this->finishSlots(*slots);
+            }
+        }
+    }
+    // 更新队列长度，然后将slots中的操作标记为已完成并清空slots。标记之后发起操作的线程可能立即释放并重新占用
+    // 槽位，因此不能再访问这些槽位。
+    void finishSlots(std::vector<Slot*>& slots) noexcept
+    {
+        size_.store(pri_queue_.size(), std::memory_order_relaxed);
+        for (Slot* slot : slots) {
+            slot->state_.store(DONE, std::memory_order_release);
+        }
+        slots.clear();
+    }
+    // 使用pushRange批量执行所有插入操作。pushRange遇到已在队列中的元素时会保留之前插入的元素并抛出异常，
+    // 根据队列长度的变化找到出错的操作，再从它的下一个操作继续批量插入。
+    void combinePushes()
+    {
+        if (push_slots_.empty()) {
+            return;
+        }
+        batch_elements_.clear();
+        batch_priorities_.clear();
+        for (Slot* slot : push_slots_) {
+            batch_elements_.push_back(std::move(*slot->payload_.element_));
+            batch_priorities_.push_back(std::move(*slot->payload_.pri_));
+        }
+        size_t first_op = 0;
+        while (first_op < push_slots_.size()) {
+            size_t old_size = pri_queue_.size();
+            try {
+                pri_queue_.pushRange(std::make_move_iterator(batch_elements_.begin() + first_op),
+                    std::make_move_iterator(batch_elements_.end()), batch_priorities_.begin() + first_op);
+                first_op = push_slots_.size();
+            } catch (...) {
+                size_t failed_op = first_op + (pri_queue_.size() - old_size);
+                push_slots_[failed_op]->payload_.error_ = std::current_exception();
+                first_op = failed_op + 1;
+            }
+        }
+    }
+    // 使用popN批量执行所有出队操作，队列中的元素不足时多余的操作不会取出元素。
+    void combinePops()
+    {
+        if (pop_slots_.empty()) {
+            return;
+        }
+        popped_nodes_.clear();
+        pri_queue_.popN(pop_slots_.size(), std::back_inserter(popped_nodes_));
+        for (size_t i = 0; i < popped_nodes_.size(); i++) {
+            pop_slots_[i]->payload_.element_ = std::move(popped_nodes_[i].first);
+            pop_slots_[i]->payload_.pri_ = std::move(popped_nodes_[i].second);
+            pop_slots_[i]->payload_.succeeded_ = true;
+        }
+    }
+};
+
+// 构建可被多个线程同时访问的空的最小优先队列，每个父节点最多可以有D个子节点，num_slots为槽位的数量。
+template <typename T, typename TPri, int D = 4, typename THash = std::hash<T>>
+auto createEmptyMinConcurrentPriQueue(size_t num_slots = 2 * std::thread::hardware_concurrency())
+{
+    return ConcurrentPriQueue<PriQueue<T, TPri, THash, D, std::greater<>>>(
+        createEmptyMinPriQueue<T, TPri, D, THash>(), num_slots);
+}
+
+// 构建可被多个线程同时访问的空的最大优先队列，每个父节点最多可以有D个子节点，num_slots为槽位的数量。
+template <typename T, typename TPri, int D = 4, typename THash = std::hash<T>>
+auto createEmptyMaxConcurrentPriQueue(size_t num_slots = 2 * std::thread::hardware_concurrency())
+{
+    return ConcurrentPriQueue<PriQueue<T, TPri, THash, D, std::less<>>>(
+        createEmptyMaxPriQueue<T, TPri, D, THash>(), num_slots);
+}
+}
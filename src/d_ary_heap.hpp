@@ -1,53 +1,141 @@
 #pragma once
 
+#include <algorithm>
 #include <functional>
+#include <iterator>
+#include <memory>
+#include <memory_resource>
 #include <stdexcept>
+#include <type_traits>
 #include <vector>
 
+#include "heap_layout.hpp"
+#include "parallel_build.hpp"
+#include "simd_child_select.hpp"
+
 namespace custom_cont {
-// D叉堆(D-ary heap)数据结构。
-template <typename T>
+// 表示每个父节点最多可以有多少个子节点在运行时才确定。
+constexpr int DYNAMIC_ARITY = 0;
+
+// 在包含num_old_nodes个节点的堆的末尾批量添加num_new_nodes个节点后，判断重新建堆是否比逐个上浮更快。
+// 重新建堆需要下沉所有新节点和它们的祖先，逐个上浮的开销与新节点的数量和堆的高度成正比。
+inline bool shouldRebuildAfterAppend(size_t num_old_nodes, size_t num_new_nodes, size_t d) noexcept
+{
+    size_t height = 1;
+    for (size_t num_nodes = num_old_nodes + num_new_nodes; num_nodes >= d; num_nodes /= d) {
+        height += 1;
+    }
+    return num_new_nodes * height >= num_old_nodes;
+}
+
+// 移除堆顶节点后修复堆的策略。
+enum class PopStrategy {
+    // 将最后一个节点移至堆顶后逐层下沉，每层需要将它与所有子节点比较。
+    TOP_DOWN,
+    // 先只比较子节点将堆顶的空位下移到叶节点，再将最后一个节点从该处上浮。由于最后一个节点通常只需上浮很少
+    // 的几层，每层可以少比较一次，d = 2时比较次数约减半。
+    BOTTOM_UP
+};
+
+// D叉堆(D-ary heap)数据结构。T: 堆中的节点, D: 每个父节点最多可以有多少个子节点，为DYNAMIC_ARITY时由构造函数
+// 输入的d确定, Compare: 用于比较两节点大小的函数，使用无状态的函数对象时可被编译器内联,
+// Layout: 节点在数组中的布局，见heap_layout.hpp, Allocator: 存储节点时使用的分配器，为std::allocator时使用布局
+// 默认的分配器，可以使用std::pmr::polymorphic_allocator将节点存储于内存池或单调缓冲区中。
+template <typename T, int D = DYNAMIC_ARITY, typename Compare = std::function<bool(const T&, const T&)>,
+    typename Layout = ImplicitLayout, typename Allocator = std::allocator<T>>
 class DAryHeap {
+    static_assert(D == DYNAMIC_ARITY || D >= 2, "D must be lareger or equal to 2!!!");
+    static_assert(Layout::LEVEL_ORDER || D != DYNAMIC_ARITY, "Layouts not in level order require a compile-time D!!!");
+
 protected:
     // 节点在堆中的位置。
     using NodePos = size_t;
     // 用于比较两节点大小的函数。
-    using CmpFunc = std::function<bool(T, T)>;
+    using CmpFunc = Compare;
+    // 存储节点的数组。
+    using Storage = std::vector<T, typename LayoutWithAllocator<Layout, Allocator>::template Allocator<T>>;
 
     // 每个父节点最多可以有多少个子节点（不得小于2）。
-    int d_;
+    int d_ { D == DYNAMIC_ARITY ? 2 : D };
     // 用于比较两节点的函数。
     CmpFunc cmp_func_;
     // 堆中节点的个数。
-    size_t size_;
-    // 存储于堆中的节点。
-    std::vector<T> nodes_;
+    size_t size_ { 0 };
+    // 存储于堆中的节点，开头可能有布局预留的空位，节点之间也可能有布局留下的空位。
+    Storage nodes_;
+    // 移除堆顶节点时所使用的修复策略。
+    PopStrategy pop_strategy_ { PopStrategy::TOP_DOWN };
 
 public:
-    // 使用堆中的节点nodes来构造堆。
+    // 使用堆中的节点nodes来构造堆，num_threads大于1时使用多个线程并行建堆，比较函数必须可以被同时调用。
     template <typename Nodes>
-    DAryHeap(int d, CmpFunc&& cmp_func, Nodes&& nodes)
+    DAryHeap(int d, CmpFunc cmp_func, Nodes&& nodes, size_t num_threads = 1)
+        : DAryHeap(d, std::move(cmp_func), std::forward<Nodes>(nodes), Allocator(), num_threads)
+    {
+    }
+    // 使用堆中的节点nodes来构造堆，之后堆中的节点都使用分配器alloc存储。
+    template <typename Nodes>
+    DAryHeap(int d, CmpFunc cmp_func, Nodes&& nodes, const Allocator& alloc, size_t num_threads = 1)
         : d_(d)
         , cmp_func_(std::move(cmp_func))
         , size_(nodes.size())
-        , nodes_(std::forward<Nodes>(nodes))
+        , nodes_(this->assembleNodes(std::forward<Nodes>(nodes), alloc))
     {
-        this->buildHeap();
+        if constexpr (Layout::PADDED) {
+            this->spreadNodes();
+        }
+        this->buildHeap(num_threads);
     }
-    DAryHeap() = default;
+    DAryHeap()
+        : nodes_(this->assembleNodes(Storage(), Allocator()))
+    {
+    }
+    // 虚析构函数会抑制隐式的移动操作，因此显式地声明复制和移动操作，移动堆时不会复制其中的节点。
     virtual ~DAryHeap() = default;
+    DAryHeap(const DAryHeap&) = default;
+    DAryHeap(DAryHeap&&) = default;
+    DAryHeap& operator=(const DAryHeap&) = default;
+    DAryHeap& operator=(DAryHeap&&) = default;
 
     // 返回堆中存储的节点的数量。
     size_t size() const noexcept { return size_; }
     // 判断堆是否为空。
     bool empty() const noexcept { return size_ == 0; }
+    // 预留可以容纳num_nodes个节点的空间，使之后的插入不会触发扩容。
+    void reserve(size_t num_nodes) { nodes_.reserve(this->reservedSlots() + this->endPosOf(num_nodes)); }
     // 将一个节点node插入堆中，时间复杂度：O(d*log_d(N))。
     template <typename TNode>
     void push(TNode&& node)
     {
-        size_ += 1;
-        nodes_.push_back(std::forward<TNode>(node));
-        this->heapifyUp(size_ - 1);
+        this->appendNode(std::forward<TNode>(node));
+        this->heapifyUp(this->endPos() - 1);
+    }
+    // 使用参数args在堆中原地构造一个节点，时间复杂度：O(d*log_d(N))。
+    template <typename... Args>
+    void emplace(Args&&... args)
+    {
+        this->appendNode(std::forward<Args>(args)...);
+        this->heapifyUp(this->endPos() - 1);
+    }
+    // 将[first, last)中的节点批量插入堆中，新节点较多时只对新节点和它们的祖先自底向上重新建堆，
+    // 否则逐个上浮，时间复杂度：O(min(k*log_d(N), k+log_d(N)^2))，k为新节点的数量。
+    template <typename InputIt>
+    void pushRange(InputIt first, InputIt last)
+    {
+        using IterCategory = typename std::iterator_traits<InputIt>::iterator_category;
+        if constexpr (std::is_base_of_v<std::forward_iterator_tag, IterCategory>) {
+            this->reserve(size_ + std::distance(first, last));
+        }
+        size_t num_old_nodes = size_;
+        if constexpr (Layout::PADDED) {
+            for (; first != last; ++first) {
+                this->appendNode(*first);
+            }
+        } else {
+            nodes_.insert(nodes_.end(), first, last);
+            size_ = nodes_.size() - this->reservedSlots();
+        }
+        this->fixAppendedNodes(num_old_nodes);
     }
     // 返回堆顶的节点。
     const T& top() const
@@ -55,7 +143,7 @@ public:
         if (size_ == 0) {
             throw std::out_of_range("The D-ary heap is empty!!!");
         }
-        return nodes_.front();
+        return this->nodeAt(0);
     }
     // 移除堆顶的节点。
     void pop()
@@ -63,12 +151,7 @@ public:
         if (size_ == 0) {
             throw std::out_of_range("The D-ary heap is empty!!!");
         }
-        nodes_.at(0) = nodes_.back();
-        nodes_.pop_back();
-        size_ -= 1;
-        if (size_ > 0) {
-            this->heapifyDown(0);
-        }
+        this->removeTopNode();
     }
     // 移除堆顶的节点并返回。
     T popAndReturn()
@@ -76,77 +159,411 @@ public:
         if (size_ == 0) {
             throw std::out_of_range("The D-ary heap is empty!!!");
         }
-        T node_to_return = std::move(nodes_.at(0));
-        nodes_.at(0) = nodes_.back();
-        nodes_.pop_back();
-        size_ -= 1;
-        if (size_ > 0) {
-            this->heapifyDown(0);
-        }
+        T node_to_return = std::move(this->nodeAt(0));
+        this->removeTopNode();
         return node_to_return;
     }
+    // 移除堆中所有满足条件pred的节点并重新建堆，返回被移除的节点的数量，时间复杂度：O(N)。
+    template <typename Pred>
+    size_t eraseIf(Pred pred)
+    {
+        if constexpr (Layout::PADDED) {
+            this->compactNodes();
+        }
+        auto new_end = std::remove_if(nodes_.begin() + this->reservedSlots(), nodes_.end(), pred);
+        size_t num_erased = static_cast<size_t>(nodes_.end() - new_end);
+        nodes_.erase(new_end, nodes_.end());
+        size_ -= num_erased;
+        if constexpr (Layout::PADDED) {
+            this->spreadNodes();
+        }
+        if (num_erased > 0) {
+            this->buildHeap();
+        }
+        return num_erased;
+    }
+    // 按照出堆的顺序将最应该靠近堆顶的k个节点（不足k个时为所有节点）写入out并返回写入结束后的位置，不修改堆。
+    // 用一个辅助的小堆记录候选节点，每取出一个候选节点就将它的子节点加入候选，时间复杂度：O(k*d*log(k*d))。
+    template <typename OutputIt>
+    OutputIt topK(size_t k, OutputIt out) const
+    {
+        k = std::min(k, size_);
+        if (k == 0) {
+            return out;
+        }
+        // 候选节点在堆中的位置，以std::push_heap的形式组织，最应该靠近堆顶的候选节点位于开头。
+        std::vector<NodePos> candidates { 0 };
+        candidates.reserve(std::min(k * this->arity(), size_));
+        auto cmp_candidates = [this](NodePos pos_i, NodePos pos_j) {
+            return cmp_func_(this->nodeAt(pos_i), this->nodeAt(pos_j));
+        };
+        for (size_t i = 0; i < k; i++) {
+            std::pop_heap(candidates.begin(), candidates.end(), cmp_candidates);
+            NodePos node_pos = candidates.back();
+            candidates.pop_back();
+            *out = this->nodeAt(node_pos);
+            ++out;
+            if (i + 1 == k || this->isLeafNode(node_pos)) {
+                continue;
+            }
+            NodePos first_child_pos = this->getChildNodePos(node_pos, 0);
+            NodePos last_child_pos = std::min(first_child_pos + this->arity(), this->endPos());
+            for (NodePos child_node_pos = first_child_pos; child_node_pos < last_child_pos; ++child_node_pos) {
+                candidates.push_back(child_node_pos);
+                std::push_heap(candidates.begin(), candidates.end(), cmp_candidates);
+            }
+        }
+        return out;
+    }
+    // 依次移除堆顶的k个节点（不足k个时移除所有节点），按照出堆的顺序写入out并返回写入结束后的位置。
+    // 出堆的节点接近全部时先选出这些节点并排序，再对剩余节点重新建堆，否则逐个出堆。逐个出堆时下沉的路径
+    // 通常已在缓存中，实测只有k接近N时排序才更快，时间复杂度：O(min(k*d*log_d(N), N+k*log(k)))。
+    template <typename OutputIt>
+    OutputIt popN(size_t k, OutputIt out)
+    {
+        k = std::min(k, size_);
+        if (k * 4 < size_ * 3) {
+            for (size_t i = 0; i < k; i++) {
+                *out = std::move(this->nodeAt(0));
+                ++out;
+                this->removeTopNode();
+            }
+            return out;
+        }
+        auto closer_to_top = [this](const T& node_i, const T& node_j) { return cmp_func_(node_j, node_i); };
+        if constexpr (Layout::PADDED) {
+            this->compactNodes();
+        }
+        auto first = nodes_.begin() + this->reservedSlots(), kth = first + k;
+        if (k < size_) {
+            std::nth_element(first, kth, nodes_.end(), closer_to_top);
+        }
+        std::sort(first, kth, closer_to_top);
+        out = std::move(first, kth, out);
+        nodes_.erase(first, kth);
+        size_ -= k;
+        if constexpr (Layout::PADDED) {
+            this->spreadNodes();
+        }
+        this->buildHeap();
+        return out;
+    }
+    // 移除堆中所有的节点，按照出堆的顺序写入out并返回写入结束后的位置，时间复杂度：O(N*log(N))。
+    template <typename OutputIt>
+    OutputIt drainSorted(OutputIt out)
+    {
+        return this->popN(size_, out);
+    }
+    // 返回移除堆顶节点时所使用的修复策略。
+    PopStrategy popStrategy() const noexcept { return pop_strategy_; }
+    // 设置移除堆顶节点时所使用的修复策略。
+    void setPopStrategy(PopStrategy pop_strategy) noexcept { pop_strategy_ = pop_strategy; }
 
 protected:
-    // 构建堆，时间复杂度O(n)。
-    void buildHeap()
+    // 检查每个父节点最多可以有多少个子节点是否合法。
+    void checkArity() const
     {
         if (d_ < 2) {
             throw std::invalid_argument("D must be lareger or equal to 2!!!");
         }
-        for (NodePos pos_to_fix = size_ / d_ + 1; pos_to_fix > 0; --pos_to_fix) {
-            this->heapifyDown(pos_to_fix - 1);
+        if (D != DYNAMIC_ARITY && d_ != D) {
+            throw std::invalid_argument("d must be equal to the compile-time arity D!!!");
+        }
+    }
+    // 将输入的节点按照布局转存为使用分配器alloc的节点数组，布局需要预留空位时在数组开头插入默认构造的节点。
+    // 输入为使用相同分配器的右值节点数组且不需要预留空位时直接接管它。
+    template <typename Nodes>
+    Storage assembleNodes(Nodes&& nodes, const Allocator& alloc) const
+    {
+        this->checkArity();
+        auto node_alloc = nodeAllocator<T, Layout>(alloc);
+        if constexpr (std::is_same_v<std::decay_t<Nodes>, Storage> && std::is_rvalue_reference_v<Nodes&&>
+            && !Layout::RESERVES_SLOTS) {
+            if (nodes.get_allocator() == node_alloc) {
+                return std::move(nodes);
+            }
+        }
+        Storage storage(node_alloc);
+        storage.reserve(this->reservedSlots() + nodes.size());
+        if constexpr (Layout::RESERVES_SLOTS) {
+            storage.resize(this->reservedSlots());
         }
+        if constexpr (std::is_rvalue_reference_v<Nodes&&>) {
+            storage.insert(storage.end(), std::make_move_iterator(nodes.begin()),
+                std::make_move_iterator(nodes.end()));
+        } else {
+            storage.insert(storage.end(), nodes.begin(), nodes.end());
+        }
+        return storage;
+    }
+    // 使用num_threads个线程构建堆，时间复杂度O(n)。布局不按照层序排列时有子节点的节点不是连续的一段，
+    // 此时在当前线程中从后往前下沉每个节点。
+    void buildHeap(size_t num_threads = 1)
+    {
+        if constexpr (Layout::LEVEL_ORDER) {
+            floydBuildHeap(
+                size_, this->arity(), num_threads, [this](NodePos pos_to_fix) { this->heapifyDown(pos_to_fix); });
+        } else {
+            for (size_t node_idx = size_; node_idx > 0; --node_idx) {
+                this->heapifyDown(this->nodePos(node_idx - 1));
+            }
+        }
+    }
+    // 修复在包含num_old_nodes个节点的堆的末尾批量添加的节点。
+    void fixAppendedNodes(size_t num_old_nodes) noexcept
+    {
+        if (num_old_nodes >= size_) {
+            return;
+        }
+        if (!shouldRebuildAfterAppend(num_old_nodes, size_ - num_old_nodes, this->arity())) {
+            for (size_t node_idx = num_old_nodes; node_idx < size_; ++node_idx) {
+                this->heapifyUp(this->nodePos(node_idx));
+            }
+            return;
+        }
+        if constexpr (!Layout::LEVEL_ORDER) {
+            this->buildHeap();
+            return;
+        }
+        // 新节点和它们的祖先在每一层都是连续的一段，自底向上逐层下沉这些节点，每个节点只处理一次。
+        NodePos lo_pos = num_old_nodes, hi_pos = size_ - 1, next_pos = size_;
+        while (true) {
+            for (NodePos pos_to_fix = std::min(hi_pos + 1, next_pos); pos_to_fix > lo_pos; --pos_to_fix) {
+                this->heapifyDown(pos_to_fix - 1);
+            }
+            if (lo_pos == 0) {
+                break;
+            }
+            next_pos = lo_pos;
+            lo_pos = this->getParentNodePos(lo_pos);
+            hi_pos = this->getParentNodePos(hi_pos);
+        }
+    }
+    // 返回每个父节点最多可以有多少个子节点，D在编译期确定时返回常量，使乘除法可以被优化为移位。
+    size_t arity() const noexcept
+    {
+        if constexpr (D == DYNAMIC_ARITY) {
+            return d_;
+        } else {
+            return D;
+        }
+    }
+    // 返回节点数组开头预留的空位数量。
+    size_t reservedSlots() const noexcept
+    {
+        return Layout::reservedSlots(this->arity());
+    }
+    // 返回按照插入顺序排列的第node_idx个节点的位置，布局没有空位时与node_idx相同。
+    NodePos nodePos(size_t node_idx) const noexcept
+    {
+        if constexpr (Layout::PADDED) {
+            return Layout::template nodePos<sizeof(T), D>(node_idx);
+        } else {
+            return node_idx;
+        }
+    }
+    // 返回包含num_nodes个节点的堆中最后一个节点之后的位置。
+    NodePos endPosOf(size_t num_nodes) const noexcept
+    {
+        return num_nodes == 0 ? 0 : this->nodePos(num_nodes - 1) + 1;
+    }
+    // 返回堆中最后一个节点之后的位置，子节点的位置不小于它时表示子节点不存在。
+    NodePos endPos() const noexcept
+    {
+        if constexpr (Layout::PADDED) {
+            return nodes_.size() - this->reservedSlots();
+        } else {
+            return size_;
+        }
+    }
+    // 在堆的末尾使用参数args构造一个节点，不修复堆。布局有空位时先用默认构造的节点填充新节点之前的空位，
+    // 构造失败时移除这些空位。
+    template <typename... Args>
+    void appendNode(Args&&... args)
+    {
+        if constexpr (Layout::GROWS_IN_CHUNKS) {
+            this->reserveChunk();
+        }
+        if constexpr (Layout::PADDED) {
+            size_t num_slots = nodes_.size();
+            try {
+                nodes_.resize(this->reservedSlots() + this->nodePos(size_));
+                nodes_.emplace_back(std::forward<Args>(args)...);
+            } catch (...) {
+                nodes_.erase(nodes_.begin() + num_slots, nodes_.end());
+                throw;
+            }
+        } else {
+            nodes_.emplace_back(std::forward<Args>(args)...);
+        }
+        size_ += 1;
+    }
+    // 节点数组已满且扩容后不小于一个大页时按照hugePageGrowth以大块扩容。
+    void reserveChunk()
+    {
+        if (nodes_.size() == nodes_.capacity()) {
+            size_t capacity = hugePageGrowth(nodes_.capacity(), sizeof(T));
+            if (capacity > 0) {
+                nodes_.reserve(capacity);
+            }
+        }
+    }
+    // 将布局中的节点按照插入顺序依次移动到数组的开头（预留的位置之后），并移除其余的空位。
+    void compactNodes() noexcept
+    {
+        for (size_t node_idx = 1; node_idx < size_; node_idx++) {
+            if (this->nodePos(node_idx) != node_idx) {
+                this->nodeAt(node_idx) = std::move(this->nodeAt(this->nodePos(node_idx)));
+            }
+        }
+        nodes_.erase(nodes_.begin() + this->reservedSlots() + size_, nodes_.end());
+    }
+    // 将数组开头（预留的位置之后）按照插入顺序排列的size_个节点移动到布局中它们所在的位置。
+    void spreadNodes()
+    {
+        nodes_.resize(this->reservedSlots() + this->endPosOf(size_));
+        for (size_t node_idx = size_; node_idx > 1; node_idx--) {
+            if (this->nodePos(node_idx - 1) != node_idx - 1) {
+                this->nodeAt(this->nodePos(node_idx - 1)) = std::move(this->nodeAt(node_idx - 1));
+            }
+        }
+    }
+    // 返回堆中的第node_pos个节点。
+    T& nodeAt(NodePos node_pos) noexcept
+    {
+        return nodes_[node_pos + this->reservedSlots()];
+    }
+    const T& nodeAt(NodePos node_pos) const noexcept
+    {
+        return nodes_[node_pos + this->reservedSlots()];
+    }
+    // 预取第node_pos个节点的孙节点，它们在数组中是连续的，这样在比较子节点时下一层的数据已经在读入缓存。
+    void prefetchGrandchildren(NodePos node_pos) const noexcept
+    {
+        NodePos first_grandchild_pos = this->getChildNodePos(this->getChildNodePos(node_pos, 0), 0);
+        if (first_grandchild_pos >= this->endPos()) {
+            return;
+        }
+        NodePos last_grandchild_pos
+            = std::min(first_grandchild_pos + this->arity() * this->arity(), this->endPos());
+        prefetchRangeForRead(&this->nodeAt(first_grandchild_pos), &this->nodeAt(last_grandchild_pos - 1) + 1);
     }
     // 判断堆中第node_pos个节点是否为叶节点。
     bool isLeafNode(NodePos node_pos) const noexcept
     {
-        return d_ * node_pos + 2 > size_;
+        if constexpr (Layout::LEVEL_ORDER) {
+            return this->arity() * node_pos + 2 > size_;
+        } else {
+            return this->getChildNodePos(node_pos, 0) >= this->endPos();
+        }
     }
     // 返回堆中第parent_node_pos个节点的第child_ord个子节点的位置。
     NodePos getChildNodePos(NodePos parent_node_pos, size_t child_ord) const noexcept
     {
-        return d_ * parent_node_pos + child_ord + 1;
+        if constexpr (Layout::LEVEL_ORDER) {
+            return this->arity() * parent_node_pos + child_ord + 1;
+        } else {
+            return Layout::template firstChildPos<sizeof(T), D>(parent_node_pos) + child_ord;
+        }
     }
     // 返回堆中第child_pos个节点所属的父节点的位置。
     NodePos getParentNodePos(NodePos child_pos) const noexcept
     {
-        return (child_pos - 1) / d_;
+        if constexpr (Layout::LEVEL_ORDER) {
+            return (child_pos - 1) / this->arity();
+        } else {
+            return Layout::template parentPos<sizeof(T), D>(child_pos);
+        }
+    }
+    // 返回第parent_node_pos个节点的子节点中最应该靠近堆顶的那个的位置，调用前需确保该节点不是叶节点。
+    NodePos getBestChildNodePos(NodePos parent_node_pos) const noexcept
+    {
+        NodePos first_child_pos = this->getChildNodePos(parent_node_pos, 0);
+        if constexpr (simd::canSelectBestChild<T, D, Compare>()) {
+            // 子节点齐全时使用向量指令一次性选出最值，否则退化为逐个比较。
+            if (first_child_pos + D <= this->endPos()) {
+                return first_child_pos + simd::selectBestChild<T, D, Compare>(&this->nodeAt(first_child_pos));
+            }
+        }
+        NodePos last_child_pos = std::min(first_child_pos + this->arity(), this->endPos());
+        NodePos best_child_pos = first_child_pos;
+        for (NodePos child_node_pos = first_child_pos + 1; child_node_pos < last_child_pos; ++child_node_pos) {
+            if (cmp_func_(this->nodeAt(best_child_pos), this->nodeAt(child_node_pos))) {
+                best_child_pos = child_node_pos;
+            }
+        }
+        return best_child_pos;
     }
-    // 交换第i个和第j个节点的位置。
-    void swapNodes(NodePos pos_i, NodePos pos_j) noexcept
+    // 移除堆顶的节点并修复堆，堆顶节点中的数据此时可能已经被移走，调用前需确保堆不为空。
+    void removeTopNode()
     {
-        std::swap(nodes_[pos_i], nodes_[pos_j]);
+        T last_node = std::move(nodes_.back());
+        nodes_.pop_back();
+        size_ -= 1;
+        if constexpr (Layout::PADDED) {
+            // 移除最后一个节点之前的空位。
+            nodes_.erase(nodes_.begin() + this->reservedSlots() + this->endPosOf(size_), nodes_.end());
+        }
+        if (size_ == 0) {
+            return;
+        }
+        if (pop_strategy_ == PopStrategy::BOTTOM_UP) {
+            // 只比较子节点将堆顶的空位下移到叶节点，再将最后一个节点从空位处上浮。
+            NodePos hole_pos = 0;
+            while (!this->isLeafNode(hole_pos)) {
+                if constexpr (Layout::PREFETCH) {
+                    this->prefetchGrandchildren(hole_pos);
+                }
+                NodePos best_child_pos = this->getBestChildNodePos(hole_pos);
+                this->nodeAt(hole_pos) = std::move(this->nodeAt(best_child_pos));
+                hole_pos = best_child_pos;
+            }
+            this->heapifyUpWithHole(hole_pos, std::move(last_node));
+        } else {
+            this->heapifyDownWithHole(0, std::move(last_node));
+        }
     }
-    // 在pos_to_fix位置添加一个节点后通过bubble down的方式修复堆，时间复杂度O(d)。
+    // 在pos_to_fix位置添加一个节点后通过bubble down的方式修复堆，时间复杂度O(d*log_d(N))。
     void heapifyDown(NodePos pos_to_fix) noexcept
     {
-        NodePos comp_est = pos_to_fix, cur_pos = pos_to_fix;
-        while (!this->isLeafNode(cur_pos)) {
-            for (size_t child_order = 0; child_order < d_; ++child_order) {
-                auto child_node_pos = this->getChildNodePos(cur_pos, child_order);
-                if (child_node_pos < size_
-                    && cmp_func_(nodes_.at(comp_est), nodes_.at(child_node_pos))) {
-                    comp_est = child_node_pos;
-                }
+        if (this->isLeafNode(pos_to_fix)) {
+            return;
+        }
+        this->heapifyDownWithHole(pos_to_fix, std::move(this->nodeAt(pos_to_fix)));
+    }
+    // 将hole_pos处视为空位，把node_to_fix沿空位下沉，每层只移动一次节点，最后将node_to_fix写入其最终位置。
+    void heapifyDownWithHole(NodePos hole_pos, T node_to_fix) noexcept
+    {
+        while (!this->isLeafNode(hole_pos)) {
+            if constexpr (Layout::PREFETCH) {
+                this->prefetchGrandchildren(hole_pos);
             }
-            if (cur_pos == comp_est) {
-                return;
+            NodePos best_child_pos = this->getBestChildNodePos(hole_pos);
+            if (!cmp_func_(node_to_fix, this->nodeAt(best_child_pos))) {
+                break;
             }
-            this->swapNodes(cur_pos, comp_est);
-            cur_pos = comp_est;
+            this->nodeAt(hole_pos) = std::move(this->nodeAt(best_child_pos));
+            hole_pos = best_child_pos;
         }
+        this->nodeAt(hole_pos) = std::move(node_to_fix);
     }
-    // 在pos_to_fix位置添加一个节点后通过bubble up的方式修复堆，时间复杂度O(d)。
+    // 在pos_to_fix位置添加一个节点后通过bubble up的方式修复堆，时间复杂度O(log_d(N))。
     void heapifyUp(NodePos pos_to_fix) noexcept
     {
-        while (pos_to_fix > 0) {
-            NodePos parent_node_pos = this->getParentNodePos(pos_to_fix);
-            if (!cmp_func_(nodes_.at(parent_node_pos), nodes_.at(pos_to_fix))) {
-                return;
+        this->heapifyUpWithHole(pos_to_fix, std::move(this->nodeAt(pos_to_fix)));
+    }
+    // 将hole_pos处视为空位，把node_to_fix沿空位上浮，每层只移动一次节点，最后将node_to_fix写入其最终位置。
+    void heapifyUpWithHole(NodePos hole_pos, T node_to_fix) noexcept
+    {
+        while (hole_pos > 0) {
+            NodePos parent_node_pos = this->getParentNodePos(hole_pos);
+            if (!cmp_func_(this->nodeAt(parent_node_pos), node_to_fix)) {
+                break;
             }
-            this->swapNodes(pos_to_fix, parent_node_pos);
-            pos_to_fix = parent_node_pos;
+            this->nodeAt(hole_pos) = std::move(this->nodeAt(parent_node_pos));
+            hole_pos = parent_node_pos;
         }
+        this->nodeAt(hole_pos) = std::move(node_to_fix);
     }
 };
 
@@ -164,17 +581,68 @@ auto createEmptyMaxDHeap(int d = 2)
     return DAryHeap<T>(d, std::less<T>(), std::vector<T>());
 }
 
-// 使用堆中的节点nodes来构造最小堆。
+// 使用堆中的节点nodes来构造最小堆，num_threads为建堆时使用的线程数量。
 template <typename T, typename Nodes>
-auto buildMinDHeap(int d, Nodes&& nodes)
+auto buildMinDHeap(int d, Nodes&& nodes, size_t num_threads = 1)
 {
-    return DAryHeap<T>(d, std::greater<T>(), std::forward<Nodes>(nodes));
+    return DAryHeap<T>(d, std::greater<T>(), std::forward<Nodes>(nodes), num_threads);
 }
 
-// 使用堆中的节点nodes来构造最大堆。
+// 使用堆中的节点nodes来构造最大堆，num_threads为建堆时使用的线程数量。
 template <typename T, typename Nodes>
-auto buildMaxDHeap(int d, Nodes&& nodes)
+auto buildMaxDHeap(int d, Nodes&& nodes, size_t num_threads = 1)
+{
+    return DAryHeap<T>(d, std::less<T>(), std::forward<Nodes>(nodes), num_threads);
+}
+
+// 构建空的最小堆，每个父节点最多可以有D个子节点，D在编译期确定。
+template <typename T, int D>
+auto createEmptyMinDHeap()
+{
+    return DAryHeap<T, D, std::greater<T>>(D, std::greater<T>(), std::vector<T>());
+}
+
+// 构建空的最大堆，每个父节点最多可以有D个子节点，D在编译期确定。
+template <typename T, int D>
+auto createEmptyMaxDHeap()
+{
+    return DAryHeap<T, D, std::less<T>>(D, std::less<T>(), std::vector<T>());
+}
+
+// 使用堆中的节点nodes来构造最小堆，每个父节点最多可以有D个子节点，D在编译期确定，num_threads为建堆时
+// 使用的线程数量。
+template <typename T, int D, typename Nodes>
+auto buildMinDHeap(Nodes&& nodes, size_t num_threads = 1)
+{
+    return DAryHeap<T, D, std::greater<T>>(D, std::greater<T>(), std::forward<Nodes>(nodes), num_threads);
+}
+
+// 使用堆中的节点nodes来构造最大堆，每个父节点最多可以有D个子节点，D在编译期确定，num_threads为建堆时
+// 使用的线程数量。
+template <typename T, int D, typename Nodes>
+auto buildMaxDHeap(Nodes&& nodes, size_t num_threads = 1)
+{
+    return DAryHeap<T, D, std::less<T>>(D, std::less<T>(), std::forward<Nodes>(nodes), num_threads);
+}
+}
+
+namespace custom_cont::pmr {
+// 使用std::pmr::polymorphic_allocator存储节点的D叉堆，节点存储于构造时指定的内存资源中。
+template <typename T, int D = DYNAMIC_ARITY, typename Compare = std::function<bool(const T&, const T&)>,
+    typename Layout = ImplicitLayout>
+using DAryHeap = custom_cont::DAryHeap<T, D, Compare, Layout, std::pmr::polymorphic_allocator<T>>;
+
+// 构建空的最小堆，节点存储于内存资源resource中，D在编译期确定。
+template <typename T, int D>
+auto createEmptyMinDHeap(std::pmr::memory_resource* resource)
+{
+    return DAryHeap<T, D, std::greater<T>>(D, std::greater<T>(), std::vector<T>(), resource);
+}
+
+// 构建空的最大堆，节点存储于内存资源resource中，D在编译期确定。
+template <typename T, int D>
+auto createEmptyMaxDHeap(std::pmr::memory_resource* resource)
 {
-    return DAryHeap<T>(d, std::less<T>(), std::forward<Nodes>(nodes));
+    return DAryHeap<T, D, std::less<T>>(D, std::less<T>(), std::vector<T>(), resource);
 }
 }
@@ -0,0 +1,364 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "parallel_build.hpp"
+
+namespace custom_cont {
+// 优先队列中元素的存储和索引。每个元素只在槽位数组中存储一次，槽位中同时记录了元素在堆中的位置，堆中的节点只需
+// 保存槽位的编号，移动节点时直接修改槽位中记录的位置而不需要重新计算哈希值。查找元素时使用开放寻址（线性探测）的
+// 哈希表，表中只保存槽位的编号和元素的哈希值，比较哈希值相同后才会访问槽位中的元素。T: 元素,
+// THash: 用于求解元素哈希值的函数, Allocator: 存储槽位和哈希表时使用的分配器（rebind为相应的类型）。
+template <typename T, typename THash = std::hash<T>, typename Allocator = std::allocator<T>>
+class ElementIndex {
+public:
+    // 槽位的编号，元素在离开索引之前编号保持不变。
+    using SlotId = uint32_t;
+    // 表示不存在的槽位。
+    static constexpr SlotId NO_SLOT = std::numeric_limits<SlotId>::max();
+    // 指向一个元素所在槽位的句柄。元素离开索引后槽位的版本号会增加，旧的句柄随之失效，即使该槽位被其它元素复用。
+    struct Handle {
+        SlotId slot_id_ { NO_SLOT };
+        uint32_t generation_ { 0 };
+    };
+
+    ElementIndex() = default;
+    explicit ElementIndex(THash hasher, const Allocator& alloc = Allocator())
+        : hasher_(std::move(hasher))
+        , slots_(alloc)
+        , free_slots_(alloc)
+        , buckets_(alloc)
+    {
+    }
+
+    // 返回索引中元素的数量。
+    size_t size() const noexcept { return size_; }
+    // 预留可以容纳num_elements个元素的空间，使之后的插入不会触发扩容。
+    void reserve(size_t num_elements)
+    {
+        slots_.reserve(num_elements);
+        size_t num_buckets = std::max<size_t>(buckets_.size(), MIN_NUM_BUCKETS);
+        while (num_elements * MAX_LOAD_DEN > num_buckets * MAX_LOAD_NUM) {
+            num_buckets *= 2;
+        }
+        if (num_buckets != buckets_.size()) {
+            this->rehash(num_buckets);
+        }
+    }
+    // 返回元素element所在槽位的编号，不存在时返回NO_SLOT。
+    SlotId find(const T& element) const
+    {
+        if (size_ == 0) {
+            return NO_SLOT;
+        }
+        uint32_t hash = this->hashOf(element);
+        for (size_t bucket_idx = this->homeBucket(hash);; bucket_idx = this->nextBucket(bucket_idx)) {
+            const Bucket& bucket = buckets_[bucket_idx];
+            if (bucket.slot_id_ == NO_SLOT) {
+                return NO_SLOT;
+            }
+            if (bucket.hash_ == hash && slots_[bucket.slot_id_].element_ == element) {
+                return bucket.slot_id_;
+            }
+        }
+    }
+    // 将元素element存入一个槽位并返回它的编号和是否插入成功。执行重复性检测时，若元素已存在则返回已有元素的槽位，
+    // 否则不与已有元素比较，相同的元素会被存入不同的槽位。
+    template <bool perform_chk = true, typename TFwd>
+    std::pair<SlotId, bool> insert(TFwd&& element)
+    {
+        if constexpr (!std::is_same_v<std::decay_t<TFwd>, T>) {
+            return this->insert<perform_chk>(T(std::forward<TFwd>(element)));
+        } else {
+            if ((size_ + 1) * MAX_LOAD_DEN > buckets_.size() * MAX_LOAD_NUM) {
+                this->rehash(std::max<size_t>(buckets_.size() * 2, MIN_NUM_BUCKETS));
+            }
+            uint32_t hash = this->hashOf(element);
+            size_t bucket_idx = this->homeBucket(hash);
+            for (; buckets_[bucket_idx].slot_id_ != NO_SLOT; bucket_idx = this->nextBucket(bucket_idx)) {
+                const Bucket& bucket = buckets_[bucket_idx];
+                if (perform_chk && bucket.hash_ == hash && slots_[bucket.slot_id_].element_ == element) {
+                    return { bucket.slot_id_, false };
+                }
+            }
+            SlotId slot_id = this->allocateSlot(std::forward<TFwd>(element), hash);
+            buckets_[bucket_idx] = Bucket { slot_id, hash };
+            size_ += 1;
+            return { slot_id, true };
+        }
+    }
+    // 清空索引后依次存入elements中的所有元素，第i个元素存储于第i个槽位，使用num_threads个线程计算哈希值、填充
+    // 槽位和哈希表。哈希表被划分为若干段，初始位置在同一段中的元素由同一个线程按照输入的顺序插入，探测越过该段
+    // 末尾的元素最后在当前线程中逐个插入。elements为右值时移动其中的元素。存在相同的元素时返回false，此时索引中
+    // 的内容不确定，只能清空或销毁。
+    template <typename Elements>
+    bool assignUnique(Elements&& elements, size_t num_threads)
+    {
+        static_assert(std::is_same_v<std::decay_t<Elements>, std::vector<T>>, "Elements must be std::vector<T>!!!");
+        constexpr bool move_elements = std::is_rvalue_reference_v<Elements&&>;
+        size_t num_elements = elements.size();
+        if (num_elements >= NO_SLOT) {
+            throw std::length_error("Too many elements in the index!!!");
+        }
+        slots_.clear();
+        free_slots_.clear();
+        buckets_.clear();
+        size_ = 0;
+        this->reserve(num_elements);
+        if (num_elements < MIN_NODES_TO_BUILD_IN_PARALLEL) {
+            num_threads = 1;
+        }
+        if constexpr (std::is_default_constructible_v<T>) {
+            slots_.resize(num_elements);
+            parallelFor(num_elements, num_threads, [&](size_t lo, size_t hi) {
+                for (size_t i = lo; i < hi; i++) {
+                    slots_[i].hash_ = this->hashOf(elements[i]);
+                    if constexpr (move_elements) {
+                        slots_[i].element_ = std::move(elements[i]);
+                    } else {
+                        slots_[i].element_ = elements[i];
+                    }
+                }
+            });
+        } else {
+            std::vector<uint32_t> hashes(num_elements);
+            parallelFor(num_elements, num_threads, [&](size_t lo, size_t hi) {
+                for (size_t i = lo; i < hi; i++) {
+                    hashes[i] = this->hashOf(elements[i]);
+                }
+            });
+            for (size_t i = 0; i < num_elements; i++) {
+                if constexpr (move_elements) {
+                    slots_.push_back(Slot { std::move(elements[i]), 0, hashes[i], 0 });
+                } else {
+                    slots_.push_back(Slot { elements[i], 0, hashes[i], 0 });
+                }
+            }
+        }
+        // 段数为2的幂，使每段包含相同数量的桶。
+        size_t num_segments = 1;
+        while (num_segments < num_threads * CHUNKS_PER_THREAD && num_segments * MIN_NUM_BUCKETS < buckets_.size()) {
+            num_segments *= 2;
+        }
+        size_t segment_size = buckets_.size() / num_segments;
+        // 将元素的编号按照初始位置所在的段分组，组内保持输入的顺序。
+        size_t num_blocks = std::max<size_t>(num_threads * CHUNKS_PER_THREAD, 1);
+        size_t block_size = (num_elements + num_blocks - 1) / num_blocks;
+        std::vector<size_t> offsets(num_blocks * num_segments + 1, 0);
+        auto segmentOf = [&](SlotId slot_id) { return this->homeBucket(slots_[slot_id].hash_) / segment_size; };
+        parallelFor(num_blocks, num_threads, [&](size_t lo, size_t hi) {
+            for (size_t block = lo; block < hi; block++) {
+                for (size_t i = block * block_size; i < std::min((block + 1) * block_size, num_elements); i++) {
+                    offsets[segmentOf(static_cast<SlotId>(i)) * num_blocks + block + 1] += 1;
+                }
+            }
+        });
+        for (size_t i = 1; i < offsets.size(); i++) {
+            offsets[i] += offsets[i - 1];
+        }
+        std::vector<SlotId> grouped_ids(num_elements);
+        parallelFor(num_blocks, num_threads, [&](size_t lo, size_t hi) {
+            for (size_t block = lo; block < hi; block++) {
+                for (size_t i = block * block_size; i < std::min((block + 1) * block_size, num_elements); i++) {
+                    size_t& offset = offsets[segmentOf(static_cast<SlotId>(i)) * num_blocks + block];
+                    grouped_ids[offset++] = static_cast<SlotId>(i);
+                }
+            }
+        });
+        // 经过上一步后offsets[seg * num_blocks + block]指向下一组的开头，第seg段的元素位于
+        // [offsets[seg * num_blocks - 1], offsets[(seg + 1) * num_blocks - 1])中。
+        std::vector<std::vector<SlotId>> overflowed_ids(num_segments);
+        std::atomic<bool> has_duplicates { false };
+        parallelFor(num_segments, num_threads, [&](size_t lo, size_t hi) {
+            for (size_t segment = lo; segment < hi; segment++) {
+                size_t first = segment == 0 ? 0 : offsets[segment * num_blocks - 1];
+                size_t last = offsets[(segment + 1) * num_blocks - 1];
+                size_t segment_end = (segment + 1) * segment_size;
+                for (size_t i = first; i < last; i++) {
+                    SlotId slot_id = grouped_ids[i];
+                    size_t bucket_idx = this->probeForInsert(slot_id, segment_end, has_duplicates);
+                    if (bucket_idx == segment_end) {
+                        overflowed_ids[segment].push_back(slot_id);
+                    } else {
+                        buckets_[bucket_idx] = Bucket { slot_id, slots_[slot_id].hash_ };
+                    }
+                }
+            }
+        });
+        for (const auto& slot_ids : overflowed_ids) {
+            for (SlotId slot_id : slot_ids) {
+                size_t bucket_idx = this->probeForInsert(slot_id, buckets_.size(), has_duplicates);
+                buckets_[bucket_idx] = Bucket { slot_id, slots_[slot_id].hash_ };
+            }
+        }
+        size_ = num_elements;
+        return !has_duplicates.load();
+    }
+    // 将第slot_id个槽位中的元素移出索引并返回它，之后该槽位可能被其它元素复用。
+    T extract(SlotId slot_id)
+    {
+        Slot& slot = slots_[slot_id];
+        size_t bucket_idx = this->homeBucket(slot.hash_);
+        while (buckets_[bucket_idx].slot_id_ != slot_id) {
+            bucket_idx = this->nextBucket(bucket_idx);
+        }
+        this->removeBucket(bucket_idx);
+        slot.generation_ += 1;
+        free_slots_.push_back(slot_id);
+        size_ -= 1;
+        return std::move(slot.element_);
+    }
+    // 从索引中移除第slot_id个槽位中的元素。
+    void erase(SlotId slot_id)
+    {
+        this->extract(slot_id);
+    }
+    // 将第slot_id个槽位中的元素移出但不修改哈希表，之后必须调用clear()，用于一次性移出所有元素。
+    T release(SlotId slot_id) noexcept { return std::move(slots_[slot_id].element_); }
+    // 清空索引并释放所有槽位，指向它们的句柄随之失效，已分配的存储空间保留以便复用。
+    void clear()
+    {
+        std::fill(buckets_.begin(), buckets_.end(), Bucket());
+        free_slots_.clear();
+        // 倒序放入待复用的列表，使编号较小的槽位先被复用。
+        for (size_t slot_id = slots_.size(); slot_id > 0; --slot_id) {
+            slots_[slot_id - 1].generation_ += 1;
+            free_slots_.push_back(static_cast<SlotId>(slot_id - 1));
+        }
+        size_ = 0;
+    }
+    // 返回指向第slot_id个槽位的句柄。
+    Handle handleOf(SlotId slot_id) const noexcept { return Handle { slot_id, slots_[slot_id].generation_ }; }
+    // 返回句柄handle所指向的槽位的编号，句柄已失效时返回NO_SLOT。
+    SlotId slotOf(Handle handle) const noexcept
+    {
+        if (handle.slot_id_ >= slots_.size() || slots_[handle.slot_id_].generation_ != handle.generation_) {
+            return NO_SLOT;
+        }
+        return handle.slot_id_;
+    }
+    // 返回第slot_id个槽位中的元素。
+    const T& element(SlotId slot_id) const noexcept { return slots_[slot_id].element_; }
+    // 返回第slot_id个槽位中的元素在堆中的位置。
+    size_t& pos(SlotId slot_id) noexcept { return slots_[slot_id].pos_; }
+    size_t pos(SlotId slot_id) const noexcept { return slots_[slot_id].pos_; }
+
+private:
+    // 存储一个元素的槽位。
+    struct Slot {
+        T element_;
+        // 元素在堆中的位置。
+        size_t pos_;
+        // 元素的哈希值，用于在移除元素时定位哈希表中的桶。
+        uint32_t hash_;
+        // 槽位的版本号，每次槽位被释放时增加。
+        uint32_t generation_;
+    };
+    // 哈希表中的桶，只保存槽位编号和元素的哈希值。
+    struct Bucket {
+        SlotId slot_id_ { NO_SLOT };
+        uint32_t hash_ { 0 };
+    };
+
+    // 哈希表的最小桶数，必须为2的幂。
+    static constexpr size_t MIN_NUM_BUCKETS = 8;
+    // 哈希表的最大负载率为MAX_LOAD_NUM/MAX_LOAD_DEN。
+    static constexpr size_t MAX_LOAD_NUM = 3, MAX_LOAD_DEN = 4;
+
+    // 计算元素element的哈希值，并将其打散，使std::hash<int>等恒等哈希在线性探测下也不会聚集。
+    uint32_t hashOf(const T& element) const
+    {
+        return static_cast<uint32_t>((static_cast<uint64_t>(hasher_(element)) * 0x9E3779B97F4A7C15ull) >> 32);
+    }
+    size_t homeBucket(uint32_t hash) const noexcept { return hash & (buckets_.size() - 1); }
+    size_t nextBucket(size_t bucket_idx) const noexcept { return (bucket_idx + 1) & (buckets_.size() - 1); }
+    // 从第slot_id个槽位中元素的初始位置开始线性探测，返回第一个空桶的编号，遇到相同的元素时将has_duplicates置为
+    // true。limit小于桶数时探测不会回绕，到达第limit个桶时返回limit。
+    size_t probeForInsert(SlotId slot_id, size_t limit, std::atomic<bool>& has_duplicates) const
+    {
+        const Slot& slot = slots_[slot_id];
+        size_t bucket_idx = this->homeBucket(slot.hash_);
+        for (; bucket_idx != limit && buckets_[bucket_idx].slot_id_ != NO_SLOT;
+             bucket_idx = limit == buckets_.size() ? this->nextBucket(bucket_idx) : bucket_idx + 1) {
+            const Bucket& bucket = buckets_[bucket_idx];
+            if (bucket.hash_ == slot.hash_ && slots_[bucket.slot_id_].element_ == slot.element_) {
+                has_duplicates.store(true, std::memory_order_relaxed);
+            }
+        }
+        return bucket_idx;
+    }
+    // 为元素element分配一个槽位，优先复用已被释放的槽位。
+    template <typename TFwd>
+    SlotId allocateSlot(TFwd&& element, uint32_t hash)
+    {
+        if (!free_slots_.empty()) {
+            SlotId slot_id = free_slots_.back();
+            free_slots_.pop_back();
+            slots_[slot_id].element_ = std::forward<TFwd>(element);
+            slots_[slot_id].hash_ = hash;
+            return slot_id;
+        }
+        if (slots_.size() >= NO_SLOT) {
+            throw std::length_error("Too many elements in the index!!!");
+        }
+        slots_.push_back(Slot { T(std::forward<TFwd>(element)), 0, hash, 0 });
+        return static_cast<SlotId>(slots_.size() - 1);
+    }
+    // 清空第bucket_idx个桶，并将其后的桶向前移动以填补空位，从而不需要墓碑标记。
+    void removeBucket(size_t bucket_idx) noexcept
+    {
+        size_t hole_idx = bucket_idx;
+        for (size_t next_idx = this->nextBucket(hole_idx); buckets_[next_idx].slot_id_ != NO_SLOT;
+             next_idx = this->nextBucket(next_idx)) {
+            size_t mask = buckets_.size() - 1;
+            size_t home_idx = this->homeBucket(buckets_[next_idx].hash_);
+            // 只有当空位位于该桶的初始位置和当前位置之间时才能将它前移。
+            if (((next_idx - home_idx) & mask) >= ((next_idx - hole_idx) & mask)) {
+                buckets_[hole_idx] = buckets_[next_idx];
+                hole_idx = next_idx;
+            }
+        }
+        buckets_[hole_idx] = Bucket();
+    }
+    // 将哈希表扩容至num_buckets个桶。
+    void rehash(size_t num_buckets)
+    {
+        Vector<Bucket> old_buckets(num_buckets, Bucket(), buckets_.get_allocator());
+        old_buckets.swap(buckets_);
+        for (const auto& bucket : old_buckets) {
+            if (bucket.slot_id_ == NO_SLOT) {
+                continue;
+            }
+            size_t bucket_idx = this->homeBucket(bucket.hash_);
+            while (buckets_[bucket_idx].slot_id_ != NO_SLOT) {
+                bucket_idx = this->nextBucket(bucket_idx);
+            }
+            buckets_[bucket_idx] = bucket;
+        }
+    }
+
+    // 使用rebind后的分配器存储类型为U的数组。
+    template <typename U>
+    using Vector = std::vector<U, typename std::allocator_traits<Allocator>::template rebind_alloc<U>>;
+
+    THash hasher_;
+    // 存储元素的槽位。
+    Vector<Slot> slots_;
+    // 已被释放、可以复用的槽位。
+    Vector<SlotId> free_slots_;
+    // 开放寻址的哈希表，桶数为2的幂。
+    Vector<Bucket> buckets_;
+    // 索引中元素的数量。
+    size_t size_ { 0 };
+};
+}
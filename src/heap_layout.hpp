@@ -0,0 +1,373 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <type_traits>
+#include <unordered_set>
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#endif
+
+namespace custom_cont {
+// 缓存行的大小（字节）。
+constexpr size_t CACHE_LINE_SIZE = 64;
+
+// 按ALIGNMENT字节对齐分配内存的分配器。
+template <typename T, size_t ALIGNMENT>
+class AlignedAllocator {
+public:
+    using value_type = T;
+    template <typename U>
+    struct rebind {
+        using other = AlignedAllocator<U, ALIGNMENT>;
+    };
+
+    AlignedAllocator() noexcept = default;
+    template <typename U>
+    AlignedAllocator(const AlignedAllocator<U, ALIGNMENT>&) noexcept
+    {
+    }
+
+    T* allocate(size_t num)
+    {
+        return static_cast<T*>(::operator new(num * sizeof(T), std::align_val_t(ALIGNMENT)));
+    }
+    void deallocate(T* ptr, size_t) noexcept
+    {
+        ::operator delete(ptr, std::align_val_t(ALIGNMENT));
+    }
+    template <typename U>
+    bool operator==(const AlignedAllocator<U, ALIGNMENT>&) const noexcept { return true; }
+    template <typename U>
+    bool operator!=(const AlignedAllocator<U, ALIGNMENT>&) const noexcept { return false; }
+};
+
+// 透明大页的大小（字节）。
+constexpr size_t HUGE_PAGE_SIZE = size_t(2) << 20;
+
+// 将num_bytes向上取整为大页大小的整数倍。
+constexpr size_t roundUpToHugePage(size_t num_bytes) noexcept
+{
+    return (num_bytes + HUGE_PAGE_SIZE - 1) & ~(HUGE_PAGE_SIZE - 1);
+}
+
+// 大页数组扩容时容量至少增长的倍数。
+constexpr size_t HUGE_PAGE_GROWTH_FACTOR = 4;
+
+// 返回每个位置占用node_size字节、容量为capacity的节点数组已满时按大块扩容所需的容量。新数组不小于一个大页时
+// 容量至少增长为原来的HUGE_PAGE_GROWTH_FACTOR倍，并向上取整到整数个大页，使映射得到的大页全部可以存放节点；
+// 否则返回0，由std::vector按照自己的规则扩容。
+constexpr size_t hugePageGrowth(size_t capacity, size_t node_size) noexcept
+{
+    size_t num_bytes = std::max(capacity, size_t(1)) * HUGE_PAGE_GROWTH_FACTOR * node_size;
+    if (num_bytes < HUGE_PAGE_SIZE) {
+        return 0;
+    }
+    return roundUpToHugePage(num_bytes) / node_size;
+}
+
+#if defined(__linux__)
+// 使用mmap映射num_bytes字节（大页大小的整数倍）的匿名内存，起始地址按大页对齐，并建议内核使用透明大页，映射失败
+// 时返回nullptr。内核不支持或关闭了透明大页时madvise失败，此时内存仍然可用，只是由普通页组成。
+inline void* mapHugePages(size_t num_bytes) noexcept
+{
+    // 多映射一个大页，再释放开头和末尾多余的部分，使起始地址按大页对齐。
+    size_t map_size = num_bytes + HUGE_PAGE_SIZE;
+    void* ptr = ::mmap(nullptr, map_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (ptr == MAP_FAILED) {
+        return nullptr;
+    }
+    auto map_addr = reinterpret_cast<uintptr_t>(ptr);
+    auto aligned_addr = (map_addr + HUGE_PAGE_SIZE - 1) & ~(uintptr_t(HUGE_PAGE_SIZE) - 1);
+    size_t head_size = aligned_addr - map_addr, tail_size = map_size - head_size - num_bytes;
+    if (head_size > 0) {
+        ::munmap(ptr, head_size);
+    }
+    if (tail_size > 0) {
+        ::munmap(reinterpret_cast<void*>(aligned_addr + num_bytes), tail_size);
+    }
+#if defined(MADV_HUGEPAGE)
+    ::madvise(reinterpret_cast<void*>(aligned_addr), num_bytes, MADV_HUGEPAGE);
+#endif
+    return reinterpret_cast<void*>(aligned_addr);
+}
+
+// 记录通过mapHugePages分配的内存块的起始地址，释放时据此区分映射得到的内存块和映射失败后改用operator new
+// 分配的内存块。只有不小于一个大页的数组会被记录，查找的开销相对于分配和释放这样大的数组可以忽略。
+class HugePageRegistry {
+public:
+    // 映射num_bytes字节的内存并记录下来，映射失败时返回nullptr。
+    static void* map(size_t num_bytes)
+    {
+        void* ptr = mapHugePages(num_bytes);
+        if (ptr == nullptr) {
+            return nullptr;
+        }
+        try {
+            std::lock_guard<std::mutex> lock(mutex());
+            blocks().insert(ptr);
+        } catch (...) {
+            ::munmap(ptr, num_bytes);
+            throw;
+        }
+        return ptr;
+    }
+    // 内存块ptr是映射得到的时解除映射并返回true，否则返回false。
+    static bool unmap(void* ptr, size_t num_bytes) noexcept
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex());
+            if (blocks().erase(ptr) == 0) {
+                return false;
+            }
+        }
+        ::munmap(ptr, num_bytes);
+        return true;
+    }
+
+private:
+    static std::mutex& mutex() noexcept
+    {
+        static std::mutex mutex;
+        return mutex;
+    }
+    static std::unordered_set<void*>& blocks() noexcept
+    {
+        static std::unordered_set<void*> blocks;
+        return blocks;
+    }
+};
+#endif
+
+// 使用透明大页存储大数组的分配器。不小于HUGE_PAGE_SIZE的数组在Linux上通过mapHugePages分配，映射失败时改用
+// operator new。较小的数组和其他平台使用operator new，避免小数组占用整个大页。
+template <typename T>
+class HugePageAllocator {
+public:
+    using value_type = T;
+
+    HugePageAllocator() noexcept = default;
+    template <typename U>
+    HugePageAllocator(const HugePageAllocator<U>&) noexcept
+    {
+    }
+
+    T* allocate(size_t num)
+    {
+#if defined(__linux__)
+        if (num * sizeof(T) >= HUGE_PAGE_SIZE) {
+            void* ptr = HugePageRegistry::map(roundUpToHugePage(num * sizeof(T)));
+            if (ptr != nullptr) {
+                return static_cast<T*>(ptr);
+            }
+        }
+#endif
+        return static_cast<T*>(::operator new(num * sizeof(T)));
+    }
+    void deallocate(T* ptr, size_t num) noexcept
+    {
+#if defined(__linux__)
+        if (num * sizeof(T) >= HUGE_PAGE_SIZE && HugePageRegistry::unmap(ptr, roundUpToHugePage(num * sizeof(T)))) {
+            return;
+        }
+#endif
+        ::operator delete(ptr);
+    }
+    template <typename U>
+    bool operator==(const HugePageAllocator<U>&) const noexcept { return true; }
+    template <typename U>
+    bool operator!=(const HugePageAllocator<U>&) const noexcept { return false; }
+};
+
+// 预取ptr所在的缓存行。
+inline void prefetchForRead(const void* ptr) noexcept
+{
+#if defined(__GNUC__)
+    __builtin_prefetch(ptr, 0, 3);
+#endif
+}
+
+// 预取[first, last)所覆盖的每一个缓存行。
+inline void prefetchRangeForRead(const void* first, const void* last) noexcept
+{
+    auto line_addr = reinterpret_cast<uintptr_t>(first) & ~(uintptr_t(CACHE_LINE_SIZE) - 1);
+    for (; line_addr < reinterpret_cast<uintptr_t>(last); line_addr += CACHE_LINE_SIZE) {
+        prefetchForRead(reinterpret_cast<const void*>(line_addr));
+    }
+}
+
+// 默认的布局：第p个节点的子节点依次存储于d*p+1到d*p+d的位置。
+struct ImplicitLayout {
+    // 节点数组开头是否预留空位。
+    static constexpr bool RESERVES_SLOTS = false;
+    // 节点数组开头预留的空位数量。
+    static constexpr size_t reservedSlots(size_t) noexcept { return 0; }
+    // 下沉时是否预取孙节点。
+    static constexpr bool PREFETCH = false;
+    // 节点是否按照层序排列。为false时布局需要提供firstChildPos和parentPos，且只支持在编译期确定的D。
+    static constexpr bool LEVEL_ORDER = true;
+    // 节点之间是否留有空位。为true时布局需要提供nodePos，空位中存放默认构造的节点。
+    static constexpr bool PADDED = false;
+    // 节点数组是否按照hugePageGrowth以大块扩容。
+    static constexpr bool GROWS_IN_CHUNKS = false;
+    // 存储节点时使用的分配器。
+    template <typename T>
+    using Allocator = std::allocator<T>;
+};
+
+// 按缓存行对齐的布局：节点数组按缓存行对齐，且开头预留d-1个空位，使第p个节点的子节点从数组的第d*(p+1)个位置
+// 开始存储。当d*sizeof(T)为2的幂时每组兄弟节点占用的缓存行数量最少，为64字节时恰好占满一个缓存行。在下沉的过程中
+// 会预取孙节点所在的缓存行，适用于节点数远超过缓存容量的堆。预留的空位要求节点可以被默认构造。
+struct CacheAlignedLayout {
+    static constexpr bool RESERVES_SLOTS = true;
+    static constexpr size_t reservedSlots(size_t d) noexcept { return d - 1; }
+    static constexpr bool PREFETCH = true;
+    static constexpr bool LEVEL_ORDER = true;
+    static constexpr bool PADDED = false;
+    static constexpr bool GROWS_IN_CHUNKS = false;
+    template <typename T>
+    using Allocator = AlignedAllocator<T, CACHE_LINE_SIZE>;
+};
+
+// 使用透明大页的布局：节点的排列方式与ImplicitLayout相同，但不小于HUGE_PAGE_SIZE的节点数组使用透明大页存储，
+// 减少在超过数GB的堆中下沉时几乎每层都会发生的TLB缺失。std::vector无法原地扩容，每次扩容都需要分配新的数组并
+// 移动节点，因此节点数组一旦达到大页的大小就按HUGE_PAGE_GROWTH_FACTOR倍以大块扩容，扩容次数远少于按两倍扩容；
+// 未被访问的预留部分不占用物理内存。节点数量可以预估时仍应先调用reserve。
+struct HugePageLayout {
+    static constexpr bool RESERVES_SLOTS = false;
+    static constexpr size_t reservedSlots(size_t) noexcept { return 0; }
+    static constexpr bool PREFETCH = false;
+    static constexpr bool LEVEL_ORDER = true;
+    static constexpr bool PADDED = false;
+    static constexpr bool GROWS_IN_CHUNKS = true;
+    template <typename T>
+    using Allocator = HugePageAllocator<T>;
+};
+
+// 内存页的大小（字节）。
+constexpr size_t MEMORY_PAGE_SIZE = 4096;
+
+// Kamp的B-heap风格的分页布局：节点数组按PAGE_BYTES字节对齐，并被划分为连续的页，每页占用PAGE_BYTES / sizeof(T)
+// 个位置，存储d棵互为兄弟的子树的前若干层。根节点位于第0页，它的子节点是第0页的第一组兄弟节点；页内按照层序
+// 排列，页内最后一层的节点的子节点是另一页的第一组兄弟节点，各页之间按照页的层序排列。每页开头预留d-1个位置
+// （第0页的最后一个预留位置存放根节点），页的末尾放不下完整一层的位置也留空，因此d*sizeof(T)整除缓存行大小或
+// 为其整数倍时每组兄弟节点都从缓存行的边界开始存储。sizeof(T)整除PAGE_BYTES时每页恰好对应一个内存页，下沉时
+// 每经过页内的若干层才会进入一个新的内存页，而层序布局在堆超过缓存容量后几乎每层都会访问一个新的内存页。
+// 空位要求节点可以被默认构造，并且占用额外的内存：以8字节的节点和4KB的页为例，d = 2、4、8时每页分别存放510、
+// 340和72个节点，节点数组的大小约为层序布局的1.0、1.5和7.1倍。
+template <size_t PAGE_BYTES = MEMORY_PAGE_SIZE>
+struct BHeapLayout {
+    static constexpr bool RESERVES_SLOTS = true;
+    static constexpr size_t reservedSlots(size_t d) noexcept { return d - 1; }
+    static constexpr bool PREFETCH = false;
+    static constexpr bool LEVEL_ORDER = false;
+    static constexpr bool PADDED = true;
+    static constexpr bool GROWS_IN_CHUNKS = false;
+    template <typename T>
+    using Allocator = AlignedAllocator<T, PAGE_BYTES>;
+
+    // 节点大小为NODE_SIZE字节、每个父节点最多有D个子节点时页的形状。
+    template <size_t NODE_SIZE, size_t D>
+    struct PageShape {
+        // 每页占用的位置数量。
+        static constexpr size_t NUM_SLOTS = PAGE_BYTES / NODE_SIZE;
+        static_assert(NUM_SLOTS >= 2 * D, "A page must hold at least one group of siblings!!!");
+
+        // 每页中的层数，至少为1。
+        static constexpr size_t numLevels() noexcept
+        {
+            size_t num_levels = 1, num_bottom_nodes = D, num_nodes = D;
+            while (num_nodes + num_bottom_nodes * D <= NUM_SLOTS - D) {
+                num_bottom_nodes *= D;
+                num_nodes += num_bottom_nodes;
+                num_levels += 1;
+            }
+            return num_levels;
+        }
+        // 每页最后一层的节点数量。
+        static constexpr size_t numBottomNodes() noexcept
+        {
+            size_t num_bottom_nodes = D;
+            for (size_t level = 1; level < numLevels(); level++) {
+                num_bottom_nodes *= D;
+            }
+            return num_bottom_nodes;
+        }
+        // 每页的节点数量。
+        static constexpr size_t numNodes() noexcept { return (numBottomNodes() * D - D) / (D - 1); }
+
+        static constexpr size_t NUM_NODES = numNodes();
+        static constexpr size_t NUM_BOTTOM_NODES = numBottomNodes();
+        // 每页中不在最后一层的节点数量。
+        static constexpr size_t NUM_INNER_NODES = NUM_NODES - NUM_BOTTOM_NODES;
+    };
+
+    // 以下的位置都不包含数组开头预留的D-1个位置，在数组中的下标为位置加D-1，页内的下标在[D, D+NUM_NODES)之间。
+    // 返回按照插入顺序排列的第idx个节点的位置，位置随idx单调递增。
+    template <size_t NODE_SIZE, size_t D>
+    static constexpr size_t nodePos(size_t idx) noexcept
+    {
+        using Shape = PageShape<NODE_SIZE, D>;
+        if (idx == 0) {
+            return 0;
+        }
+        return (idx - 1) / Shape::NUM_NODES * Shape::NUM_SLOTS + (idx - 1) % Shape::NUM_NODES + 1;
+    }
+    // 返回第pos个节点的第一个子节点的位置。
+    template <size_t NODE_SIZE, size_t D>
+    static constexpr size_t firstChildPos(size_t pos) noexcept
+    {
+        using Shape = PageShape<NODE_SIZE, D>;
+        size_t page_idx = (pos + D - 1) / Shape::NUM_SLOTS, local_idx = (pos + D - 1) % Shape::NUM_SLOTS;
+        if (local_idx < Shape::NUM_INNER_NODES + D) {
+            return page_idx * Shape::NUM_SLOTS + (local_idx + 2 - D) * D - (D - 1);
+        }
+        size_t child_page_idx = page_idx * Shape::NUM_BOTTOM_NODES + local_idx - Shape::NUM_INNER_NODES - D + 1;
+        return child_page_idx * Shape::NUM_SLOTS + 1;
+    }
+    // 返回第pos个节点（不为根节点）的父节点的位置。
+    template <size_t NODE_SIZE, size_t D>
+    static constexpr size_t parentPos(size_t pos) noexcept
+    {
+        using Shape = PageShape<NODE_SIZE, D>;
+        size_t page_idx = (pos + D - 1) / Shape::NUM_SLOTS, local_idx = (pos + D - 1) % Shape::NUM_SLOTS;
+        if (local_idx >= 2 * D || page_idx == 0) {
+            return page_idx * Shape::NUM_SLOTS + local_idx / D - 1;
+        }
+        size_t parent_page_idx = (page_idx - 1) / Shape::NUM_BOTTOM_NODES;
+        size_t bottom_idx = (page_idx - 1) % Shape::NUM_BOTTOM_NODES;
+        return parent_page_idx * Shape::NUM_SLOTS + Shape::NUM_INNER_NODES + bottom_idx + 1;
+    }
+};
+
+// 使用分配器Alloc（按需rebind为节点的类型）代替布局Layout默认的分配器，其余性质与Layout相同。
+template <typename Layout, typename Alloc>
+struct AllocatorLayout : Layout {
+    template <typename T>
+    using Allocator = typename std::allocator_traits<Alloc>::template rebind_alloc<T>;
+};
+
+// 容器使用分配器Alloc时存储节点的布局。Alloc为std::allocator时保留布局默认的分配器（如按缓存行对齐的分配器），
+// 否则节点数组使用rebind后的Alloc，此时CacheAlignedLayout只有在Alloc分配的内存按缓存行对齐时才能保证对齐。
+template <typename Layout, typename Alloc>
+using LayoutWithAllocator = std::conditional_t<
+    std::is_same_v<Alloc, std::allocator<typename std::allocator_traits<Alloc>::value_type>>, Layout,
+    AllocatorLayout<Layout, Alloc>>;
+
+// 返回容器使用分配器alloc时存储类型为T的节点所用的分配器，alloc为std::allocator时返回布局默认的分配器。
+template <typename T, typename Layout, typename Alloc>
+auto nodeAllocator(const Alloc& alloc)
+{
+    using NodeAlloc = typename LayoutWithAllocator<Layout, Alloc>::template Allocator<T>;
+    if constexpr (std::is_same_v<LayoutWithAllocator<Layout, Alloc>, Layout>) {
+        return NodeAlloc();
+    } else {
+        return NodeAlloc(alloc);
+    }
+}
+}
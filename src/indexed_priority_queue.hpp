@@ -0,0 +1,403 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#include "d_ary_heap.hpp"
+#include "heap_layout.hpp"
+#include "node_array.hpp"
+#include "priority_queue.hpp"
+
+namespace custom_cont {
+// 元素为0到capacity-1之间的整数（如图中顶点的编号）的优先队列，使用数组而非哈希表记录每个元素在堆中的位置，
+// 查找元素的时间复杂度为O(1)，插入元素时也不需要分配内存。元素本身即可作为句柄，因此接口除句柄外与PriQueue相同：
+// push不返回句柄，pushOrUpdate只返回是否为新插入的元素。T: 队列中的元素，必须为整数类型, TPri: 用于排序的
+// 元素优先级, D: 每个父节点最多可以有多少个子节点，为DYNAMIC_ARITY时由构造函数输入的d确定,
+// Compare: 用于比较两优先级大小的函数，以常量引用接收参数,
+// NodeArray: 节点的存储方式，默认将优先级连续存放，见node_array.hpp。
+template <typename T, typename TPri, int D = DYNAMIC_ARITY,
+    typename Compare = std::function<bool(const TPri&, const TPri&)>,
+    template <typename, typename, typename> class NodeArray = SoaNodeArray>
+class IndexedPriQueue {
+    static_assert(std::is_integral_v<T>, "Elements of IndexedPriQueue must be integers!!!");
+    static_assert(D == DYNAMIC_ARITY || D >= 2, "D must be lareger or equal to 2!!!");
+
+protected:
+    // 节点，包含有元素和优先级。
+    using Node = std::pair<T, TPri>;
+    // 对节点中元素和优先级的常量引用。
+    using NodeRef = std::pair<const T&, const TPri&>;
+    // 节点在堆中的位置。
+    using NodePos = uint32_t;
+    // 用于比较两节点大小的函数。
+    using CmpFunc = Compare;
+    // 存储节点的数组。
+    using Storage = NodeArray<T, TPri, ImplicitLayout>;
+    // 表示元素不在队列中的位置。
+    static constexpr NodePos ABSENT_POS = std::numeric_limits<NodePos>::max();
+
+    // 每个父节点最多可以有多少个子节点（不得小于2）。
+    int d_ { D == DYNAMIC_ARITY ? 2 : D };
+    // 优先队列的种类。
+    PriQueueTyp typ_ { PriQueueTyp::MIN_PRI_QUEUE };
+    // 用于比较两节点的函数。
+    CmpFunc cmp_func_;
+    // 优先队列中节点的个数。
+    size_t size_ { 0 };
+    // 存储于堆中的节点。
+    Storage nodes_;
+    // 每个元素在堆中的位置，不在队列中的元素对应ABSENT_POS。
+    std::vector<NodePos> element_to_pos_;
+
+public:
+    // 构造可以容纳元素0到capacity-1的空优先队列。
+    IndexedPriQueue(int d, PriQueueTyp typ, CmpFunc cmp_func, size_t capacity)
+        : d_(d)
+        , typ_(typ)
+        , cmp_func_(std::move(cmp_func))
+        , element_to_pos_(this->checkCapacity(capacity), ABSENT_POS)
+    {
+        this->checkArity();
+        nodes_.reserve(capacity);
+    }
+    // 使用队列中的元素elements和它们的优先级priorities来构造可以容纳元素0到capacity-1的优先队列。
+    IndexedPriQueue(int d, PriQueueTyp typ, CmpFunc cmp_func, size_t capacity,
+        const std::vector<T>& elements, const std::vector<TPri>& priorities)
+        : IndexedPriQueue(d, typ, std::move(cmp_func), capacity)
+    {
+        if (elements.size() != priorities.size()) {
+            throw std::invalid_argument("Number of elements must be equal to number of priorities!!!");
+        }
+        for (size_t i = 0; i < elements.size(); i++) {
+            auto& node_pos = element_to_pos_.at(this->checkElement(elements[i]));
+            if (node_pos != ABSENT_POS) {
+                throw std::logic_error("Element is in the queue!!!");
+            }
+            nodes_.emplaceBack(elements[i], priorities[i]);
+            node_pos = static_cast<NodePos>(i);
+        }
+        size_ = elements.size();
+        this->buildHeap();
+    }
+    IndexedPriQueue() = default;
+    virtual ~IndexedPriQueue() = default;
+    IndexedPriQueue(const IndexedPriQueue&) = default;
+    IndexedPriQueue(IndexedPriQueue&&) = default;
+    IndexedPriQueue& operator=(const IndexedPriQueue&) = default;
+    IndexedPriQueue& operator=(IndexedPriQueue&&) = default;
+
+    // 返回队列中存储的节点的数量。
+    size_t size() const noexcept { return size_; }
+    // 判断队列是否为空。
+    bool empty() const noexcept { return size_ == 0; }
+    // 返回队列可以容纳的元素的范围，即元素需小于该值。
+    size_t capacity() const noexcept { return element_to_pos_.size(); }
+    // 判断一个元素element是否在队列中，超出范围的元素均不在队列中。
+    bool contains(T element) const noexcept
+    {
+        return this->isInRange(element) && element_to_pos_[element] != ABSENT_POS;
+    }
+    // 将一个元素element和它的优先级pri插入队列中，默认会执行范围和重复性检测，时间复杂度：O(d*log_d(N))。
+    template <bool perform_chk = true, typename TPriFwd>
+    void push(T element, TPriFwd&& pri)
+    {
+        if (perform_chk) {
+            this->checkElement(element);
+            if (element_to_pos_[element] != ABSENT_POS) {
+                throw std::logic_error("Element is in the queue!!!");
+            }
+        }
+        // 节点添加成功后再记录位置，添加失败时元素仍然不在队列中。
+        nodes_.emplaceBack(element, std::forward<TPriFwd>(pri));
+        element_to_pos_[element] = static_cast<NodePos>(size_);
+        size_ += 1;
+        this->heapifyUp(size_ - 1);
+    }
+    // 元素element在队列中时将它的优先级更新为pri，否则将它插入队列中，返回它是否为新插入的元素，
+    // 时间复杂度：O(d*log_d(N))。
+    template <typename TPriFwd>
+    bool pushOrUpdate(T element, TPriFwd&& pri)
+    {
+        if (element_to_pos_[this->checkElement(element)] == ABSENT_POS) {
+            this->push<false>(element, std::forward<TPriFwd>(pri));
+            return true;
+        }
+        this->updatePriorityAt(element_to_pos_[element], std::forward<TPriFwd>(pri));
+        return false;
+    }
+    // 将元素element对应的优先级更新为pri，优先级可以向任意方向改变，时间复杂度：O(d*log_d(N))。
+    void updatePriority(T element, TPri pri)
+    {
+        if (!this->contains(element)) {
+            throw std::out_of_range("No such element is present!!!");
+        }
+        this->updatePriorityAt(element_to_pos_[element], std::move(pri));
+    }
+    // 从队列中移除元素element，时间复杂度：O(d*log_d(N))。
+    void erase(T element)
+    {
+        if (!this->contains(element)) {
+            throw std::out_of_range("No such element is present!!!");
+        }
+        size_t node_pos = element_to_pos_[element];
+        element_to_pos_[element] = ABSENT_POS;
+        Node last_node = nodes_.take(size_ - 1);
+        nodes_.popBack();
+        size_ -= 1;
+        if (node_pos == size_) {
+            return;
+        }
+        if (node_pos > 0 && cmp_func_(nodes_.priority(this->getParentNodePos(node_pos)), last_node.second)) {
+            this->heapifyUpWithHole(node_pos, std::move(last_node));
+        } else {
+            this->heapifyDownWithHole(node_pos, std::move(last_node));
+        }
+    }
+    // 返回元素element对应的优先级，默认会执行存在性检测。
+    template <bool perform_chk = true>
+    const TPri& getPriority(T element) const
+    {
+        if (perform_chk && !this->contains(element)) {
+            throw std::out_of_range("Unable to find the given node!!!");
+        }
+        return nodes_.priority(element_to_pos_[element]);
+    }
+    // 返回队列中的第一个元素。
+    const T& top() const
+    {
+        if (size_ == 0) {
+            throw std::out_of_range("The priority queue is empty!!!");
+        }
+        return nodes_.element(0);
+    }
+    // 返回队列中的第一个元素和它的优先级。
+    NodeRef topNode() const
+    {
+        if (size_ == 0) {
+            throw std::out_of_range("The priority queue is empty!!!");
+        }
+        return NodeRef(nodes_.element(0), nodes_.priority(0));
+    }
+    // 移除队列中的第一个元素。
+    void pop()
+    {
+        if (size_ == 0) {
+            throw std::out_of_range("The priority queue is empty!!!");
+        }
+        element_to_pos_[nodes_.element(0)] = ABSENT_POS;
+        this->removeTopNode();
+    }
+    // 移除队列中的第一个元素并返回它和它的优先级。
+    Node popAndReturn()
+    {
+        if (size_ == 0) {
+            throw std::out_of_range("The priority queue is empty!!!");
+        }
+        Node node_to_return = nodes_.take(0);
+        element_to_pos_[node_to_return.first] = ABSENT_POS;
+        this->removeTopNode();
+        return node_to_return;
+    }
+
+protected:
+    // 检查容量是否可以用位置的类型表示。
+    static size_t checkCapacity(size_t capacity)
+    {
+        if (capacity >= ABSENT_POS) {
+            throw std::invalid_argument("Capacity of IndexedPriQueue is too large!!!");
+        }
+        return capacity;
+    }
+    // 检查每个父节点最多可以有多少个子节点是否合法。
+    void checkArity() const
+    {
+        if (d_ < 2) {
+            throw std::invalid_argument("D must be lareger or equal to 2!!!");
+        }
+        if (D != DYNAMIC_ARITY && d_ != D) {
+            throw std::invalid_argument("d must be equal to the compile-time arity D!!!");
+        }
+    }
+    // 判断元素element是否在队列可以容纳的范围内。
+    bool isInRange(T element) const noexcept
+    {
+        if constexpr (std::is_signed_v<T>) {
+            if (element < 0) {
+                return false;
+            }
+        }
+        return static_cast<size_t>(element) < element_to_pos_.size();
+    }
+    // 检查元素element是否在队列可以容纳的范围内并返回它。
+    T checkElement(T element) const
+    {
+        if (!this->isInRange(element)) {
+            throw std::out_of_range("Element is out of the capacity of the queue!!!");
+        }
+        return element;
+    }
+    // 将堆中第node_pos个节点的优先级更新为pri，节点靠近堆顶时上浮，否则下沉。
+    template <typename TPriFwd>
+    void updatePriorityAt(size_t node_pos, TPriFwd&& pri)
+    {
+        bool moves_up = cmp_func_(nodes_.priority(node_pos), pri);
+        nodes_.priority(node_pos) = std::forward<TPriFwd>(pri);
+        if (moves_up) {
+            this->heapifyUp(node_pos);
+        } else {
+            this->heapifyDown(node_pos);
+        }
+    }
+    // 构建堆，时间复杂度O(n)。
+    void buildHeap()
+    {
+        if (size_ < 2) {
+            return;
+        }
+        for (NodePos pos_to_fix = this->getParentNodePos(size_ - 1) + 1; pos_to_fix > 0; --pos_to_fix) {
+            this->heapifyDown(pos_to_fix - 1);
+        }
+    }
+    // 返回每个父节点最多可以有多少个子节点，D在编译期确定时返回常量，使乘除法可以被优化为移位。
+    size_t arity() const noexcept
+    {
+        if constexpr (D == DYNAMIC_ARITY) {
+            return d_;
+        } else {
+            return D;
+        }
+    }
+    // 判断堆中第node_pos个节点是否为叶节点。
+    bool isLeafNode(size_t node_pos) const noexcept
+    {
+        return this->arity() * node_pos + 2 > size_;
+    }
+    // 返回堆中第parent_node_pos个节点的第child_ord个子节点的位置。
+    size_t getChildNodePos(size_t parent_node_pos, size_t child_ord) const noexcept
+    {
+        return this->arity() * parent_node_pos + child_ord + 1;
+    }
+    // 返回堆中第child_pos个节点所属的父节点的位置。
+    size_t getParentNodePos(size_t child_pos) const noexcept
+    {
+        return (child_pos - 1) / this->arity();
+    }
+    // 将第src_pos个节点移动到dst_pos位置，并更新它在数组中记录的位置。
+    void moveNode(size_t dst_pos, size_t src_pos) noexcept
+    {
+        nodes_.move(dst_pos, src_pos);
+        element_to_pos_[nodes_.element(dst_pos)] = static_cast<NodePos>(dst_pos);
+    }
+    // 将节点node写入node_pos位置，并更新它在数组中记录的位置。
+    void placeNode(size_t node_pos, Node&& node) noexcept
+    {
+        element_to_pos_[node.first] = static_cast<NodePos>(node_pos);
+        nodes_.put(node_pos, std::move(node));
+    }
+    // 返回第parent_node_pos个节点的子节点中最应该靠近堆顶的那个的位置，调用前需确保该节点不是叶节点。
+    size_t getBestChildNodePos(size_t parent_node_pos) const noexcept
+    {
+        size_t first_child_pos = this->getChildNodePos(parent_node_pos, 0);
+        if constexpr (Storage::CONTIGUOUS_PRIORITIES && simd::canSelectBestChild<TPri, D, Compare>()) {
+            if (first_child_pos + D <= size_) {
+                return first_child_pos + simd::selectBestChild<TPri, D, Compare>(&nodes_.priority(first_child_pos));
+            }
+        }
+        size_t last_child_pos = std::min(first_child_pos + this->arity(), size_);
+        size_t best_child_pos = first_child_pos;
+        for (size_t child_node_pos = first_child_pos + 1; child_node_pos < last_child_pos; ++child_node_pos) {
+            if (cmp_func_(nodes_.priority(best_child_pos), nodes_.priority(child_node_pos))) {
+                best_child_pos = child_node_pos;
+            }
+        }
+        return best_child_pos;
+    }
+    // 移除堆顶的节点并修复堆，堆顶节点中的数据此时可能已经被移走，调用前需确保队列不为空。
+    void removeTopNode()
+    {
+        Node last_node = nodes_.take(size_ - 1);
+        nodes_.popBack();
+        size_ -= 1;
+        if (size_ == 0) {
+            return;
+        }
+        this->heapifyDownWithHole(0, std::move(last_node));
+    }
+    // 在pos_to_fix位置添加一个节点后通过bubble down的方式修复堆，时间复杂度O(d*log_d(N))。
+    void heapifyDown(size_t pos_to_fix) noexcept
+    {
+        if (this->isLeafNode(pos_to_fix)) {
+            return;
+        }
+        this->heapifyDownWithHole(pos_to_fix, nodes_.take(pos_to_fix));
+    }
+    // 将hole_pos处视为空位，把node_to_fix沿空位下沉，最后将它写入其最终位置。
+    void heapifyDownWithHole(size_t hole_pos, Node node_to_fix) noexcept
+    {
+        while (!this->isLeafNode(hole_pos)) {
+            size_t best_child_pos = this->getBestChildNodePos(hole_pos);
+            if (!cmp_func_(node_to_fix.second, nodes_.priority(best_child_pos))) {
+                break;
+            }
+            this->moveNode(hole_pos, best_child_pos);
+            hole_pos = best_child_pos;
+        }
+        this->placeNode(hole_pos, std::move(node_to_fix));
+    }
+    // 在pos_to_fix位置添加一个节点后通过bubble up的方式修复堆，时间复杂度O(log_d(N))。
+    void heapifyUp(size_t pos_to_fix) noexcept
+    {
+        if (pos_to_fix == 0
+            || !cmp_func_(nodes_.priority(this->getParentNodePos(pos_to_fix)), nodes_.priority(pos_to_fix))) {
+            return;
+        }
+        this->heapifyUpWithHole(pos_to_fix, nodes_.take(pos_to_fix));
+    }
+    // 将hole_pos处视为空位，把node_to_fix沿空位上浮，最后将它写入其最终位置。
+    void heapifyUpWithHole(size_t hole_pos, Node node_to_fix) noexcept
+    {
+        while (hole_pos > 0) {
+            size_t parent_node_pos = this->getParentNodePos(hole_pos);
+            if (!cmp_func_(nodes_.priority(parent_node_pos), node_to_fix.second)) {
+                break;
+            }
+            this->moveNode(hole_pos, parent_node_pos);
+            hole_pos = parent_node_pos;
+        }
+        this->placeNode(hole_pos, std::move(node_to_fix));
+    }
+};
+
+// 构建可以容纳元素0到capacity-1的空的最小优先队列。
+template <typename T, typename TPri>
+auto createEmptyMinIndexedPriQueue(size_t capacity, int d = 2)
+{
+    return IndexedPriQueue<T, TPri>(d, PriQueueTyp::MIN_PRI_QUEUE, std::greater<> {}, capacity);
+}
+
+// 构建可以容纳元素0到capacity-1的空的最大优先队列。
+template <typename T, typename TPri>
+auto createEmptyMaxIndexedPriQueue(size_t capacity, int d = 2)
+{
+    return IndexedPriQueue<T, TPri>(d, PriQueueTyp::MAX_PRI_QUEUE, std::less<> {}, capacity);
+}
+
+// 构建可以容纳元素0到capacity-1的空的最小优先队列，每个父节点最多可以有D个子节点，D在编译期确定。
+template <typename T, typename TPri, int D>
+auto createEmptyMinIndexedPriQueue(size_t capacity)
+{
+    return IndexedPriQueue<T, TPri, D, std::greater<>>(D, PriQueueTyp::MIN_PRI_QUEUE, std::greater<> {}, capacity);
+}
+
+// 构建可以容纳元素0到capacity-1的空的最大优先队列，每个父节点最多可以有D个子节点，D在编译期确定。
+template <typename T, typename TPri, int D>
+auto createEmptyMaxIndexedPriQueue(size_t capacity)
+{
+    return IndexedPriQueue<T, TPri, D, std::less<>>(D, PriQueueTyp::MAX_PRI_QUEUE, std::less<> {}, capacity);
+}
+}
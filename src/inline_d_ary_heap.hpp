@@ -0,0 +1,210 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "d_ary_heap.hpp"
+
+namespace custom_cont {
+// 对象内的缓冲区，大小为BYTES字节，按ALIGNMENT字节对齐，同一时刻最多被一个数组占用。
+template <size_t BYTES, size_t ALIGNMENT>
+struct InlineBuffer {
+    alignas(ALIGNMENT) std::byte bytes_[BYTES];
+    // 缓冲区是否正在被使用。
+    bool in_use_ { false };
+};
+
+// 优先从对象内的缓冲区分配内存的分配器。缓冲区空闲且放得下请求的节点时使用缓冲区，否则使用operator new。
+// 复制构造容器时返回不使用缓冲区的分配器，避免两个容器共用同一个缓冲区。
+template <typename T, size_t BYTES, size_t ALIGNMENT>
+class InlineBufferAllocator {
+    template <typename U, size_t OTHER_BYTES, size_t OTHER_ALIGNMENT>
+    friend class InlineBufferAllocator;
+
+    // 使用的缓冲区，为nullptr时总是使用operator new。
+    InlineBuffer<BYTES, ALIGNMENT>* buffer_ { nullptr };
+
+public:
+    using value_type = T;
+    template <typename U>
+    struct rebind {
+        using other = InlineBufferAllocator<U, BYTES, ALIGNMENT>;
+    };
+
+    InlineBufferAllocator() noexcept = default;
+    explicit InlineBufferAllocator(InlineBuffer<BYTES, ALIGNMENT>* buffer) noexcept
+        : buffer_(buffer)
+    {
+    }
+    template <typename U>
+    InlineBufferAllocator(const InlineBufferAllocator<U, BYTES, ALIGNMENT>& other) noexcept
+        : buffer_(other.buffer_)
+    {
+    }
+
+    T* allocate(size_t num)
+    {
+        if (buffer_ != nullptr && !buffer_->in_use_ && num * sizeof(T) <= BYTES && alignof(T) <= ALIGNMENT) {
+            buffer_->in_use_ = true;
+            return reinterpret_cast<T*>(buffer_->bytes_);
+        }
+        return static_cast<T*>(::operator new(num * sizeof(T)));
+    }
+    void deallocate(T* ptr, size_t) noexcept
+    {
+        if (buffer_ != nullptr && reinterpret_cast<std::byte*>(ptr) == buffer_->bytes_) {
+            buffer_->in_use_ = false;
+        } else {
+            ::operator delete(ptr);
+        }
+    }
+    InlineBufferAllocator select_on_container_copy_construction() const noexcept { return InlineBufferAllocator(); }
+    // 判断节点是否存储于缓冲区中。
+    bool owns(const T* ptr) const noexcept
+    {
+        return buffer_ != nullptr && reinterpret_cast<const std::byte*>(ptr) == buffer_->bytes_;
+    }
+    template <typename U>
+    bool operator==(const InlineBufferAllocator<U, BYTES, ALIGNMENT>& other) const noexcept
+    {
+        return buffer_ == other.buffer_;
+    }
+    template <typename U>
+    bool operator!=(const InlineBufferAllocator<U, BYTES, ALIGNMENT>& other) const noexcept
+    {
+        return buffer_ != other.buffer_;
+    }
+};
+
+// 前N个节点存储于对象内缓冲区的D叉堆，适用于节点数量通常很少的短暂的堆。节点数量超过N时节点数组按照
+// std::vector的规则扩容并转移到堆内存中，此后缓冲区闲置，直到堆被销毁。接口与DAryHeap相同，
+// T: 堆中的节点, N: 对象内最多可以存放的节点数量, D和Compare的含义与DAryHeap相同。
+// 对象内的缓冲区不能随堆一起转移，移动构造和移动赋值会逐个移动节点，所需的时间与节点数量成正比。
+// 以非公有方式继承DAryHeap并重新导出它的接口，以禁止将堆复制或移动到DAryHeap中：移动得到的DAryHeap会
+// 继续使用本对象的缓冲区，本对象销毁后访问的是已经释放的内存。
+template <typename T, size_t N, int D = DYNAMIC_ARITY, typename Compare = std::function<bool(const T&, const T&)>>
+class InlineDAryHeap : private InlineBuffer<N * sizeof(T), alignof(T)>,
+                       protected DAryHeap<T, D, Compare, ImplicitLayout,
+                           InlineBufferAllocator<T, N * sizeof(T), alignof(T)>> {
+    static_assert(N > 0, "N must be larger than 0!!!");
+
+protected:
+    // 对象内的缓冲区。
+    using Buffer = InlineBuffer<N * sizeof(T), alignof(T)>;
+    // 使用缓冲区的分配器。
+    using BufferAllocator = InlineBufferAllocator<T, N * sizeof(T), alignof(T)>;
+    // 存储节点的D叉堆。
+    using Heap = DAryHeap<T, D, Compare, ImplicitLayout, BufferAllocator>;
+    using typename Heap::CmpFunc;
+
+public:
+    // 构造空的堆。
+    InlineDAryHeap(int d, CmpFunc cmp_func)
+        : Buffer()
+        , Heap(d, std::move(cmp_func), std::vector<T>(), BufferAllocator(static_cast<Buffer*>(this)))
+    {
+        this->nodes_.reserve(N);
+    }
+    // 使用堆中的节点nodes来构造堆，节点数量不超过N时它们存储于对象内的缓冲区中。
+    template <typename Nodes>
+    InlineDAryHeap(int d, CmpFunc cmp_func, Nodes&& nodes)
+        : InlineDAryHeap(d, std::move(cmp_func))
+    {
+        this->nodes_.reserve(std::max(N, nodes.size()));
+        if constexpr (std::is_rvalue_reference_v<Nodes&&>) {
+            this->pushRange(std::make_move_iterator(nodes.begin()), std::make_move_iterator(nodes.end()));
+        } else {
+            this->pushRange(nodes.begin(), nodes.end());
+        }
+    }
+    InlineDAryHeap(const InlineDAryHeap& other)
+        : InlineDAryHeap(other.d_, other.cmp_func_)
+    {
+        this->nodes_ = other.nodes_;
+        this->size_ = other.size_;
+        this->pop_strategy_ = other.pop_strategy_;
+    }
+    InlineDAryHeap(InlineDAryHeap&& other)
+        : InlineDAryHeap(other.d_, other.cmp_func_)
+    {
+        this->nodes_ = std::move(other.nodes_);
+        this->size_ = other.size_;
+        this->pop_strategy_ = other.pop_strategy_;
+        other.nodes_.clear();
+        other.size_ = 0;
+    }
+    InlineDAryHeap& operator=(const InlineDAryHeap& other)
+    {
+        Heap::operator=(other);
+        return *this;
+    }
+    InlineDAryHeap& operator=(InlineDAryHeap&& other)
+    {
+        if (this != &other) {
+            this->d_ = other.d_;
+            this->cmp_func_ = std::move(other.cmp_func_);
+            this->nodes_ = std::move(other.nodes_);
+            this->size_ = other.size_;
+            this->pop_strategy_ = other.pop_strategy_;
+            other.nodes_.clear();
+            other.size_ = 0;
+        }
+        return *this;
+    }
+    ~InlineDAryHeap() override = default;
+
+    using Heap::drainSorted;
+    using Heap::empty;
+    using Heap::emplace;
+    using Heap::eraseIf;
+    using Heap::pop;
+    using Heap::popAndReturn;
+    using Heap::popN;
+    using Heap::popStrategy;
+    using Heap::push;
+    using Heap::pushRange;
+    using Heap::reserve;
+    using Heap::setPopStrategy;
+    using Heap::size;
+    using Heap::top;
+    using Heap::topK;
+    // 返回对象内最多可以存放的节点数量。
+    static constexpr size_t inlineCapacity() noexcept { return N; }
+    // 判断节点是否仍然存储于对象内的缓冲区中。
+    bool isInline() const noexcept { return this->nodes_.get_allocator().owns(this->nodes_.data()); }
+};
+
+// 构建空的最小堆，前N个节点存储于对象内的缓冲区中。
+template <typename T, size_t N>
+auto createEmptyMinInlineDHeap(int d = 2)
+{
+    return InlineDAryHeap<T, N>(d, std::greater<T>());
+}
+
+// 构建空的最大堆，前N个节点存储于对象内的缓冲区中。
+template <typename T, size_t N>
+auto createEmptyMaxInlineDHeap(int d = 2)
+{
+    return InlineDAryHeap<T, N>(d, std::less<T>());
+}
+
+// 构建空的最小堆，前N个节点存储于对象内的缓冲区中，每个父节点最多可以有D个子节点，D在编译期确定。
+template <typename T, size_t N, int D>
+auto createEmptyMinInlineDHeap()
+{
+    return InlineDAryHeap<T, N, D, std::greater<T>>(D, std::greater<T>());
+}
+
+// 构建空的最大堆，前N个节点存储于对象内的缓冲区中，每个父节点最多可以有D个子节点，D在编译期确定。
+template <typename T, size_t N, int D>
+auto createEmptyMaxInlineDHeap()
+{
+    return InlineDAryHeap<T, N, D, std::less<T>>(D, std::less<T>());
+}
+}
@@ -0,0 +1,287 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "d_ary_heap.hpp"
+#include "element_index.hpp"
+#include "priority_queue.hpp"
+
+namespace custom_cont {
+// 采用延迟删除的优先队列，接口除句柄外与PriQueue相同：push不返回句柄，pushOrUpdate只返回是否为新插入的元素。
+// 更新优先级或移除元素时不在堆中定位并移动旧的节点，而是使旧的节点失效并插入新的节点，失效的节点到达堆顶时才被丢弃，因此堆中的节点移动时不需要更新任何索引。失效的节点过多时
+// 会一次性将它们从堆中清除。适用于频繁降低优先级的场景（如Dijkstra算法），代价是堆中会暂时存在多余的节点。
+// T: 队列中的元素, TPri: 用于排序的元素优先级, THash: 用于求解元素哈希值的函数,
+// D: 每个父节点最多可以有多少个子节点，为DYNAMIC_ARITY时由构造函数输入的d确定,
+// Compare: 用于比较两优先级大小的函数，以常量引用接收参数。
+template <typename T, typename TPri, typename THash = std::hash<T>, int D = DYNAMIC_ARITY,
+    typename Compare = std::function<bool(const TPri&, const TPri&)>>
+class LazyPriQueue {
+protected:
+    // 节点，包含有元素的基本信息和优先级。
+    using Node = std::pair<T, TPri>;
+    // 对节点中元素和优先级的常量引用。
+    using NodeRef = std::pair<const T&, const TPri&>;
+    // 用于比较两节点大小的函数。
+    using CmpFunc = Compare;
+    // 存储队列中的元素。
+    using Index = ElementIndex<T, THash>;
+    // 元素所在槽位的编号。
+    using SlotId = typename Index::SlotId;
+    // 堆中的节点，只保存槽位的编号而不保存元素，版本号与槽位当前的版本号不同时节点失效。
+    struct Entry {
+        TPri pri_;
+        SlotId slot_id_;
+        uint32_t version_;
+    };
+    // 比较两个堆中节点的优先级。
+    struct EntryCmpFunc {
+        CmpFunc cmp_func_;
+        bool operator()(const Entry& entry_i, const Entry& entry_j) const
+        {
+            return cmp_func_(entry_i.pri_, entry_j.pri_);
+        }
+    };
+    // 每个槽位中元素当前的优先级和槽位的版本号，元素的优先级改变或者元素离开队列时版本号增加。
+    struct SlotState {
+        TPri pri_;
+        uint32_t version_;
+    };
+    // 失效的节点数量超过有效节点数量和该值中的较大者时清除所有失效的节点。
+    static constexpr size_t MIN_STALE_ENTRIES_TO_COMPACT = 64;
+
+    // 优先队列的种类。
+    PriQueueTyp typ_ { PriQueueTyp::MIN_PRI_QUEUE };
+    // 存储队列中的元素，每个元素只存储一次。
+    Index index_;
+    // 第i个槽位的状态，下标与槽位编号相同。
+    std::vector<SlotState> slot_states_;
+    // 存储有效和失效节点的堆，堆顶的节点总是有效的。
+    DAryHeap<Entry, D, EntryCmpFunc> entries_;
+
+public:
+    // 使用队列中的元素elements和它们的优先级priorities来构造优先队列。
+    LazyPriQueue(int d, PriQueueTyp typ, CmpFunc cmp_func,
+        const std::vector<T>& elements, const std::vector<TPri>& priorities)
+        : typ_(typ)
+        , entries_(d, EntryCmpFunc { std::move(cmp_func) }, std::vector<Entry>())
+    {
+        if (elements.size() != priorities.size()) {
+            throw std::invalid_argument("Number of elements must be equal to number of priorities!!!");
+        }
+        this->reserve(elements.size());
+        std::vector<Entry> entries;
+        entries.reserve(elements.size());
+        for (size_t i = 0; i < elements.size(); i++) {
+            auto [slot_id, inserted] = index_.insert(elements[i]);
+            if (!inserted) {
+                throw std::logic_error("Element is in the queue!!!");
+            }
+            entries.push_back(Entry { priorities[i], slot_id, this->assignSlot(slot_id, priorities[i]) });
+        }
+        entries_.pushRange(std::make_move_iterator(entries.begin()), std::make_move_iterator(entries.end()));
+    }
+    LazyPriQueue() = default;
+    virtual ~LazyPriQueue() = default;
+    LazyPriQueue(const LazyPriQueue&) = default;
+    LazyPriQueue(LazyPriQueue&&) = default;
+    LazyPriQueue& operator=(const LazyPriQueue&) = default;
+    LazyPriQueue& operator=(LazyPriQueue&&) = default;
+
+    // 返回队列中存储的元素的数量。
+    size_t size() const noexcept { return index_.size(); }
+    // 判断队列是否为空。
+    bool empty() const noexcept { return index_.size() == 0; }
+    // 返回堆中节点的数量，包括尚未被清除的失效节点。
+    size_t numEntries() const noexcept { return entries_.size(); }
+    // 判断一个元素element是否在队列中。
+    bool contains(const T& element) const
+    {
+        return index_.find(element) != Index::NO_SLOT;
+    }
+    // 预留可以容纳num_elements个元素的空间。
+    void reserve(size_t num_elements)
+    {
+        index_.reserve(num_elements);
+        slot_states_.reserve(num_elements);
+    }
+    // 将一个元素element和它的优先级pri插入队列中，默认会执行重复性检测，时间复杂度：O(d*log_d(N))。
+    template <bool perform_chk = true, typename TFwd>
+    void push(TFwd&& element, TPri pri)
+    {
+        auto [slot_id, inserted] = index_.template insert<perform_chk>(std::forward<TFwd>(element));
+        if (!inserted) {
+            throw std::logic_error("Element is in the queue!!!");
+        }
+        uint32_t version = this->assignSlot(slot_id, pri);
+        entries_.push(Entry { std::move(pri), slot_id, version });
+    }
+    // 元素element在队列中时将它的优先级更新为pri，否则将它插入队列中，返回它是否为新插入的元素，
+    // 时间复杂度：O(d*log_d(N))。
+    template <typename TFwd>
+    bool pushOrUpdate(TFwd&& element, TPri pri)
+    {
+        auto [slot_id, inserted] = index_.insert(std::forward<TFwd>(element));
+        if (inserted) {
+            uint32_t version = this->assignSlot(slot_id, pri);
+            entries_.push(Entry { std::move(pri), slot_id, version });
+        } else {
+            this->updatePriorityAt(slot_id, std::move(pri));
+        }
+        return inserted;
+    }
+    // 将元素element对应的优先级更新为pri，优先级可以向任意方向改变，时间复杂度：O(d*log_d(N))。
+    void updatePriority(const T& element, TPri pri)
+    {
+        this->updatePriorityAt(this->slotOf(element), std::move(pri));
+    }
+    // 从队列中移除元素element，它在堆中的节点随之失效，时间复杂度：均摊O(d*log_d(N))。
+    void erase(const T& element)
+    {
+        SlotId slot_id = this->slotOf(element);
+        slot_states_[slot_id].version_ += 1;
+        index_.erase(slot_id);
+        this->discardStaleEntries();
+    }
+    // 返回元素element对应的优先级，默认会执行存在性检测。
+    template <bool perform_chk = true>
+    const TPri& getPriority(const T& element) const
+    {
+        SlotId slot_id = index_.find(element);
+        if (perform_chk && slot_id == Index::NO_SLOT) {
+            throw std::out_of_range("Unable to find the given node!!!");
+        }
+        return slot_states_[slot_id].pri_;
+    }
+    // 返回队列中的第一个元素。
+    const T& top() const
+    {
+        if (this->empty()) {
+            throw std::out_of_range("The priority queue is empty!!!");
+        }
+        return index_.element(entries_.top().slot_id_);
+    }
+    // 返回队列中的第一个元素和它的优先级。
+    NodeRef topNode() const
+    {
+        if (this->empty()) {
+            throw std::out_of_range("The priority queue is empty!!!");
+        }
+        const Entry& top_entry = entries_.top();
+        return NodeRef(index_.element(top_entry.slot_id_), top_entry.pri_);
+    }
+    // 移除队列中的第一个元素，时间复杂度：均摊O(d*log_d(N))。
+    void pop()
+    {
+        if (this->empty()) {
+            throw std::out_of_range("The priority queue is empty!!!");
+        }
+        SlotId slot_id = entries_.top().slot_id_;
+        entries_.pop();
+        slot_states_[slot_id].version_ += 1;
+        index_.erase(slot_id);
+        this->discardStaleEntries();
+    }
+    // 移除队列中的第一个元素并返回它和它的优先级，时间复杂度：均摊O(d*log_d(N))。
+    Node popAndReturn()
+    {
+        if (this->empty()) {
+            throw std::out_of_range("The priority queue is empty!!!");
+        }
+        Entry top_entry = entries_.popAndReturn();
+        slot_states_[top_entry.slot_id_].version_ += 1;
+        Node node_to_return(index_.extract(top_entry.slot_id_), std::move(top_entry.pri_));
+        this->discardStaleEntries();
+        return node_to_return;
+    }
+    // 返回移除堆顶节点时所使用的修复策略。
+    PopStrategy popStrategy() const noexcept { return entries_.popStrategy(); }
+    // 设置移除堆顶节点时所使用的修复策略。
+    void setPopStrategy(PopStrategy pop_strategy) noexcept { entries_.setPopStrategy(pop_strategy); }
+
+protected:
+    // 返回元素element所在槽位的编号。
+    SlotId slotOf(const T& element) const
+    {
+        SlotId slot_id = index_.find(element);
+        if (slot_id == Index::NO_SLOT) {
+            throw std::out_of_range("No such element is present!!!");
+        }
+        return slot_id;
+    }
+    // 记录新存入第slot_id个槽位的元素的优先级pri，返回槽位当前的版本号。槽位被复用时版本号继续增加，
+    // 因此之前的元素遗留在堆中的节点仍然是失效的。
+    uint32_t assignSlot(SlotId slot_id, const TPri& pri)
+    {
+        if (slot_id == slot_states_.size()) {
+            slot_states_.push_back(SlotState { pri, 0 });
+        } else {
+            slot_states_[slot_id].pri_ = pri;
+        }
+        return slot_states_[slot_id].version_;
+    }
+    // 将第slot_id个槽位中元素的优先级更新为pri，使旧的节点失效并插入新的节点。
+    void updatePriorityAt(SlotId slot_id, TPri pri)
+    {
+        SlotState& slot_state = slot_states_[slot_id];
+        slot_state.pri_ = pri;
+        slot_state.version_ += 1;
+        entries_.push(Entry { std::move(pri), slot_id, slot_state.version_ });
+        this->discardStaleEntries();
+    }
+    // 判断堆中的节点entry是否已经失效。
+    bool isStale(const Entry& entry) const noexcept
+    {
+        return slot_states_[entry.slot_id_].version_ != entry.version_;
+    }
+    // 丢弃位于堆顶的失效节点，使堆顶的节点总是有效的。失效的节点过多时一次性清除所有失效的节点，
+    // 每次清除前至少有N个节点失效，因此均摊到每次操作的时间复杂度为O(1)。
+    void discardStaleEntries()
+    {
+        size_t num_stale_entries = entries_.size() - index_.size();
+        if (num_stale_entries > std::max(index_.size(), MIN_STALE_ENTRIES_TO_COMPACT)) {
+            entries_.eraseIf([this](const Entry& entry) { return this->isStale(entry); });
+            return;
+        }
+        while (!entries_.empty() && this->isStale(entries_.top())) {
+            entries_.pop();
+        }
+    }
+};
+
+// 构建空的采用延迟删除的最小优先队列。
+template <typename T, typename TPri, typename THash = std::hash<T>>
+auto createEmptyMinLazyPriQueue(int d = 2)
+{
+    return LazyPriQueue<T, TPri, THash>(d, PriQueueTyp::MIN_PRI_QUEUE, std::greater<> {},
+        std::vector<T>(), std::vector<TPri>());
+}
+
+// 构建空的采用延迟删除的最大优先队列。
+template <typename T, typename TPri, typename THash = std::hash<T>>
+auto createEmptyMaxLazyPriQueue(int d = 2)
+{
+    return LazyPriQueue<T, TPri, THash>(d, PriQueueTyp::MAX_PRI_QUEUE, std::less<> {},
+        std::vector<T>(), std::vector<TPri>());
+}
+
+// 构建空的采用延迟删除的最小优先队列，每个父节点最多可以有D个子节点，D在编译期确定。
+template <typename T, typename TPri, int D, typename THash = std::hash<T>>
+auto createEmptyMinLazyPriQueue()
+{
+    return LazyPriQueue<T, TPri, THash, D, std::greater<>>(D, PriQueueTyp::MIN_PRI_QUEUE, std::greater<> {},
+        std::vector<T>(), std::vector<TPri>());
+}
+
+// 构建空的采用延迟删除的最大优先队列，每个父节点最多可以有D个子节点，D在编译期确定。
+template <typename T, typename TPri, int D, typename THash = std::hash<T>>
+auto createEmptyMaxLazyPriQueue()
+{
+    return LazyPriQueue<T, TPri, THash, D, std::less<>>(D, PriQueueTyp::MAX_PRI_QUEUE, std::less<> {},
+        std::vector<T>(), std::vector<TPri>());
+}
+}
@@ -0,0 +1,136 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace custom_cont {
+// 以结构体数组(AoS)的形式存储优先队列中的节点，每个元素和它的优先级相邻存放。T: 元素, TPri: 优先级,
+// Layout: 节点在数组中的布局，见heap_layout.hpp。
+template <typename T, typename TPri, typename Layout>
+class AosNodeArray {
+public:
+    // 节点，包含有元素的基本信息和优先级。
+    using Node = std::pair<T, TPri>;
+    // 所有节点的优先级是否连续存放。
+    static constexpr bool CONTIGUOUS_PRIORITIES = false;
+
+    AosNodeArray() = default;
+    // 使用分配器alloc（rebind为节点的类型）存储节点。
+    template <typename Alloc>
+    explicit AosNodeArray(const Alloc& alloc)
+        : nodes_(alloc)
+    {
+    }
+
+    // 返回数组中节点的数量（包含布局预留的空位）。
+    size_t size() const noexcept { return nodes_.size(); }
+    // 返回不扩容时数组最多可以容纳的节点数量。
+    size_t capacity() const noexcept { return nodes_.capacity(); }
+    void reserve(size_t num_nodes) { nodes_.reserve(num_nodes); }
+    // 调整数组的大小，新增的节点均为默认构造，仅用于预留空位。
+    void resize(size_t num_nodes) { nodes_.resize(num_nodes); }
+    // 返回第node_idx个节点中的元素。
+    T& element(size_t node_idx) noexcept { return nodes_[node_idx].first; }
+    const T& element(size_t node_idx) const noexcept { return nodes_[node_idx].first; }
+    // 返回第node_idx个节点中的优先级。
+    TPri& priority(size_t node_idx) noexcept { return nodes_[node_idx].second; }
+    const TPri& priority(size_t node_idx) const noexcept { return nodes_[node_idx].second; }
+    // 使用参数args在数组末尾原地构造一个节点。
+    template <typename... Args>
+    void emplaceBack(Args&&... args)
+    {
+        nodes_.emplace_back(std::forward<Args>(args)...);
+    }
+    // 移除数组末尾的节点。
+    void popBack() { nodes_.pop_back(); }
+    // 将第node_idx个节点移出。
+    Node take(size_t node_idx) noexcept { return std::move(nodes_[node_idx]); }
+    // 将节点node写入第node_idx个位置。
+    void put(size_t node_idx, Node&& node) noexcept { nodes_[node_idx] = std::move(node); }
+    // 将第src_idx个节点移动到第dst_idx个位置。
+    void move(size_t dst_idx, size_t src_idx) noexcept { nodes_[dst_idx] = std::move(nodes_[src_idx]); }
+
+private:
+    std::vector<Node, typename Layout::template Allocator<Node>> nodes_;
+};
+
+// 以数组结构体(SoA)的形式存储优先队列中的节点，所有的优先级连续存放在一个数组中，元素存放在另一个数组中。
+// 下沉时只需要读取紧凑的优先级数组，每个缓存行可以容纳更多的优先级，对于算术类型的优先级还可以使用向量指令比较。
+// 布局需要预留空位时要求T和TPri都可以被默认构造。
+template <typename T, typename TPri, typename Layout>
+class SoaNodeArray {
+public:
+    using Node = std::pair<T, TPri>;
+    static constexpr bool CONTIGUOUS_PRIORITIES = true;
+
+    SoaNodeArray() = default;
+    template <typename Alloc>
+    explicit SoaNodeArray(const Alloc& alloc)
+        : elements_(alloc)
+        , priorities_(alloc)
+    {
+    }
+
+    size_t size() const noexcept { return priorities_.size(); }
+    size_t capacity() const noexcept { return std::min(elements_.capacity(), priorities_.capacity()); }
+    void reserve(size_t num_nodes)
+    {
+        elements_.reserve(num_nodes);
+        priorities_.reserve(num_nodes);
+    }
+    void resize(size_t num_nodes)
+    {
+        elements_.resize(num_nodes);
+        priorities_.resize(num_nodes);
+    }
+    T& element(size_t node_idx) noexcept { return elements_[node_idx]; }
+    const T& element(size_t node_idx) const noexcept { return elements_[node_idx]; }
+    TPri& priority(size_t node_idx) noexcept { return priorities_[node_idx]; }
+    const TPri& priority(size_t node_idx) const noexcept { return priorities_[node_idx]; }
+    // 在数组末尾添加元素element和它的优先级pri。
+    template <typename TFwd, typename TPriFwd>
+    void emplaceBack(TFwd&& element, TPriFwd&& pri)
+    {
+        elements_.emplace_back(std::forward<TFwd>(element));
+        try {
+            priorities_.emplace_back(std::forward<TPriFwd>(pri));
+        } catch (...) {
+            // 保持两个数组的长度一致。
+            elements_.pop_back();
+            throw;
+        }
+    }
+    // 使用参数args构造一个节点，再将其拆分后添加到数组末尾。
+    template <typename... Args>
+    void emplaceBack(Args&&... args)
+    {
+        Node node(std::forward<Args>(args)...);
+        this->emplaceBack(std::move(node.first), std::move(node.second));
+    }
+    void popBack()
+    {
+        elements_.pop_back();
+        priorities_.pop_back();
+    }
+    Node take(size_t node_idx) noexcept
+    {
+        return Node(std::move(elements_[node_idx]), std::move(priorities_[node_idx]));
+    }
+    void put(size_t node_idx, Node&& node) noexcept
+    {
+        elements_[node_idx] = std::move(node.first);
+        priorities_[node_idx] = std::move(node.second);
+    }
+    void move(size_t dst_idx, size_t src_idx) noexcept
+    {
+        elements_[dst_idx] = std::move(elements_[src_idx]);
+        priorities_[dst_idx] = std::move(priorities_[src_idx]);
+    }
+
+private:
+    std::vector<T, typename Layout::template Allocator<T>> elements_;
+    std::vector<TPri, typename Layout::template Allocator<TPri>> priorities_;
+};
+}
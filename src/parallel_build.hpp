@@ -0,0 +1,105 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace custom_cont {
+// 节点数量少于该值时并行建堆的收益不足以抵消创建线程的开销，直接在当前线程中建堆。
+constexpr size_t MIN_NODES_TO_BUILD_IN_PARALLEL = 1 << 14;
+// 并行执行时每个线程平均分到的任务块数量，块数多于线程数可以缓解各块工作量不均的问题。
+constexpr size_t CHUNKS_PER_THREAD = 4;
+
+// 使用num_threads个线程（包括当前线程）处理[0, num_items)中的所有编号。编号被划分为若干连续的块，各线程依次
+// 领取未处理的块并调用func(lo, hi)处理[lo, hi)。所有线程结束后重新抛出其中第一个异常。
+template <typename Func>
+void parallelFor(size_t num_items, size_t num_threads, const Func& func)
+{
+    num_threads = std::min(num_threads, num_items);
+    if (num_threads <= 1) {
+        if (num_items > 0) {
+            func(size_t(0), num_items);
+        }
+        return;
+    }
+    size_t chunk_size = (num_items + num_threads * CHUNKS_PER_THREAD - 1) / (num_threads * CHUNKS_PER_THREAD);
+    std::atomic<size_t> next_item { 0 };
+    std::mutex error_mutex;
+    std::exception_ptr first_error;
+    auto run = [&]() {
+        try {
+            for (size_t lo = next_item.fetch_add(chunk_size); lo < num_items; lo = next_item.fetch_add(chunk_size)) {
+                func(lo, std::min(lo + chunk_size, num_items));
+            }
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(error_mutex);
+            if (!first_error) {
+                first_error = std::current_exception();
+            }
+            next_item.store(num_items);
+        }
+    };
+    std::vector<std::thread> threads;
+    threads.reserve(num_threads - 1);
+    for (size_t i = 1; i < num_threads; i++) {
+        threads.emplace_back(run);
+    }
+    run();
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    if (first_error) {
+        std::rethrow_exception(first_error);
+    }
+}
+
+// 使用Floyd算法将包含size个节点、每个父节点最多有d个子节点的数组调整为堆，heapify_down(pos)用于下沉第pos个
+// 节点。num_threads大于1且节点足够多时，选取一个节点数不少于线程数若干倍的分割层，以该层节点为根的子树互不
+// 相交，按照层序排列时一段连续的根的后代在每一层也是连续的一段，因此可以由不同线程自底向上分别处理，最后在当前
+// 线程中处理分割层以上的节点。heapify_down必须只访问被下沉节点所在的子树。
+template <typename HeapifyDown>
+void floydBuildHeap(size_t size, size_t d, size_t num_threads, const HeapifyDown& heapify_down)
+{
+    if (size < 2) {
+        return;
+    }
+    // 最后一个父节点之后的节点均为叶节点，不需要下沉。
+    size_t num_parents = (size - 2) / d + 1;
+    size_t split_lo = 0, split_hi = 1;
+    if (num_threads > 1 && size >= MIN_NODES_TO_BUILD_IN_PARALLEL) {
+        while (split_hi - split_lo < num_threads * CHUNKS_PER_THREAD && split_hi < num_parents) {
+            split_lo = split_hi;
+            split_hi = split_hi * d + 1;
+        }
+    }
+    if (split_lo == 0) {
+        split_lo = num_parents;
+    } else {
+        parallelFor(std::min(split_hi, num_parents) - split_lo, num_threads, [&](size_t lo, size_t hi) {
+            // 先找到这些根在最深一层父节点中的后代，再逐层向上处理。
+            size_t root_pos = split_lo + lo, lo_pos = root_pos, hi_pos = split_lo + hi;
+            while (lo_pos * d + 1 < num_parents) {
+                lo_pos = lo_pos * d + 1;
+                hi_pos = hi_pos * d + 1;
+            }
+            while (true) {
+                for (size_t pos_to_fix = std::min(hi_pos, num_parents); pos_to_fix > lo_pos; --pos_to_fix) {
+                    heapify_down(pos_to_fix - 1);
+                }
+                if (lo_pos == root_pos) {
+                    break;
+                }
+                lo_pos = (lo_pos - 1) / d;
+                hi_pos = (hi_pos - 1) / d;
+            }
+        });
+    }
+    for (size_t pos_to_fix = split_lo; pos_to_fix > 0; --pos_to_fix) {
+        heapify_down(pos_to_fix - 1);
+    }
+}
+}
@@ -1,108 +1,259 @@
 #pragma once
 
+#include <algorithm>
 #include <functional>
+#include <iterator>
+#include <memory>
+#include <memory_resource>
 #include <stdexcept>
-#include <unordered_map>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
+#include "d_ary_heap.hpp"
+#include "element_index.hpp"
+#include "heap_layout.hpp"
+#include "node_array.hpp"
+
 namespace custom_cont {
 enum class PriQueueTyp {
     MIN_PRI_QUEUE,
     MAX_PRI_QUEUE
 };
 
-// 基于D叉堆的优先队列。T: 队列中的元素, TPri: 用于排序的元素优先级, THash: 用于求解元素哈希值的函数。
-template <typename T, typename TPri, typename THash = std::hash<T>>
+// 基于D叉堆的优先队列。T: 队列中的元素, TPri: 用于排序的元素优先级, THash: 用于求解元素哈希值的函数,
+// D: 每个父节点最多可以有多少个子节点，为DYNAMIC_ARITY时由构造函数输入的d确定,
+// Compare: 用于比较两优先级大小的函数，以常量引用接收参数, Layout: 节点在数组中的布局，必须按照层序排列，
+// 见heap_layout.hpp, NodeArray: 节点的存储方式，AosNodeArray或SoaNodeArray，见node_array.hpp,
+// Allocator: 索引和节点数组使用的分配器（rebind为相应的类型），为std::allocator时节点数组使用布局默认的分配器。
+template <typename T, typename TPri, typename THash = std::hash<T>, int D = DYNAMIC_ARITY,
+    typename Compare = std::function<bool(const TPri&, const TPri&)>, typename Layout = ImplicitLayout,
+    template <typename, typename, typename> class NodeArray = AosNodeArray, typename Allocator = std::allocator<T>>
 class PriQueue {
+    static_assert(D == DYNAMIC_ARITY || D >= 2, "D must be lareger or equal to 2!!!");
+    static_assert(Layout::LEVEL_ORDER, "PriQueue only supports layouts in level order!!!");
+
 protected:
     // 节点，包含有元素的基本信息和优先级。
     using Node = std::pair<T, TPri>;
+    // 对节点中元素和优先级的常量引用。
+    using NodeRef = std::pair<const T&, const TPri&>;
     // 节点在堆中的位置。
     using NodePos = size_t;
     // 用于比较两节点大小的函数。
-    using CmpFunc = std::function<bool(TPri, TPri)>;
+    using CmpFunc = Compare;
+    // 存储元素并记录它们在堆中位置的索引。
+    using Index = ElementIndex<T, THash, Allocator>;
+    // 元素所在槽位的编号。
+    using SlotId = typename Index::SlotId;
+    // 堆中的节点，包含有元素所在槽位的编号和元素的优先级。
+    using HeapNode = std::pair<SlotId, TPri>;
+    // 存储节点的数组。
+    using Storage = NodeArray<SlotId, TPri, LayoutWithAllocator<Layout, Allocator>>;
 
     // 每个父节点最多可以有多少个子节点（不得小于2）。
-    int d_;
+    int d_ { D == DYNAMIC_ARITY ? 2 : D };
     // 优先队列的种类。
-    PriQueueTyp typ_;
+    PriQueueTyp typ_ { PriQueueTyp::MIN_PRI_QUEUE };
     // 用于比较两节点的函数。
     CmpFunc cmp_func_;
     // 优先队列中节点的个数。
-    size_t size_;
-    // 存储于堆中的节点。
-    std::vector<Node> nodes_;
-    // 从元素到它们在堆中位置的映射。
-    std::unordered_map<T, NodePos, THash> element_to_pos_;
+    size_t size_ { 0 };
+    // 存储队列中的元素，并记录它们在堆中的位置，每个元素只存储一次。
+    Index index_;
+    // 存储于堆中的节点，开头可能有布局预留的空位。
+    Storage nodes_;
+    // 移除队列中第一个元素时所使用的修复策略。
+    PopStrategy pop_strategy_ { PopStrategy::TOP_DOWN };
 
 public:
-    // 使用队列中的元素elements和它们的优先级priorities来构造优先队列。
-    PriQueue(int d, PriQueueTyp typ, CmpFunc&& cmp_func,
-        const std::vector<T>& elements, const std::vector<TPri>& priorities)
+    // 指向队列中一个元素的句柄，在元素离开队列之前保持有效，通过它访问元素时不需要计算哈希值。
+    using Handle = typename Index::Handle;
+
+    // 使用队列中的元素elements和它们的优先级priorities来构造优先队列，num_threads大于1时使用多个线程并行建立
+    // 索引和建堆，比较函数和哈希函数必须可以被同时调用。
+    PriQueue(int d, PriQueueTyp typ, CmpFunc cmp_func,
+        const std::vector<T>& elements, const std::vector<TPri>& priorities, size_t num_threads = 1)
+        : PriQueue(d, typ, std::move(cmp_func), elements, priorities, Allocator(), num_threads)
+    {
+    }
+    // 消耗右值数组elements和priorities来构造优先队列，元素被直接移动到索引的槽位中，优先级被移动到堆中，
+    // 不会复制任何一个元素或优先级。
+    PriQueue(int d, PriQueueTyp typ, CmpFunc cmp_func,
+        std::vector<T>&& elements, std::vector<TPri>&& priorities, size_t num_threads = 1)
+        : PriQueue(d, typ, std::move(cmp_func), std::move(elements), std::move(priorities), Allocator(), num_threads)
+    {
+    }
+    // 使用队列中的元素elements和它们的优先级priorities来构造优先队列，之后索引和堆都使用分配器alloc分配内存。
+    PriQueue(int d, PriQueueTyp typ, CmpFunc cmp_func, const std::vector<T>& elements,
+        const std::vector<TPri>& priorities, const Allocator& alloc, size_t num_threads = 1)
         : d_(d)
         , typ_(typ)
         , cmp_func_(std::move(cmp_func))
-        , size_(elements.size())
-        , element_to_pos_(this->buildElementToPos(elements))
-        , nodes_(this->assembleHeap(elements, priorities))
+        , size_(this->checkInputSize(elements, priorities))
+        , index_(this->buildIndex(elements, alloc, num_threads))
+        , nodes_(this->assembleHeap(elements.size(), priorities, alloc))
+    {
+        this->buildHeap(num_threads);
+    }
+    PriQueue(int d, PriQueueTyp typ, CmpFunc cmp_func, std::vector<T>&& elements, std::vector<TPri>&& priorities,
+        const Allocator& alloc, size_t num_threads = 1)
+        : d_(d)
+        , typ_(typ)
+        , cmp_func_(std::move(cmp_func))
+        , size_(this->checkInputSize(elements, priorities))
+        , index_(this->buildIndex(std::move(elements), alloc, num_threads))
+        , nodes_(this->assembleHeap(size_, std::move(priorities), alloc))
+    {
+        this->buildHeap(num_threads);
+    }
+    PriQueue()
+        : nodes_(this->assembleHeap(0, std::vector<TPri>(), Allocator()))
     {
-        this->buildHeap();
     }
-    PriQueue() = default;
     virtual ~PriQueue() = default;
+    PriQueue(const PriQueue&) = default;
+    PriQueue(PriQueue&&) = default;
+    PriQueue& operator=(const PriQueue&) = default;
+    PriQueue& operator=(PriQueue&&) = default;
 
     // 返回队列中存储的节点的数量。
     size_t size() const noexcept { return size_; }
     // 判断队列是否为空。
     bool empty() const noexcept { return size_ == 0; }
     // 判断一个元素element是否在队列中。
-    bool contains(const T& element) const noexcept
+    bool contains(const T& element) const
     {
-        return element_to_pos_.find(element) != element_to_pos_.end();
+        return index_.find(element) != Index::NO_SLOT;
     }
-    // 将一个元素element和它的优先级pri插入队列中，默认会执行重复性检测，时间复杂度：O(d*log_d(N))。
+    // 判断句柄handle所指向的元素是否仍在队列中。
+    bool contains(Handle handle) const noexcept
+    {
+        return index_.slotOf(handle) != Index::NO_SLOT;
+    }
+    // 返回指向元素element的句柄。
+    Handle getHandle(const T& element) const
+    {
+        SlotId slot_id = index_.find(element);
+        if (slot_id == Index::NO_SLOT) {
+            throw std::out_of_range("No such element is present!!!");
+        }
+        return index_.handleOf(slot_id);
+    }
+    // 预留可以容纳num_elements个元素的空间，使之后的插入不会触发扩容。
+    void reserve(size_t num_elements)
+    {
+        index_.reserve(num_elements);
+        nodes_.reserve(this->reservedSlots() + num_elements);
+    }
+    // 将一个元素element和它的优先级pri插入队列中并返回指向它的句柄，默认会执行重复性检测，
+    // 时间复杂度：O(d*log_d(N))。
     template <bool perform_chk = true, typename TFwd, typename TPriFwd>
-    void push(TFwd&& element, TPriFwd&& pri)
+    Handle push(TFwd&& element, TPriFwd&& pri)
     {
-        if (perform_chk && this->contains(element)) {
+        auto [slot_id, inserted] = index_.template insert<perform_chk>(std::forward<TFwd>(element));
+        if (!inserted) {
             throw std::logic_error("Element is in the queue!!!");
         }
-        element_to_pos_[element] = size_;
-        nodes_.emplace_back(std::forward<TFwd>(element), std::forward<TPriFwd>(pri));
-        size_ += 1;
+        this->appendNode(slot_id, std::forward<TPriFwd>(pri));
         this->heapifyUp(size_ - 1);
+        return index_.handleOf(slot_id);
     }
-    // 将元素element对应的优先级更新为pri，时间复杂度：O(d*log_d(N))。
-    void updatePriority(const T& element, TPri pri)
+    // 将[elements_first, elements_last)中的元素和从priorities_first开始的对应优先级批量插入队列中，会执行重复性检测。
+    // 新元素较多时只对新节点和它们的祖先自底向上重新建堆，否则逐个上浮，时间复杂度：O(min(k*log_d(N), k+log_d(N)^2))。
+    template <typename ElementIt, typename PriorityIt>
+    void pushRange(ElementIt elements_first, ElementIt elements_last, PriorityIt priorities_first)
     {
-        auto pos_it = element_to_pos_.find(element);
-        if (pos_it == element_to_pos_.end()) {
-            throw std::out_of_range("No such element is present!!!");
-        } else if (typ_ == PriQueueTyp::MIN_PRI_QUEUE) {
-            if (nodes_.at(pos_it->second).second <= pri) {
-                throw std::logic_error("Only decrease key operation can be performed in min priority queue!!!");
-            } else {
-                nodes_[pos_it->second].second = std::move(pri);
-                this->heapifyUp(pos_it->second);
+        using IterCategory = typename std::iterator_traits<ElementIt>::iterator_category;
+        if constexpr (std::is_base_of_v<std::forward_iterator_tag, IterCategory>) {
+            this->reserve(size_ + std::distance(elements_first, elements_last));
+        }
+        NodePos first_new_pos = size_;
+        try {
+            for (; elements_first != elements_last; ++elements_first, ++priorities_first) {
+                auto [slot_id, inserted] = index_.insert(*elements_first);
+                if (!inserted) {
+                    throw std::logic_error("Element is in the queue!!!");
+                }
+                this->appendNode(slot_id, *priorities_first);
             }
+        } catch (...) {
+            // 保留出错之前插入的元素，并使队列仍然是一个合法的堆。
+            this->fixAppendedNodes(first_new_pos);
+            throw;
+        }
+        this->fixAppendedNodes(first_new_pos);
+    }
+    // 使用参数args构造一个节点（元素和它的优先级）并插入队列中，返回指向它的句柄，默认会执行重复性检测，
+    // 时间复杂度：O(d*log_d(N))。
+    template <bool perform_chk = true, typename... Args>
+    Handle emplace(Args&&... args)
+    {
+        Node node(std::forward<Args>(args)...);
+        return this->push<perform_chk>(std::move(node.first), std::move(node.second));
+    }
+    // 元素element在队列中时将它的优先级更新为pri，否则将它插入队列中，只需查找一次元素。返回指向该元素的句柄和
+    // 它是否为新插入的元素，时间复杂度：O(d*log_d(N))。
+    template <typename TFwd, typename TPriFwd>
+    std::pair<Handle, bool> pushOrUpdate(TFwd&& element, TPriFwd&& pri)
+    {
+        auto [slot_id, inserted] = index_.insert(std::forward<TFwd>(element));
+        if (inserted) {
+            this->appendNode(slot_id, std::forward<TPriFwd>(pri));
+            this->heapifyUp(size_ - 1);
         } else {
-            if (nodes_.at(pos_it->second).second >= pri) {
-                throw std::logic_error("Only increase key operation can be performed in max priority queue!!!");
-            } else {
-                nodes_[pos_it->second].second = std::move(pri);
-                this->heapifyDown(pos_it->second);
-            }
+            this->updatePriorityAt(index_.pos(slot_id), std::forward<TPriFwd>(pri));
         }
+        return { index_.handleOf(slot_id), inserted };
+    }
+    // 将元素element对应的优先级更新为pri，优先级可以向任意方向改变，时间复杂度：O(d*log_d(N))。
+    void updatePriority(const T& element, TPri pri)
+    {
+        this->updatePriorityAt(this->posOf(element), std::move(pri));
+    }
+    // 将句柄handle所指向的元素的优先级更新为pri，不需要计算哈希值，优先级可以向任意方向改变，
+    // 时间复杂度：O(d*log_d(N))。
+    void updatePriority(Handle handle, TPri pri)
+    {
+        this->updatePriorityAt(this->posOf(handle), std::move(pri));
     }
     // 返回元素element对应的优先级，默认会执行重复性检测。
     template <bool perform_chk = true>
     const TPri& getPriority(const T& element) const
     {
-        auto pos_it = element_to_pos_.find(element);
-        if (perform_chk && pos_it == element_to_pos_.end()) {
+        SlotId slot_id = index_.find(element);
+        if (perform_chk && slot_id == Index::NO_SLOT) {
+            throw std::out_of_range("Unable to find the given node!!!");
+        }
+        return this->priorityAt(index_.pos(slot_id));
+    }
+    // 返回句柄handle所指向的元素的优先级，默认会检测句柄是否有效。
+    template <bool perform_chk = true>
+    const TPri& getPriority(Handle handle) const
+    {
+        if (perform_chk && index_.slotOf(handle) == Index::NO_SLOT) {
+            throw std::out_of_range("Unable to find the given node!!!");
+        }
+        return this->priorityAt(index_.pos(handle.slot_id_));
+    }
+    // 返回句柄handle所指向的元素。
+    const T& getElement(Handle handle) const
+    {
+        SlotId slot_id = index_.slotOf(handle);
+        if (slot_id == Index::NO_SLOT) {
             throw std::out_of_range("Unable to find the given node!!!");
         }
-        return nodes_.at(pos_it->second).second;
+        return index_.element(slot_id);
+    }
+    // 从队列中移除元素element，时间复杂度：O(d*log_d(N))。
+    void erase(const T& element)
+    {
+        this->removeNode(this->posOf(element));
+    }
+    // 从队列中移除句柄handle所指向的元素，时间复杂度：O(d*log_d(N))。
+    void erase(Handle handle)
+    {
+        this->removeNode(this->posOf(handle));
     }
     // 返回队列中的第一个元素。
     const T& top() const
@@ -110,15 +261,15 @@ public:
         if (size_ == 0) {
             throw std::out_of_range("The priority queue is empty!!!");
         }
-        return nodes_.front().first;
+        return this->elementAt(0);
     }
     // 返回队列中的第一个元素和它的优先级。
-    const Node& topNode() const
+    NodeRef topNode() const
     {
         if (size_ == 0) {
             throw std::out_of_range("The priority queue is empty!!!");
         }
-        return nodes_.front();
+        return NodeRef(this->elementAt(0), this->priorityAt(0));
     }
     // 移除队列中的第一个元素。
     void pop()
@@ -126,15 +277,8 @@ public:
         if (size_ == 0) {
             throw std::out_of_range("The priority queue is empty!!!");
         }
-        const auto& node_to_pop = nodes_.at(0);
-        element_to_pos_.erase(node_to_pop.first);
-        nodes_.at(0) = nodes_.back();
-        nodes_.pop_back();
-        size_ -= 1;
-        if (size_ > 0) {
-            element_to_pos_[nodes_.front().first] = 0;
-            this->heapifyDown(0);
-        }
+        index_.erase(this->slotAt(0));
+        this->removeTopNode();
     }
     // 移除队列中的第一个元素并返回它和它的优先级。
     Node popAndReturn()
@@ -142,107 +286,469 @@ public:
         if (size_ == 0) {
             throw std::out_of_range("The priority queue is empty!!!");
         }
-        Node node_to_return = std::move(nodes_.at(0));
-        element_to_pos_.erase(node_to_return.first);
-        nodes_.at(0) = nodes_.back();
-        nodes_.pop_back();
-        size_ -= 1;
-        if (size_ > 0) {
-            element_to_pos_[nodes_.front().first] = 0;
-            this->heapifyDown(0);
-        }
+        HeapNode top_node = this->takeNodeAt(0);
+        Node node_to_return(index_.extract(top_node.first), std::move(top_node.second));
+        this->removeTopNode();
         return node_to_return;
     }
+    // 按照出队的顺序将队列中的前k个元素（不足k个时为所有元素）和它们的优先级写入out并返回写入结束后的位置，
+    // 不修改队列。用一个辅助的小堆记录候选节点，时间复杂度：O(k*d*log(k*d))。
+    template <typename OutputIt>
+    OutputIt topK(size_t k, OutputIt out) const
+    {
+        k = std::min(k, size_);
+        if (k == 0) {
+            return out;
+        }
+        // 候选节点在堆中的位置，以std::push_heap的形式组织，最应该靠近堆顶的候选节点位于开头。
+        std::vector<NodePos> candidates { 0 };
+        candidates.reserve(std::min(k * this->arity(), size_));
+        auto cmp_candidates = [this](NodePos pos_i, NodePos pos_j) { return this->cmpNodes(pos_i, pos_j); };
+        for (size_t i = 0; i < k; i++) {
+            std::pop_heap(candidates.begin(), candidates.end(), cmp_candidates);
+            NodePos node_pos = candidates.back();
+            candidates.pop_back();
+            *out = NodeRef(this->elementAt(node_pos), this->priorityAt(node_pos));
+            ++out;
+            if (i + 1 == k || this->isLeafNode(node_pos)) {
+                continue;
+            }
+            NodePos first_child_pos = this->getChildNodePos(node_pos, 0);
+            NodePos last_child_pos = std::min(first_child_pos + this->arity(), size_);
+            for (NodePos child_node_pos = first_child_pos; child_node_pos < last_child_pos; ++child_node_pos) {
+                candidates.push_back(child_node_pos);
+                std::push_heap(candidates.begin(), candidates.end(), cmp_candidates);
+            }
+        }
+        return out;
+    }
+    // 依次移除队列中的前k个元素（不足k个时移除所有元素），将它们和它们的优先级按照出队的顺序写入out，
+    // 返回写入结束后的位置。逐个出队时每次移动节点都要更新索引中记录的位置，因此出队的元素超过一半时先选出
+    // 这些节点并排序，再对剩余节点重新建堆，移除所有元素时一次性清空索引，
+    // 时间复杂度：O(min(k*d*log_d(N), N+k*log(k)))。
+    template <typename OutputIt>
+    OutputIt popN(size_t k, OutputIt out)
+    {
+        k = std::min(k, size_);
+        if (k * 2 < size_) {
+            for (size_t i = 0; i < k; i++) {
+                HeapNode top_node = this->takeNodeAt(0);
+                *out = Node(index_.extract(top_node.first), std::move(top_node.second));
+                ++out;
+                this->removeTopNode();
+            }
+            return out;
+        }
+        std::vector<HeapNode> heap_nodes;
+        heap_nodes.reserve(size_);
+        for (NodePos node_pos = 0; node_pos < size_; ++node_pos) {
+            heap_nodes.push_back(this->takeNodeAt(node_pos));
+        }
+        auto closer_to_top = [this](const HeapNode& node_i, const HeapNode& node_j) {
+            return cmp_func_(node_j.second, node_i.second);
+        };
+        auto kth = heap_nodes.begin() + k;
+        if (k < size_) {
+            std::nth_element(heap_nodes.begin(), kth, heap_nodes.end(), closer_to_top);
+        }
+        std::sort(heap_nodes.begin(), kth, closer_to_top);
+        for (auto it = heap_nodes.begin(); it != kth; ++it) {
+            *out = Node(k == size_ ? index_.release(it->first) : index_.extract(it->first), std::move(it->second));
+            ++out;
+        }
+        if (k == size_) {
+            index_.clear();
+        }
+        for (size_t i = 0; i < k; i++) {
+            nodes_.popBack();
+        }
+        size_ -= k;
+        for (NodePos node_pos = 0; node_pos < size_; ++node_pos) {
+            this->placeNode(node_pos, std::move(heap_nodes[k + node_pos]));
+        }
+        this->buildHeap();
+        return out;
+    }
+    // 移除队列中所有的元素，将它们和它们的优先级按照出队的顺序写入out并返回写入结束后的位置，
+    // 时间复杂度：O(N*log(N))。
+    template <typename OutputIt>
+    OutputIt drainSorted(OutputIt out)
+    {
+        return this->popN(size_, out);
+    }
+    // 返回移除队列中第一个元素时所使用的修复策略。
+    PopStrategy popStrategy() const noexcept { return pop_strategy_; }
+    // 设置移除队列中第一个元素时所使用的修复策略。
+    void setPopStrategy(PopStrategy pop_strategy) noexcept { pop_strategy_ = pop_strategy; }
 
 protected:
-    // 构建从输入的元素到它在堆中位置的映射。
-    static auto buildElementToPos(const std::vector<T>& elements)
+    // 返回元素element在堆中的位置。
+    NodePos posOf(const T& element) const
     {
-        decltype(element_to_pos_) element_to_pos;
-        NodePos node_pos = 0;
-        for (const auto& element : elements) {
-            element_to_pos[element] = node_pos;
-            node_pos++;
+        SlotId slot_id = index_.find(element);
+        if (slot_id == Index::NO_SLOT) {
+            throw std::out_of_range("No such element is present!!!");
+        }
+        return index_.pos(slot_id);
+    }
+    // 返回句柄handle所指向的元素在堆中的位置。
+    NodePos posOf(Handle handle) const
+    {
+        SlotId slot_id = index_.slotOf(handle);
+        if (slot_id == Index::NO_SLOT) {
+            throw std::out_of_range("No such element is present!!!");
         }
-        return element_to_pos;
+        return index_.pos(slot_id);
     }
-    // 根据输入的元素和优先级生成未经排序的堆。
-    static auto assembleHeap(const std::vector<T>& elements, const std::vector<TPri>& priorities)
+    // 将堆中第node_pos个节点的优先级更新为pri，节点靠近堆顶时上浮，否则下沉。
+    template <typename TPriFwd>
+    void updatePriorityAt(NodePos node_pos, TPriFwd&& pri)
     {
+        bool moves_up = cmp_func_(this->priorityAt(node_pos), pri);
+        this->priorityAt(node_pos) = std::forward<TPriFwd>(pri);
+        if (moves_up) {
+            this->heapifyUp(node_pos);
+        } else {
+            this->heapifyDown(node_pos);
+        }
+    }
+    // 在堆的末尾添加指向第slot_id个槽位的节点，优先级为pri，不修复堆。添加失败时将刚插入索引的元素移除，
+    // 避免元素留在索引中却不在堆中。
+    template <typename TPriFwd>
+    void appendNode(SlotId slot_id, TPriFwd&& pri)
+    {
+        try {
+            if constexpr (Layout::GROWS_IN_CHUNKS) {
+                this->reserveChunk();
+            }
+            nodes_.emplaceBack(slot_id, std::forward<TPriFwd>(pri));
+        } catch (...) {
+            index_.erase(slot_id);
+            throw;
+        }
+        index_.pos(slot_id) = size_;
+        size_ += 1;
+    }
+    // 节点数组已满且扩容后不小于一个大页时按照hugePageGrowth以大块扩容，以整个节点的大小计算容量。
+    void reserveChunk()
+    {
+        if (nodes_.size() == nodes_.capacity()) {
+            size_t capacity = hugePageGrowth(nodes_.capacity(), sizeof(HeapNode));
+            if (capacity > 0) {
+                nodes_.reserve(capacity);
+            }
+        }
+    }
+    // 将输入的元素存入使用分配器alloc的索引，第i个元素存储于第i个槽位，输入为右值时移动其中的元素。元素在堆中
+    // 的位置在建堆之后一次性写入。
+    template <typename Elements>
+    static Index buildIndex(Elements&& elements, const Allocator& alloc, size_t num_threads = 1)
+    {
+        Index index(THash(), alloc);
+        if (num_threads > 1) {
+            if (!index.assignUnique(std::forward<Elements>(elements), num_threads)) {
+                throw std::logic_error("Element is in the queue!!!");
+            }
+            return index;
+        }
+        index.reserve(elements.size());
+        for (auto& element : elements) {
+            bool inserted = false;
+            if constexpr (std::is_rvalue_reference_v<Elements&&>) {
+                inserted = index.insert(std::move(element)).second;
+            } else {
+                inserted = index.insert(element).second;
+            }
+            if (!inserted) {
+                throw std::logic_error("Element is in the queue!!!");
+            }
+        }
+        return index;
+    }
+    // 检查每个父节点最多可以有多少个子节点是否合法。
+    void checkArity() const
+    {
+        if (d_ < 2) {
+            throw std::invalid_argument("D must be lareger or equal to 2!!!");
+        }
+        if (D != DYNAMIC_ARITY && d_ != D) {
+            throw std::invalid_argument("d must be equal to the compile-time arity D!!!");
+        }
+    }
+    // 检查d和输入的元素与优先级的数量是否合法，返回元素的数量。在移动任何一个元素之前调用，使被拒绝的右值输入
+    // 保持不变。
+    size_t checkInputSize(const std::vector<T>& elements, const std::vector<TPri>& priorities) const
+    {
+        this->checkArity();
         if (elements.size() != priorities.size()) {
             throw std::invalid_argument("Number of elements must be equal to number of priorities!!!");
         }
-        decltype(nodes_) nodes;
-        for (size_t i = 0; i < elements.size(); i++) {
-            nodes.emplace_back(elements.at(i), priorities.at(i));
+        return elements.size();
+    }
+    // 根据num_elements个元素的优先级生成使用分配器alloc的未经排序的堆，第i个节点指向第i个槽位，输入为右值时
+    // 移动其中的优先级。布局需要预留空位时在数组开头插入默认构造的节点。
+    template <typename Priorities>
+    Storage assembleHeap(size_t num_elements, Priorities&& priorities, const Allocator& alloc) const
+    {
+        this->checkArity();
+        if (num_elements != priorities.size()) {
+            throw std::invalid_argument("Number of elements must be equal to number of priorities!!!");
+        }
+        Storage nodes(nodeAllocator<HeapNode, Layout>(alloc));
+        nodes.reserve(this->reservedSlots() + num_elements);
+        if constexpr (Layout::RESERVES_SLOTS) {
+            nodes.resize(this->reservedSlots());
+        }
+        for (size_t i = 0; i < num_elements; i++) {
+            if constexpr (std::is_rvalue_reference_v<Priorities&&>) {
+                nodes.emplaceBack(static_cast<SlotId>(i), std::move(priorities[i]));
+            } else {
+                nodes.emplaceBack(static_cast<SlotId>(i), priorities[i]);
+            }
         }
         return nodes;
     }
-    // 构建堆，时间复杂度O(n)。
-    void buildHeap()
+    // 使用num_threads个线程构建堆，时间复杂度O(n)。下沉节点时不更新索引中记录的位置，建堆之后再按照节点的顺序
+    // 一次性写入，不同线程处理的子树互不相交，因此可以并行执行。
+    void buildHeap(size_t num_threads = 1)
     {
-        if (d_ < 2) {
-            throw std::invalid_argument("D must be lareger or equal to 2!!!");
+        floydBuildHeap(size_, this->arity(), num_threads,
+            [this](NodePos pos_to_fix) { this->heapifyDown<false>(pos_to_fix); });
+        if (size_ < MIN_NODES_TO_BUILD_IN_PARALLEL) {
+            num_threads = 1;
+        }
+        parallelFor(size_, num_threads, [this](size_t lo, size_t hi) {
+            for (NodePos node_pos = lo; node_pos < hi; ++node_pos) {
+                index_.pos(this->slotAt(node_pos)) = node_pos;
+            }
+        });
+    }
+    // 修复在堆的末尾批量添加的第first_new_pos到第size_-1个节点。
+    void fixAppendedNodes(NodePos first_new_pos) noexcept
+    {
+        if (first_new_pos >= size_) {
+            return;
+        }
+        if (!shouldRebuildAfterAppend(first_new_pos, size_ - first_new_pos, this->arity())) {
+            for (NodePos pos_to_fix = first_new_pos; pos_to_fix < size_; ++pos_to_fix) {
+                this->heapifyUp(pos_to_fix);
+            }
+            return;
+        }
+        // 新节点和它们的祖先在每一层都是连续的一段，自底向上逐层下沉这些节点，每个节点只处理一次。
+        NodePos lo_pos = first_new_pos, hi_pos = size_ - 1, next_pos = size_;
+        while (true) {
+            for (NodePos pos_to_fix = std::min(hi_pos + 1, next_pos); pos_to_fix > lo_pos; --pos_to_fix) {
+                this->heapifyDown(pos_to_fix - 1);
+            }
+            if (lo_pos == 0) {
+                break;
+            }
+            next_pos = lo_pos;
+            lo_pos = this->getParentNodePos(lo_pos);
+            hi_pos = this->getParentNodePos(hi_pos);
         }
-        for (NodePos pos_to_fix = size_ / d_ + 1; pos_to_fix > 0; --pos_to_fix) {
-            this->heapifyDown(pos_to_fix - 1);
+    }
+    // 返回每个父节点最多可以有多少个子节点，D在编译期确定时返回常量，使乘除法可以被优化为移位。
+    size_t arity() const noexcept
+    {
+        if constexpr (D == DYNAMIC_ARITY) {
+            return d_;
+        } else {
+            return D;
         }
     }
+    // 返回节点数组开头预留的空位数量。
+    size_t reservedSlots() const noexcept
+    {
+        return Layout::reservedSlots(this->arity());
+    }
+    // 返回堆中第node_pos个节点中的元素所在槽位的编号。
+    SlotId slotAt(NodePos node_pos) const noexcept
+    {
+        return nodes_.element(node_pos + this->reservedSlots());
+    }
+    // 返回堆中第node_pos个节点中的元素。
+    const T& elementAt(NodePos node_pos) const noexcept
+    {
+        return index_.element(this->slotAt(node_pos));
+    }
+    // 返回堆中第node_pos个节点中的优先级。
+    TPri& priorityAt(NodePos node_pos) noexcept
+    {
+        return nodes_.priority(node_pos + this->reservedSlots());
+    }
+    const TPri& priorityAt(NodePos node_pos) const noexcept
+    {
+        return nodes_.priority(node_pos + this->reservedSlots());
+    }
+    // 将堆中的第node_pos个节点移出。
+    HeapNode takeNodeAt(NodePos node_pos) noexcept
+    {
+        return nodes_.take(node_pos + this->reservedSlots());
+    }
+    // 预取第node_pos个节点的孙节点，它们在数组中是连续的，这样在比较子节点时下一层的数据已经在读入缓存。
+    void prefetchGrandchildren(NodePos node_pos) const noexcept
+    {
+        NodePos first_grandchild_pos = this->getChildNodePos(this->getChildNodePos(node_pos, 0), 0);
+        if (first_grandchild_pos >= size_) {
+            return;
+        }
+        NodePos last_grandchild_pos = std::min(first_grandchild_pos + this->arity() * this->arity(), size_);
+        prefetchRangeForRead(&this->priorityAt(first_grandchild_pos), &this->priorityAt(last_grandchild_pos - 1) + 1);
+    }
     // 判断堆中第node_pos个节点是否为叶节点。
     bool isLeafNode(NodePos node_pos) const noexcept
     {
-        return d_ * node_pos + 2 > size_;
+        return this->arity() * node_pos + 2 > size_;
     }
     // 返回堆中第parent_node_pos个节点的第child_ord个子节点的位置。
     NodePos getChildNodePos(NodePos parent_node_pos, size_t child_ord) const noexcept
     {
-        return d_ * parent_node_pos + child_ord + 1;
+        return this->arity() * parent_node_pos + child_ord + 1;
     }
     // 返回堆中第child_pos个节点所属的父节点的位置。
     NodePos getParentNodePos(NodePos child_pos) const noexcept
     {
-        return (child_pos - 1) / d_;
+        return (child_pos - 1) / this->arity();
     }
     // 比较位置为i和j的两个节点的优先级的大小。
     bool cmpNodes(NodePos pos_i, NodePos pos_j) const noexcept
     {
-        return cmp_func_(nodes_.at(pos_i).second, nodes_.at(pos_j).second);
+        return cmp_func_(this->priorityAt(pos_i), this->priorityAt(pos_j));
     }
-    // 交换第i个和第j个节点的位置。
-    void swapNodes(NodePos pos_i, NodePos pos_j) noexcept
+    // 将第src_pos个节点移动到dst_pos位置，update_index为true时更新索引中记录的位置，不需要计算哈希值。
+    template <bool update_index = true>
+    void moveNode(NodePos dst_pos, NodePos src_pos) noexcept
     {
-        std::swap(element_to_pos_[nodes_.at(pos_i).first], element_to_pos_[nodes_.at(pos_j).first]);
-        std::swap(nodes_[pos_i], nodes_[pos_j]);
+        nodes_.move(dst_pos + this->reservedSlots(), src_pos + this->reservedSlots());
+        if constexpr (update_index) {
+            index_.pos(this->slotAt(dst_pos)) = dst_pos;
+        }
     }
-    // 在pos_to_fix位置添加一个节点后通过bubble down的方式修复堆，时间复杂度O(d)。
-    void heapifyDown(NodePos pos_to_fix) noexcept
+    // 将节点node写入node_pos位置，update_index为true时更新索引中记录的位置。
+    template <bool update_index = true>
+    void placeNode(NodePos node_pos, HeapNode&& node) noexcept
+    {
+        if constexpr (update_index) {
+            index_.pos(node.first) = node_pos;
+        }
+        nodes_.put(node_pos + this->reservedSlots(), std::move(node));
+    }
+    // 返回第parent_node_pos个节点的子节点中最应该靠近堆顶的那个的位置，调用前需确保该节点不是叶节点。
+    NodePos getBestChildNodePos(NodePos parent_node_pos) const noexcept
     {
-        NodePos pos_to_cmp = pos_to_fix, cur_pos = pos_to_fix;
-        while (!this->isLeafNode(cur_pos)) {
-            for (size_t child_order = 0; child_order < d_; ++child_order) {
-                NodePos child_node_pos = this->getChildNodePos(cur_pos, child_order);
-                if (child_node_pos < size_ && this->cmpNodes(pos_to_cmp, child_node_pos)) {
-                    pos_to_cmp = child_node_pos;
+        NodePos first_child_pos = this->getChildNodePos(parent_node_pos, 0);
+        if constexpr (Storage::CONTIGUOUS_PRIORITIES && simd::canSelectBestChild<TPri, D, Compare>()) {
+            // 优先级连续存放且子节点齐全时使用向量指令一次性选出最值，否则退化为逐个比较。
+            if (first_child_pos + D <= size_) {
+                return first_child_pos + simd::selectBestChild<TPri, D, Compare>(&this->priorityAt(first_child_pos));
+            }
+        }
+        NodePos last_child_pos = std::min(first_child_pos + this->arity(), size_);
+        NodePos best_child_pos = first_child_pos;
+        for (NodePos child_node_pos = first_child_pos + 1; child_node_pos < last_child_pos; ++child_node_pos) {
+            if (this->cmpNodes(best_child_pos, child_node_pos)) {
+                best_child_pos = child_node_pos;
+            }
+        }
+        return best_child_pos;
+    }
+    // 移除堆顶的节点并修复堆，堆顶节点中的数据此时可能已经被移走，调用前需确保队列不为空。
+    void removeTopNode()
+    {
+        HeapNode last_node = this->takeNodeAt(size_ - 1);
+        nodes_.popBack();
+        size_ -= 1;
+        if (size_ == 0) {
+            return;
+        }
+        if (pop_strategy_ == PopStrategy::BOTTOM_UP) {
+            // 只比较子节点将堆顶的空位下移到叶节点，再将最后一个节点从空位处上浮。
+            NodePos hole_pos = 0;
+            while (!this->isLeafNode(hole_pos)) {
+                if constexpr (Layout::PREFETCH) {
+                    this->prefetchGrandchildren(hole_pos);
                 }
+                NodePos best_child_pos = this->getBestChildNodePos(hole_pos);
+                this->moveNode(hole_pos, best_child_pos);
+                hole_pos = best_child_pos;
+            }
+            this->heapifyUpWithHole(hole_pos, std::move(last_node));
+        } else {
+            this->heapifyDownWithHole(0, std::move(last_node));
+        }
+    }
+    // 移除堆中第node_pos个节点及其元素，用最后一个节点填补空位后根据它的优先级上浮或下沉。
+    void removeNode(NodePos node_pos)
+    {
+        if (node_pos == 0) {
+            index_.erase(this->slotAt(0));
+            this->removeTopNode();
+            return;
+        }
+        index_.erase(this->slotAt(node_pos));
+        HeapNode last_node = this->takeNodeAt(size_ - 1);
+        nodes_.popBack();
+        size_ -= 1;
+        if (node_pos == size_) {
+            return;
+        }
+        if (cmp_func_(this->priorityAt(this->getParentNodePos(node_pos)), last_node.second)) {
+            this->heapifyUpWithHole(node_pos, std::move(last_node));
+        } else {
+            this->heapifyDownWithHole(node_pos, std::move(last_node));
+        }
+    }
+    // 在pos_to_fix位置添加一个节点后通过bubble down的方式修复堆，时间复杂度O(d*log_d(N))。update_index为false
+    // 时不更新索引中记录的位置，仅用于建堆。
+    template <bool update_index = true>
+    void heapifyDown(NodePos pos_to_fix) noexcept
+    {
+        if (this->isLeafNode(pos_to_fix)) {
+            return;
+        }
+        this->heapifyDownWithHole<update_index>(pos_to_fix, this->takeNodeAt(pos_to_fix));
+    }
+    // 将hole_pos处视为空位，把node_to_fix沿空位下沉，每层只移动一次节点并更新一次映射，
+    // 最后将node_to_fix写入其最终位置。
+    template <bool update_index = true>
+    void heapifyDownWithHole(NodePos hole_pos, HeapNode node_to_fix) noexcept
+    {
+        while (!this->isLeafNode(hole_pos)) {
+            if constexpr (Layout::PREFETCH) {
+                this->prefetchGrandchildren(hole_pos);
             }
-            if (cur_pos == pos_to_cmp) {
-                return;
+            NodePos best_child_pos = this->getBestChildNodePos(hole_pos);
+            if (!cmp_func_(node_to_fix.second, this->priorityAt(best_child_pos))) {
+                break;
             }
-            this->swapNodes(cur_pos, pos_to_cmp);
-            cur_pos = pos_to_cmp;
+            this->moveNode<update_index>(hole_pos, best_child_pos);
+            hole_pos = best_child_pos;
         }
+        this->placeNode<update_index>(hole_pos, std::move(node_to_fix));
     }
-    // 在pos_to_fix位置添加一个节点后通过bubble up的方式修复堆，时间复杂度O(d)。
+    // 在pos_to_fix位置添加一个节点后通过bubble up的方式修复堆，时间复杂度O(log_d(N))。
     void heapifyUp(NodePos pos_to_fix) noexcept
     {
-        while (pos_to_fix > 0) {
-            NodePos parent_node_pos = this->getParentNodePos(pos_to_fix);
-            if (!this->cmpNodes(parent_node_pos, pos_to_fix)) {
-                return;
+        if (pos_to_fix == 0 || !this->cmpNodes(this->getParentNodePos(pos_to_fix), pos_to_fix)) {
+            return;
+        }
+        this->heapifyUpWithHole(pos_to_fix, this->takeNodeAt(pos_to_fix));
+    }
+    // 将hole_pos处视为空位，把node_to_fix沿空位上浮，每层只移动一次节点并更新一次映射，
+    // 最后将node_to_fix写入其最终位置。
+    void heapifyUpWithHole(NodePos hole_pos, HeapNode node_to_fix) noexcept
+    {
+        while (hole_pos > 0) {
+            NodePos parent_node_pos = this->getParentNodePos(hole_pos);
+            if (!cmp_func_(this->priorityAt(parent_node_pos), node_to_fix.second)) {
+                break;
             }
-            this->swapNodes(pos_to_fix, parent_node_pos);
-            pos_to_fix = parent_node_pos;
+            this->moveNode(hole_pos, parent_node_pos);
+            hole_pos = parent_node_pos;
         }
+        this->placeNode(hole_pos, std::move(node_to_fix));
     }
 };
 
@@ -262,19 +768,78 @@ auto createEmptyMaxPriQueue(int d = 2)
         std::vector<T>(), std::vector<TPri>());
 }
 
-// 使用队列中的元素elements和它们的优先级priorities来构造优先队列。
+// 使用队列中的元素elements和它们的优先级priorities来构造优先队列，num_threads为建立索引和建堆时使用的线程数量。
 template <typename T, typename TPri, typename THash = std::hash<T>, typename Elements, typename Priorities>
-auto buildMinPriQueue(int d, Elements&& elements, Priorities&& priorities)
+auto buildMinPriQueue(int d, Elements&& elements, Priorities&& priorities, size_t num_threads = 1)
 {
     return PriQueue<T, TPri, THash>(d, PriQueueTyp::MIN_PRI_QUEUE, std::greater<> {},
-        std::forward<Elements>(elements), std::forward<Priorities>(priorities));
+        std::forward<Elements>(elements), std::forward<Priorities>(priorities), num_threads);
 }
 
-// 使用队列中的元素elements和它们的优先级priorities来构造优先队列。
+// 使用队列中的元素elements和它们的优先级priorities来构造优先队列，num_threads为建立索引和建堆时使用的线程数量。
 template <typename T, typename TPri, typename THash = std::hash<T>, typename Elements, typename Priorities>
-auto buildMaxPriQueue(int d, Elements&& elements, Priorities&& priorities)
+auto buildMaxPriQueue(int d, Elements&& elements, Priorities&& priorities, size_t num_threads = 1)
 {
     return PriQueue<T, TPri, THash>(d, PriQueueTyp::MAX_PRI_QUEUE, std::less<> {},
-        std::forward<Elements>(elements), std::forward<Priorities>(priorities));
+        std::forward<Elements>(elements), std::forward<Priorities>(priorities), num_threads);
+}
+
+// 构建空的最小优先队列，每个父节点最多可以有D个子节点，D在编译期确定。
+template <typename T, typename TPri, int D, typename THash = std::hash<T>>
+auto createEmptyMinPriQueue()
+{
+    return PriQueue<T, TPri, THash, D, std::greater<>>(D, PriQueueTyp::MIN_PRI_QUEUE, std::greater<> {},
+        std::vector<T>(), std::vector<TPri>());
+}
+
+// 构建空的最大优先队列，每个父节点最多可以有D个子节点，D在编译期确定。
+template <typename T, typename TPri, int D, typename THash = std::hash<T>>
+auto createEmptyMaxPriQueue()
+{
+    return PriQueue<T, TPri, THash, D, std::less<>>(D, PriQueueTyp::MAX_PRI_QUEUE, std::less<> {},
+        std::vector<T>(), std::vector<TPri>());
+}
+
+// 使用队列中的元素elements和它们的优先级priorities来构造最小优先队列，D在编译期确定，num_threads为建立索引
+// 和建堆时使用的线程数量。
+template <typename T, typename TPri, int D, typename THash = std::hash<T>, typename Elements, typename Priorities>
+auto buildMinPriQueue(Elements&& elements, Priorities&& priorities, size_t num_threads = 1)
+{
+    return PriQueue<T, TPri, THash, D, std::greater<>>(D, PriQueueTyp::MIN_PRI_QUEUE, std::greater<> {},
+        std::forward<Elements>(elements), std::forward<Priorities>(priorities), num_threads);
+}
+
+// 使用队列中的元素elements和它们的优先级priorities来构造最大优先队列，D在编译期确定，num_threads为建立索引
+// 和建堆时使用的线程数量。
+template <typename T, typename TPri, int D, typename THash = std::hash<T>, typename Elements, typename Priorities>
+auto buildMaxPriQueue(Elements&& elements, Priorities&& priorities, size_t num_threads = 1)
+{
+    return PriQueue<T, TPri, THash, D, std::less<>>(D, PriQueueTyp::MAX_PRI_QUEUE, std::less<> {},
+        std::forward<Elements>(elements), std::forward<Priorities>(priorities), num_threads);
+}
+}
+
+namespace custom_cont::pmr {
+// 使用std::pmr::polymorphic_allocator分配内存的优先队列，索引和堆都存储于构造时指定的内存资源中。
+template <typename T, typename TPri, typename THash = std::hash<T>, int D = DYNAMIC_ARITY,
+    typename Compare = std::function<bool(const TPri&, const TPri&)>, typename Layout = ImplicitLayout,
+    template <typename, typename, typename> class NodeArray = AosNodeArray>
+using PriQueue
+    = custom_cont::PriQueue<T, TPri, THash, D, Compare, Layout, NodeArray, std::pmr::polymorphic_allocator<T>>;
+
+// 构建空的最小优先队列，索引和堆都存储于内存资源resource中，D在编译期确定。
+template <typename T, typename TPri, int D, typename THash = std::hash<T>>
+auto createEmptyMinPriQueue(std::pmr::memory_resource* resource)
+{
+    return PriQueue<T, TPri, THash, D, std::greater<>>(D, PriQueueTyp::MIN_PRI_QUEUE, std::greater<> {},
+        std::vector<T>(), std::vector<TPri>(), resource);
+}
+
+// 构建空的最大优先队列，索引和堆都存储于内存资源resource中，D在编译期确定。
+template <typename T, typename TPri, int D, typename THash = std::hash<T>>
+auto createEmptyMaxPriQueue(std::pmr::memory_resource* resource)
+{
+    return PriQueue<T, TPri, THash, D, std::less<>>(D, PriQueueTyp::MAX_PRI_QUEUE, std::less<> {},
+        std::vector<T>(), std::vector<TPri>(), resource);
 }
 }
@@ -0,0 +1,299 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "element_index.hpp"
+
+namespace custom_cont {
+// 优先级为非负整数且单调的最小优先队列（基数堆，radix heap），接口与最小的PriQueue相同，
+// 但不提供句柄：push不返回句柄，pushOrUpdate只返回是否为新插入的元素。插入或更新后的优先级
+// 不得小于最近一次出队的元素的优先级，Dijkstra等算法满足这一条件。设last为最近一次重新分配时的最小优先级，
+// 优先级为p的元素存放在第bitWidth(p^last)个桶中，第0个桶中元素的优先级都等于last。插入时只需将元素追加到
+// 对应的桶中；出队时第0个桶为空则找到第一个非空的桶，以其中最小的优先级作为新的last并将桶中元素重新分配到
+// 编号更小的桶中，每个元素最多被重新分配log(C)次，因此不需要任何基于比较的下沉和上浮。查看队首不修改队列。
+// T: 队列中的元素, TPri: 元素的优先级，必须为整数类型, THash: 用于求解元素哈希值的函数。
+template <typename T, typename TPri, typename THash = std::hash<T>>
+class RadixPriQueue {
+    static_assert(std::is_integral_v<TPri>, "Priorities of RadixPriQueue must be integers!!!");
+
+protected:
+    // 节点，包含有元素的基本信息和优先级。
+    using Node = std::pair<T, TPri>;
+    // 对节点中元素和优先级的常量引用。
+    using NodeRef = std::pair<const T&, const TPri&>;
+    // 存储队列中的元素。
+    using Index = ElementIndex<T, THash>;
+    // 元素所在槽位的编号。
+    using SlotId = typename Index::SlotId;
+    // 桶中的节点，包含有元素所在槽位的编号和元素的优先级。
+    struct Entry {
+        TPri pri_;
+        SlotId slot_id_;
+    };
+    // 元素所在的桶和它在桶中的位置。
+    struct Location {
+        uint32_t bucket_idx_;
+        uint32_t entry_idx_;
+    };
+    // 桶的数量，优先级与last的异或值的每一个可能的位宽对应一个桶。
+    static constexpr size_t NUM_BUCKETS = sizeof(TPri) * 8 + 1;
+
+    // 最近一次重新分配桶中的节点时的最小优先级，不大于队列中任何一个元素的优先级。
+    TPri last_pri_ { 0 };
+    // 存储队列中的元素，每个元素只存储一次。
+    Index index_;
+    // 第i个槽位中的元素所在的位置，下标与槽位编号相同。
+    std::vector<Location> locations_;
+    // 所有的桶。
+    std::array<std::vector<Entry>, NUM_BUCKETS> buckets_;
+
+public:
+    // 使用队列中的元素elements和它们的优先级priorities来构造优先队列。
+    RadixPriQueue(const std::vector<T>& elements, const std::vector<TPri>& priorities)
+    {
+        if (elements.size() != priorities.size()) {
+            throw std::invalid_argument("Number of elements must be equal to number of priorities!!!");
+        }
+        this->reserve(elements.size());
+        for (size_t i = 0; i < elements.size(); i++) {
+            this->push(elements[i], priorities[i]);
+        }
+    }
+    RadixPriQueue() = default;
+    virtual ~RadixPriQueue() = default;
+    RadixPriQueue(const RadixPriQueue&) = default;
+    RadixPriQueue(RadixPriQueue&&) = default;
+    RadixPriQueue& operator=(const RadixPriQueue&) = default;
+    RadixPriQueue& operator=(RadixPriQueue&&) = default;
+
+    // 返回队列中存储的元素的数量。
+    size_t size() const noexcept { return index_.size(); }
+    // 判断队列是否为空。
+    bool empty() const noexcept { return index_.size() == 0; }
+    // 判断一个元素element是否在队列中。
+    bool contains(const T& element) const
+    {
+        return index_.find(element) != Index::NO_SLOT;
+    }
+    // 预留可以容纳num_elements个元素的空间。
+    void reserve(size_t num_elements)
+    {
+        index_.reserve(num_elements);
+        locations_.reserve(num_elements);
+    }
+    // 将一个元素element和它的优先级pri插入队列中，默认会执行重复性检测，时间复杂度：O(1)。
+    template <bool perform_chk = true, typename TFwd>
+    void push(TFwd&& element, TPri pri)
+    {
+        this->checkPriority(pri);
+        auto [slot_id, inserted] = index_.template insert<perform_chk>(std::forward<TFwd>(element));
+        if (!inserted) {
+            throw std::logic_error("Element is in the queue!!!");
+        }
+        if (slot_id == locations_.size()) {
+            locations_.emplace_back();
+        }
+        this->appendEntry(Entry { pri, slot_id });
+    }
+    // 元素element在队列中时将它的优先级更新为pri，否则将它插入队列中，返回它是否为新插入的元素，
+    // 时间复杂度：O(1)。
+    template <typename TFwd>
+    bool pushOrUpdate(TFwd&& element, TPri pri)
+    {
+        this->checkPriority(pri);
+        auto [slot_id, inserted] = index_.insert(std::forward<TFwd>(element));
+        if (inserted) {
+            if (slot_id == locations_.size()) {
+                locations_.emplace_back();
+            }
+        } else {
+            this->removeEntry(slot_id);
+        }
+        this->appendEntry(Entry { pri, slot_id });
+        return inserted;
+    }
+    // 将元素element对应的优先级更新为pri，优先级可以向任意方向改变，但不得小于最近一次出队的元素的优先级，
+    // 时间复杂度：O(1)。
+    void updatePriority(const T& element, TPri pri)
+    {
+        this->checkPriority(pri);
+        SlotId slot_id = this->slotOf(element);
+        this->removeEntry(slot_id);
+        this->appendEntry(Entry { pri, slot_id });
+    }
+    // 从队列中移除元素element，时间复杂度：O(1)。
+    void erase(const T& element)
+    {
+        SlotId slot_id = this->slotOf(element);
+        this->removeEntry(slot_id);
+        index_.erase(slot_id);
+    }
+    // 返回元素element对应的优先级，默认会执行存在性检测。
+    template <bool perform_chk = true>
+    const TPri& getPriority(const T& element) const
+    {
+        SlotId slot_id = index_.find(element);
+        if (perform_chk && slot_id == Index::NO_SLOT) {
+            throw std::out_of_range("Unable to find the given node!!!");
+        }
+        return this->entryOf(slot_id).pri_;
+    }
+    // 返回队列中的第一个元素，不修改队列。第0个桶为空时需要扫描第一个非空的桶，时间复杂度：O(该桶的大小)。
+    const T& top() const
+    {
+        return index_.element(this->topEntry().slot_id_);
+    }
+    // 返回队列中的第一个元素和它的优先级，不修改队列，时间复杂度与top()相同。
+    NodeRef topNode() const
+    {
+        const Entry& top_entry = this->topEntry();
+        return NodeRef(index_.element(top_entry.slot_id_), top_entry.pri_);
+    }
+    // 移除队列中的第一个元素，时间复杂度：均摊O(log(C))。
+    void pop()
+    {
+        SlotId slot_id = this->settleTop().slot_id_;
+        this->removeEntry(slot_id);
+        index_.erase(slot_id);
+    }
+    // 移除队列中的第一个元素并返回它和它的优先级，时间复杂度：均摊O(log(C))。
+    Node popAndReturn()
+    {
+        Entry top_entry = this->settleTop();
+        this->removeEntry(top_entry.slot_id_);
+        return Node(index_.extract(top_entry.slot_id_), top_entry.pri_);
+    }
+
+protected:
+    // 返回x的二进制表示的位宽，即最高位的1的位置加一，x为0时返回0。
+    static size_t bitWidth(uint64_t x) noexcept
+    {
+        if (x == 0) {
+            return 0;
+        }
+#if defined(__GNUC__)
+        return 64 - static_cast<size_t>(__builtin_clzll(x));
+#else
+        size_t width = 0;
+        for (; x != 0; x >>= 1) {
+            width += 1;
+        }
+        return width;
+#endif
+    }
+    // 检查优先级pri是否满足单调性。
+    void checkPriority(TPri pri) const
+    {
+        if (pri < last_pri_) {
+            throw std::invalid_argument("Priority must not be smaller than that of the last top element!!!");
+        }
+    }
+    // 返回优先级pri所属的桶的编号。
+    size_t bucketOf(TPri pri) const noexcept
+    {
+        using UPri = std::make_unsigned_t<TPri>;
+        return bitWidth(static_cast<UPri>(pri) ^ static_cast<UPri>(last_pri_));
+    }
+    // 返回元素element所在槽位的编号。
+    SlotId slotOf(const T& element) const
+    {
+        SlotId slot_id = index_.find(element);
+        if (slot_id == Index::NO_SLOT) {
+            throw std::out_of_range("No such element is present!!!");
+        }
+        return slot_id;
+    }
+    // 返回第slot_id个槽位中的元素在桶中的节点。
+    const Entry& entryOf(SlotId slot_id) const noexcept
+    {
+        const Location& location = locations_[slot_id];
+        return buckets_[location.bucket_idx_][location.entry_idx_];
+    }
+    // 将节点entry追加到它所属的桶中并记录它的位置。
+    void appendEntry(Entry entry)
+    {
+        size_t bucket_idx = this->bucketOf(entry.pri_);
+        auto& bucket = buckets_[bucket_idx];
+        locations_[entry.slot_id_] = Location { static_cast<uint32_t>(bucket_idx),
+            static_cast<uint32_t>(bucket.size()) };
+        bucket.push_back(entry);
+    }
+    // 将第slot_id个槽位中的元素的节点从桶中移除，用桶中最后一个节点填补空位。
+    void removeEntry(SlotId slot_id) noexcept
+    {
+        const Location location = locations_[slot_id];
+        auto& bucket = buckets_[location.bucket_idx_];
+        if (location.entry_idx_ + 1 != bucket.size()) {
+            bucket[location.entry_idx_] = bucket.back();
+            locations_[bucket[location.entry_idx_].slot_id_].entry_idx_ = location.entry_idx_;
+        }
+        bucket.pop_back();
+    }
+    // 返回第一个非空的桶的编号，队列为空时抛出异常。
+    size_t firstNonEmptyBucket() const
+    {
+        if (this->empty()) {
+            throw std::out_of_range("The priority queue is empty!!!");
+        }
+        size_t bucket_idx = 0;
+        while (buckets_[bucket_idx].empty()) {
+            bucket_idx += 1;
+        }
+        return bucket_idx;
+    }
+    // 返回优先级最小的节点，不修改桶。第0个桶为空时最小的节点位于第一个非空的桶中，需要扫描该桶；有多个最小的
+    // 节点时返回其中最后一个，它在重新分配后位于第0个桶的末尾，与出队的节点相同。
+    const Entry& topEntry() const
+    {
+        const auto& bucket = buckets_[this->firstNonEmptyBucket()];
+        const Entry* top_entry = &bucket.back();
+        for (const auto& entry : bucket) {
+            if (entry.pri_ <= top_entry->pri_) {
+                top_entry = &entry;
+            }
+        }
+        return *top_entry;
+    }
+    // 返回优先级最小的节点，第0个桶为空时先以第一个非空的桶中最小的优先级作为新的last，并将该桶中的节点重新分配到
+    // 编号更小的桶中。先为每个目标桶预留空间再移动节点，因此分配内存失败时队列保持不变。
+    const Entry& settleTop()
+    {
+        size_t bucket_idx = this->firstNonEmptyBucket();
+        if (bucket_idx == 0) {
+            return buckets_[0].back();
+        }
+        auto& entries = buckets_[bucket_idx];
+        TPri min_pri = this->topEntry().pri_;
+        using UPri = std::make_unsigned_t<TPri>;
+        std::array<size_t, NUM_BUCKETS> num_moved {};
+        for (const auto& entry : entries) {
+            num_moved[bitWidth(static_cast<UPri>(entry.pri_) ^ static_cast<UPri>(min_pri))] += 1;
+        }
+        for (size_t target_idx = 0; target_idx < bucket_idx; target_idx++) {
+            buckets_[target_idx].reserve(buckets_[target_idx].size() + num_moved[target_idx]);
+        }
+        // 桶中的节点与新的last的异或值的最高位一定低于原来的位置，因此都会被分配到编号更小的桶中。
+        last_pri_ = min_pri;
+        for (const auto& entry : entries) {
+            this->appendEntry(entry);
+        }
+        // 保留该桶已分配的空间以便复用。
+        entries.clear();
+        return buckets_[0].back();
+    }
+};
+
+// 构建空的优先级为单调的非负整数的最小优先队列。
+template <typename T, typename TPri, typename THash = std::hash<T>>
+auto createEmptyMinRadixPriQueue()
+{
+    return RadixPriQueue<T, TPri, THash>();
+}
+}
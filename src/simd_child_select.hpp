@@ -0,0 +1,225 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <type_traits>
+
+#if defined(__SSE4_1__)
+#include <immintrin.h>
+#endif
+
+namespace custom_cont::simd {
+// 根据比较函数判断应该从子节点中选出最小值（最小堆）还是最大值（最大堆），只有标准库中的比较函数才能被识别。
+template <typename Compare, typename T>
+struct SelectDirection {
+    static constexpr bool SUPPORTED = false;
+    static constexpr bool SELECT_MIN = false;
+};
+template <typename T>
+struct SelectDirection<std::greater<T>, T> {
+    static constexpr bool SUPPORTED = true;
+    static constexpr bool SELECT_MIN = true;
+};
+template <typename T>
+struct SelectDirection<std::greater<>, T> {
+    static constexpr bool SUPPORTED = true;
+    static constexpr bool SELECT_MIN = true;
+};
+template <typename T>
+struct SelectDirection<std::less<T>, T> {
+    static constexpr bool SUPPORTED = true;
+    static constexpr bool SELECT_MIN = false;
+};
+template <typename T>
+struct SelectDirection<std::less<>, T> {
+    static constexpr bool SUPPORTED = true;
+    static constexpr bool SELECT_MIN = false;
+};
+
+// 对一组连续的T执行向量运算的函数集合，BYTES为向量的宽度。
+template <typename T, size_t BYTES>
+struct VecOps {
+    static constexpr bool SUPPORTED = false;
+};
+
+#if defined(__SSE4_1__)
+template <>
+struct VecOps<int32_t, 16> {
+    static constexpr bool SUPPORTED = true;
+    static constexpr size_t LANES = 4;
+    using Vec = __m128i;
+    static Vec load(const int32_t* ptr) { return _mm_loadu_si128(reinterpret_cast<const __m128i*>(ptr)); }
+    static Vec min(Vec lhs, Vec rhs) { return _mm_min_epi32(lhs, rhs); }
+    static Vec max(Vec lhs, Vec rhs) { return _mm_max_epi32(lhs, rhs); }
+    static Vec swapHalves(Vec vec) { return _mm_shuffle_epi32(vec, _MM_SHUFFLE(1, 0, 3, 2)); }
+    static Vec swapPairs(Vec vec) { return _mm_shuffle_epi32(vec, _MM_SHUFFLE(2, 3, 0, 1)); }
+    static unsigned eqMask(Vec lhs, Vec rhs) { return _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(lhs, rhs))); }
+};
+template <>
+struct VecOps<uint32_t, 16> : VecOps<int32_t, 16> {
+    static Vec load(const uint32_t* ptr) { return _mm_loadu_si128(reinterpret_cast<const __m128i*>(ptr)); }
+    static Vec min(Vec lhs, Vec rhs) { return _mm_min_epu32(lhs, rhs); }
+    static Vec max(Vec lhs, Vec rhs) { return _mm_max_epu32(lhs, rhs); }
+};
+template <>
+struct VecOps<float, 16> {
+    static constexpr bool SUPPORTED = true;
+    static constexpr size_t LANES = 4;
+    using Vec = __m128;
+    static Vec load(const float* ptr) { return _mm_loadu_ps(ptr); }
+    static Vec min(Vec lhs, Vec rhs) { return _mm_min_ps(lhs, rhs); }
+    static Vec max(Vec lhs, Vec rhs) { return _mm_max_ps(lhs, rhs); }
+    static Vec swapHalves(Vec vec) { return _mm_shuffle_ps(vec, vec, _MM_SHUFFLE(1, 0, 3, 2)); }
+    static Vec swapPairs(Vec vec) { return _mm_shuffle_ps(vec, vec, _MM_SHUFFLE(2, 3, 0, 1)); }
+    static unsigned eqMask(Vec lhs, Vec rhs) { return _mm_movemask_ps(_mm_cmpeq_ps(lhs, rhs)); }
+};
+template <>
+struct VecOps<double, 16> {
+    static constexpr bool SUPPORTED = true;
+    static constexpr size_t LANES = 2;
+    using Vec = __m128d;
+    static Vec load(const double* ptr) { return _mm_loadu_pd(ptr); }
+    static Vec min(Vec lhs, Vec rhs) { return _mm_min_pd(lhs, rhs); }
+    static Vec max(Vec lhs, Vec rhs) { return _mm_max_pd(lhs, rhs); }
+    static Vec swapHalves(Vec vec) { return _mm_shuffle_pd(vec, vec, 1); }
+    static unsigned eqMask(Vec lhs, Vec rhs) { return _mm_movemask_pd(_mm_cmpeq_pd(lhs, rhs)); }
+};
+#endif
+
+#if defined(__AVX2__)
+template <>
+struct VecOps<int32_t, 32> {
+    static constexpr bool SUPPORTED = true;
+    static constexpr size_t LANES = 8;
+    using Vec = __m256i;
+    static Vec load(const int32_t* ptr) { return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(ptr)); }
+    static Vec min(Vec lhs, Vec rhs) { return _mm256_min_epi32(lhs, rhs); }
+    static Vec max(Vec lhs, Vec rhs) { return _mm256_max_epi32(lhs, rhs); }
+    static Vec swapLanes(Vec vec) { return _mm256_permute2x128_si256(vec, vec, 1); }
+    static Vec swapHalves(Vec vec) { return _mm256_shuffle_epi32(vec, _MM_SHUFFLE(1, 0, 3, 2)); }
+    static Vec swapPairs(Vec vec) { return _mm256_shuffle_epi32(vec, _MM_SHUFFLE(2, 3, 0, 1)); }
+    static unsigned eqMask(Vec lhs, Vec rhs)
+    {
+        return _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(lhs, rhs)));
+    }
+};
+template <>
+struct VecOps<uint32_t, 32> : VecOps<int32_t, 32> {
+    static Vec load(const uint32_t* ptr) { return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(ptr)); }
+    static Vec min(Vec lhs, Vec rhs) { return _mm256_min_epu32(lhs, rhs); }
+    static Vec max(Vec lhs, Vec rhs) { return _mm256_max_epu32(lhs, rhs); }
+};
+template <>
+struct VecOps<float, 32> {
+    static constexpr bool SUPPORTED = true;
+    static constexpr size_t LANES = 8;
+    using Vec = __m256;
+    static Vec load(const float* ptr) { return _mm256_loadu_ps(ptr); }
+    static Vec min(Vec lhs, Vec rhs) { return _mm256_min_ps(lhs, rhs); }
+    static Vec max(Vec lhs, Vec rhs) { return _mm256_max_ps(lhs, rhs); }
+    static Vec swapLanes(Vec vec) { return _mm256_permute2f128_ps(vec, vec, 1); }
+    static Vec swapHalves(Vec vec) { return _mm256_shuffle_ps(vec, vec, _MM_SHUFFLE(1, 0, 3, 2)); }
+    static Vec swapPairs(Vec vec) { return _mm256_shuffle_ps(vec, vec, _MM_SHUFFLE(2, 3, 0, 1)); }
+    static unsigned eqMask(Vec lhs, Vec rhs) { return _mm256_movemask_ps(_mm256_cmp_ps(lhs, rhs, _CMP_EQ_OQ)); }
+};
+template <>
+struct VecOps<double, 32> {
+    static constexpr bool SUPPORTED = true;
+    static constexpr size_t LANES = 4;
+    using Vec = __m256d;
+    static Vec load(const double* ptr) { return _mm256_loadu_pd(ptr); }
+    static Vec min(Vec lhs, Vec rhs) { return _mm256_min_pd(lhs, rhs); }
+    static Vec max(Vec lhs, Vec rhs) { return _mm256_max_pd(lhs, rhs); }
+    static Vec swapLanes(Vec vec) { return _mm256_permute2f128_pd(vec, vec, 1); }
+    static Vec swapHalves(Vec vec) { return _mm256_shuffle_pd(vec, vec, 0b0101); }
+    static unsigned eqMask(Vec lhs, Vec rhs) { return _mm256_movemask_pd(_mm256_cmp_pd(lhs, rhs, _CMP_EQ_OQ)); }
+};
+#endif
+
+// 将T映射为宽度相同的定长类型，使int和unsigned int等类型可以共用同一套向量运算。
+template <typename T>
+using SimdScalar = std::conditional_t<std::is_integral_v<T> && sizeof(T) == 4,
+    std::conditional_t<std::is_signed_v<T>, int32_t, uint32_t>, T>;
+
+// 为D个连续的T选择向量宽度：能用AVX2时优先使用256位，否则使用128位。
+template <typename T, int D>
+constexpr size_t chooseVecBytes()
+{
+    if constexpr (VecOps<SimdScalar<T>, 32>::SUPPORTED && D * sizeof(T) >= 32) {
+        return 32;
+    } else {
+        return 16;
+    }
+}
+
+// 判断能否对D个连续的、使用比较函数Compare进行比较的T进行向量化的最值选择。
+template <typename T, int D, typename Compare>
+constexpr bool canSelectBestChild()
+{
+    if constexpr (!SelectDirection<Compare, T>::SUPPORTED || !(D == 4 || D == 8 || D == 16)) {
+        return false;
+    } else {
+        using Ops = VecOps<SimdScalar<T>, chooseVecBytes<T, D>()>;
+        if constexpr (!Ops::SUPPORTED) {
+            return false;
+        } else {
+            return D % Ops::LANES == 0;
+        }
+    }
+}
+
+// 对向量vec进行水平归约，使其每个通道都保存所有通道中的最小值（select_min为true时）或最大值。
+template <typename Ops, bool select_min>
+typename Ops::Vec splatBest(typename Ops::Vec vec)
+{
+    auto reduce = [](auto lhs, auto rhs) { return select_min ? Ops::min(lhs, rhs) : Ops::max(lhs, rhs); };
+    // 256位的向量先交换高低两个128位通道，之后的操作都在128位通道内进行。
+    constexpr size_t num_128_lanes = sizeof(typename Ops::Vec) / 16;
+    if constexpr (num_128_lanes == 2) {
+        vec = reduce(vec, Ops::swapLanes(vec));
+    }
+    vec = reduce(vec, Ops::swapHalves(vec));
+    if constexpr (Ops::LANES / num_128_lanes == 4) {
+        vec = reduce(vec, Ops::swapPairs(vec));
+    }
+    return vec;
+}
+
+// 返回从first开始的D个连续节点中最应该靠近堆顶的那个的序号，存在多个时返回序号最小的那个，与逐个比较的结果一致。
+// 节点中包含NaN时各节点之间没有确定的顺序，此时返回的序号不一定与逐个比较的结果相同，但一定小于D。
+template <typename T, int D, typename Compare>
+size_t selectBestChild(const T* first)
+{
+    static_assert(canSelectBestChild<T, D, Compare>(), "No vectorized implementation for the given type and D!!!");
+    using Scalar = SimdScalar<T>;
+    using Ops = VecOps<Scalar, chooseVecBytes<T, D>()>;
+    constexpr bool select_min = SelectDirection<Compare, T>::SELECT_MIN;
+    constexpr size_t num_vecs = D / Ops::LANES;
+    const auto* scalars = reinterpret_cast<const Scalar*>(first);
+    typename Ops::Vec vecs[num_vecs];
+    for (size_t i = 0; i < num_vecs; ++i) {
+        vecs[i] = Ops::load(scalars + i * Ops::LANES);
+    }
+    typename Ops::Vec best = vecs[0];
+    for (size_t i = 1; i < num_vecs; ++i) {
+        best = select_min ? Ops::min(best, vecs[i]) : Ops::max(best, vecs[i]);
+    }
+    best = splatBest<Ops, select_min>(best);
+    unsigned mask = 0;
+    for (size_t i = 0; i < num_vecs; ++i) {
+        mask |= Ops::eqMask(vecs[i], best) << (i * Ops::LANES);
+    }
+    if (mask == 0) {
+        // 归约的结果为NaN时没有节点与它相等，退化为逐个比较。
+        size_t best_child_ord = 0;
+        for (size_t child_ord = 1; child_ord < D; ++child_ord) {
+            if (Compare()(first[best_child_ord], first[child_ord])) {
+                best_child_ord = child_ord;
+            }
+        }
+        return best_child_ord;
+    }
+    return __builtin_ctz(mask);
+}
+}
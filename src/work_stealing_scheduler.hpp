@@ -0,0 +1,322 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "d_ary_heap.hpp"
+
+namespace custom_cont {
+// 带优先级的任务调度器。每个工作线程拥有一个存放任务的D叉堆，优先执行优先级较高的任务，优先级相同时先提交的
+// 任务先执行。工作线程提交的任务放入它自己的堆中，只有其他线程窃取时才会发生竞争。自己的堆为空时，工作线程从
+// 缓存的堆顶优先级最高的其他线程中窃取堆顶的任务；自己的堆不为空时，它也会查看一个随机的其他线程，对方的堆顶
+// 优先级更高时窃取它，以减少优先级倒置（有更高优先级的任务在等待时执行较低优先级的任务）。
+// TPri: 任务的优先级，必须为算术类型, D: 每个堆中的父节点最多可以有多少个子节点。
+template <typename TPri = int, int D = 4>
+class WorkStealingScheduler {
+    static_assert(std::is_arithmetic_v<TPri>, "Priorities of WorkStealingScheduler must be arithmetic types!!!");
+
+protected:
+    // 堆中的任务。
+    struct Task {
+        // 任务的优先级。
+        TPri pri_;
+        // 任务在所在工作线程中的提交序号，用于使优先级相同的任务按照提交的顺序执行。
+        uint64_t seq_;
+        // 需要执行的函数。
+        std::function<void()> func_;
+    };
+    // 判断任务lhs是否应当排在任务rhs之后。
+    struct TaskCmp {
+        bool operator()(const Task& lhs, const Task& rhs) const
+        {
+            return lhs.pri_ < rhs.pri_ || (lhs.pri_ == rhs.pri_ && lhs.seq_ > rhs.seq_);
+        }
+    };
+    // 存放任务的堆。
+    using Heap = DAryHeap<Task, D, TaskCmp>;
+    // 工作线程的任务队列，按照缓存行对齐以避免伪共享。
+    struct alignas(64) Worker {
+        // 保护堆的锁，通常只有所属的工作线程访问。
+        std::mutex mutex_;
+        // 存放任务的堆。
+        Heap heap_ { D, TaskCmp(), std::vector<Task>() };
+        // 下一个任务的提交序号。
+        uint64_t next_seq_ { 0 };
+        // 堆中任务的数量，可以在不加锁的情况下读取。
+        std::atomic<size_t> size_ { 0 };
+        // 缓存的堆顶任务的优先级，只在size_大于0时有意义。
+        std::atomic<TPri> top_pri_ { TPri() };
+        // 从其他线程窃取的任务的数量。
+        std::atomic<size_t> num_stolen_ { 0 };
+    };
+    // 当前线程所属的调度器和它在其中的编号。
+    struct WorkerIdentity {
+        const WorkStealingScheduler* scheduler_ { nullptr };
+        size_t worker_idx_ { 0 };
+    };
+
+    // 工作线程的数量。
+    size_t num_workers_ { 0 };
+    // 所有工作线程的任务队列。
+    std::unique_ptr<Worker[]> workers_;
+    // 所有的工作线程。
+    std::vector<std::thread> threads_;
+    // 外部线程提交任务时轮流使用的工作线程编号。
+    std::atomic<size_t> next_worker_idx_ { 0 };
+    // 已提交但尚未执行完毕的任务的数量。
+    std::atomic<size_t> num_unfinished_ { 0 };
+    // 正在等待任务的工作线程的数量。
+    std::atomic<size_t> num_sleeping_ { 0 };
+    // 是否正在停止调度器。
+    bool stopping_ { false };
+    // 工作线程等待任务时使用的锁和条件变量。
+    std::mutex sleep_mutex_;
+    std::condition_variable sleep_cv_;
+    // 等待所有任务执行完毕时使用的锁和条件变量。
+    std::mutex idle_mutex_;
+    std::condition_variable idle_cv_;
+    // 任务抛出的第一个异常。
+    std::exception_ptr first_error_;
+
+public:
+    // 构造拥有num_workers个工作线程的调度器，默认与硬件线程数相同，无法获取硬件线程数时只使用一个工作线程。
+    explicit WorkStealingScheduler(size_t num_workers = std::max(1u, std::thread::hardware_concurrency()))
+        : num_workers_(num_workers)
+    {
+        if (num_workers_ == 0) {
+            throw std::invalid_argument("Number of workers must be larger than 0!!!");
+        }
+        workers_ = std::make_unique<Worker[]>(num_workers_);
+        threads_.reserve(num_workers_);
+        try {
+            for (size_t worker_idx = 0; worker_idx < num_workers_; worker_idx++) {
+                threads_.emplace_back([this, worker_idx]() { this->runWorker(worker_idx); });
+            }
+        } catch (...) {
+            // 创建线程失败时析构函数不会被调用，需要先停止已经启动的工作线程，否则销毁它们时程序会终止。
+            this->stopWorkers();
+            throw;
+        }
+    }
+    // 执行完所有已提交的任务后停止所有工作线程。
+    virtual ~WorkStealingScheduler() { this->stopWorkers(); }
+
+    // 返回工作线程的数量。
+    size_t numWorkers() const noexcept { return num_workers_; }
+    // 返回从其他线程窃取的任务的总数。
+    size_t numStolen() const noexcept
+    {
+        size_t num_stolen = 0;
+        for (size_t worker_idx = 0; worker_idx < num_workers_; worker_idx++) {
+            num_stolen += workers_[worker_idx].num_stolen_.load(std::memory_order_relaxed);
+        }
+        return num_stolen;
+    }
+    // 提交一个优先级为pri的任务func。在工作线程中调用时放入当前线程的堆中，否则轮流放入各个工作线程的堆中。
+    template <typename Func>
+    void submit(TPri pri, Func&& func)
+    {
+        const WorkerIdentity& current = this->identity();
+        size_t worker_idx = current.scheduler_ == this
+            ? current.worker_idx_
+            : next_worker_idx_.fetch_add(1, std::memory_order_relaxed) % num_workers_;
+        this->submitTo(worker_idx, pri, std::forward<Func>(func));
+    }
+    // 将一个优先级为pri的任务func放入第worker_idx个工作线程的堆中。
+    template <typename Func>
+    void submitTo(size_t worker_idx, TPri pri, Func&& func)
+    {
+        if (worker_idx >= num_workers_) {
+            throw std::out_of_range("Worker index is out of range!!!");
+        }
+        num_unfinished_.fetch_add(1, std::memory_order_relaxed);
+        Worker& worker = workers_[worker_idx];
+        try {
+            std::lock_guard<std::mutex> lock(worker.mutex_);
+            worker.heap_.push(Task { pri, worker.next_seq_, std::function<void()>(std::forward<Func>(func)) });
+            worker.next_seq_++;
+            this->updateCache(worker);
+        } catch (...) {
+            // 任务没有放入堆中，撤销对未完成任务数量的计数，否则waitIdle会一直等待下去。
+            this->finishTask();
+            throw;
+        }
+        if (num_sleeping_.load() > 0) {
+            std::lock_guard<std::mutex> lock(sleep_mutex_);
+            sleep_cv_.notify_one();
+        }
+    }
+    // 等待所有已提交的任务执行完毕，有任务抛出异常时重新抛出其中的第一个。不得在工作线程中调用。
+    void waitIdle()
+    {
+        std::unique_lock<std::mutex> lock(idle_mutex_);
+        idle_cv_.wait(lock, [this]() { return num_unfinished_.load() == 0; });
+        if (first_error_) {
+            std::exception_ptr error = std::move(first_error_);
+            first_error_ = nullptr;
+            std::rethrow_exception(error);
+        }
+    }
+
+protected:
+    // 返回当前线程的身份。
+    static WorkerIdentity& identity() noexcept
+    {
+        thread_local WorkerIdentity identity;
+        return identity;
+    }
+    // 返回当前线程生成的一个随机数，每个线程使用各自的xorshift随机数生成器。
+    static uint64_t randomNumber() noexcept
+    {
+        thread_local uint64_t state = std::hash<std::thread::id>()(std::this_thread::get_id()) | 1;
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        return state;
+    }
+    // 在持有工作线程的锁时更新它缓存的堆顶优先级和任务数量。
+    void updateCache(Worker& worker) noexcept
+    {
+        if (!worker.heap_.empty()) {
+            worker.top_pri_.store(worker.heap_.top().pri_, std::memory_order_relaxed);
+        }
+        worker.size_.store(worker.heap_.size());
+    }
+    // 从工作线程worker的堆中取出堆顶的任务，堆为空时返回std::nullopt。
+    std::optional<Task> popFrom(Worker& worker)
+    {
+        std::lock_guard<std::mutex> lock(worker.mutex_);
+        if (worker.heap_.empty()) {
+            return std::nullopt;
+        }
+        Task task = worker.heap_.popAndReturn();
+        this->updateCache(worker);
+        return task;
+    }
+    // 为第worker_idx个工作线程选取下一个要执行的任务，所有的堆都为空时返回std::nullopt。
+    std::optional<Task> takeTask(size_t worker_idx)
+    {
+        Worker& self = workers_[worker_idx];
+        if (self.size_.load(std::memory_order_relaxed) > 0) {
+            if (num_workers_ > 1) {
+                size_t victim_idx = (worker_idx + 1 + randomNumber() % (num_workers_ - 1)) % num_workers_;
+                Worker& victim = workers_[victim_idx];
+                TPri self_top_pri = self.top_pri_.load(std::memory_order_relaxed);
+                if (victim.size_.load(std::memory_order_relaxed) > 0
+                    && victim.top_pri_.load(std::memory_order_relaxed) > self_top_pri) {
+                    std::optional<Task> task = this->popFrom(victim);
+                    if (task) {
+                        self.num_stolen_.fetch_add(1, std::memory_order_relaxed);
+                        return task;
+                    }
+                }
+            }
+            std::optional<Task> task = this->popFrom(self);
+            if (task) {
+                return task;
+            }
+        }
+        // 自己的堆为空时，从缓存的堆顶优先级最高的工作线程中窃取。
+        while (true) {
+            Worker* best_victim = nullptr;
+            for (size_t victim_idx = 0; victim_idx < num_workers_; victim_idx++) {
+                Worker& victim = workers_[victim_idx];
+                if (victim.size_.load() > 0
+                    && (best_victim == nullptr
+                        || victim.top_pri_.load(std::memory_order_relaxed)
+                            > best_victim->top_pri_.load(std::memory_order_relaxed))) {
+                    best_victim = &victim;
+                }
+            }
+            if (best_victim == nullptr) {
+                return std::nullopt;
+            }
+            std::optional<Task> task = this->popFrom(*best_victim);
+            if (task) {
+                if (best_victim != &self) {
+                    self.num_stolen_.fetch_add(1, std::memory_order_relaxed);
+                }
+                return task;
+            }
+        }
+    }
+    // 判断是否有任何一个堆不为空。
+    bool hasQueuedTasks() const noexcept
+    {
+        for (size_t worker_idx = 0; worker_idx < num_workers_; worker_idx++) {
+            if (workers_[worker_idx].size_.load() > 0) {
+                return true;
+            }
+        }
+        return false;
+    }
+    // 通知所有工作线程在执行完已提交的任务后退出，并等待它们结束。
+    void stopWorkers() noexcept
+    {
+        {
+            std::lock_guard<std::mutex> lock(sleep_mutex_);
+            stopping_ = true;
+        }
+        sleep_cv_.notify_all();
+        for (auto& thread : threads_) {
+            thread.join();
+        }
+    }
+    // 第worker_idx个工作线程的主循环。
+    void runWorker(size_t worker_idx)
+    {
+        identity() = WorkerIdentity { this, worker_idx };
+        while (true) {
+            std::optional<Task> task = this->takeTask(worker_idx);
+            if (task) {
+                this->runTask(*task);
+                continue;
+            }
+            // 先登记为等待状态再检查所有的堆，提交任务的线程先放入任务再检查等待的线程数量，因此不会错过唤醒。
+            std::unique_lock<std::mutex> lock(sleep_mutex_);
+            num_sleeping_.fetch_add(1);
+            if (!this->hasQueuedTasks()) {
+                if (stopping_) {
+                    num_sleeping_.fetch_sub(1);
+                    return;
+                }
+                sleep_cv_.wait(lock);
+            }
+            num_sleeping_.fetch_sub(1);
+        }
+    }
+    // 执行任务task，记录它抛出的异常。
+    void runTask(Task& task)
+    {
+        try {
+            task.func_();
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(idle_mutex_);
+            if (!first_error_) {
+                first_error_ = std::current_exception();
+            }
+        }
+        this->finishTask();
+    }
+    // 将未完成任务的数量减一，所有任务执行完毕时唤醒等待的线程。
+    void finishTask() noexcept
+    {
+        if (num_unfinished_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            std::lock_guard<std::mutex> lock(idle_mutex_);
+            idle_cv_.notify_all();
+        }
+    }
+};
+}
@@ -0,0 +1,169 @@
+#include <algorithm>
+#include <cmath>
+#include <gtest/gtest.h>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "../src/calendar_queue.hpp"
+#include "../src/d_ary_heap.hpp"
+
+namespace custom_cont {
+namespace test_calendar_queue {
+    constexpr int RAND_SEED = 20240701;
+
+    // 离散事件仿真中的事件，包含有发生的时间和编号。
+    struct Event {
+        double time_ { 0.0 };
+        int event_id_ { -1 };
+    };
+    struct EventTimeOf {
+        double operator()(const Event& event) const { return event.time_; }
+    };
+
+    TEST(TestCalendarQueue, testSortedOrder)
+    {
+        std::mt19937 rand_gen(RAND_SEED);
+        std::uniform_real_distribution<double> rand_dist(-1000.0, 1000.0);
+        std::vector<double> times(3000);
+        for (auto& time : times) {
+            time = rand_dist(rand_gen);
+        }
+        auto calendar_queue = createEmptyCalendarQueue<double>();
+        for (const auto& time : times) {
+            calendar_queue.push(time);
+        }
+        auto built_calendar_queue = buildCalendarQueue<double>(times);
+        EXPECT_EQ(calendar_queue.size(), times.size());
+        EXPECT_EQ(built_calendar_queue.size(), times.size());
+        std::sort(times.begin(), times.end());
+        for (const auto& time : times) {
+            EXPECT_EQ(calendar_queue.top(), time);
+            EXPECT_EQ(calendar_queue.popAndReturn(), time);
+            EXPECT_EQ(built_calendar_queue.popAndReturn(), time);
+        }
+        EXPECT_TRUE(calendar_queue.empty());
+        EXPECT_EQ(calendar_queue.numBuckets(), 2u);
+        EXPECT_THROW(calendar_queue.top(), std::out_of_range);
+        EXPECT_THROW(calendar_queue.pop(), std::out_of_range);
+        EXPECT_THROW(calendar_queue.popAndReturn(), std::out_of_range);
+    }
+
+    TEST(TestCalendarQueue, testHoldModel)
+    {
+        // 反复取出最早的事件并插入一个稍晚的事件，偶尔插入一个很晚的事件或早于当前时间的事件，结果应当与最小堆相同。
+        std::mt19937 rand_gen(RAND_SEED);
+        std::exponential_distribution<double> rand_dist(1.0);
+        std::uniform_int_distribution<int> rand_kind(0, 99);
+        auto calendar_queue = createEmptyCalendarQueue<double>();
+        auto min_heap = createEmptyMinDHeap<double, 4>();
+        for (int i = 0; i < 1000; i++) {
+            double time = rand_dist(rand_gen);
+            calendar_queue.push(time);
+            min_heap.push(time);
+        }
+        for (int i = 0; i < 50000; i++) {
+            ASSERT_EQ(calendar_queue.top(), min_heap.top());
+            double now = calendar_queue.popAndReturn();
+            min_heap.pop();
+            int kind = rand_kind(rand_gen);
+            double time = now + rand_dist(rand_gen);
+            if (kind == 0) {
+                time = now + 1e4 * rand_dist(rand_gen);
+            } else if (kind == 1) {
+                time = now - rand_dist(rand_gen);
+            }
+            calendar_queue.push(time);
+            min_heap.push(time);
+            // 节点的数量在1000到2667之间往复变化，触发桶数量的加倍和减半。
+            if (i % 6 == 0 && (i / 10000) % 2 == 0) {
+                time = now + rand_dist(rand_gen);
+                calendar_queue.push(time);
+                min_heap.push(time);
+            } else if (i % 6 == 0) {
+                calendar_queue.pop();
+                min_heap.pop();
+            }
+            ASSERT_EQ(calendar_queue.size(), min_heap.size());
+        }
+        EXPECT_GT(calendar_queue.bucketWidth(), 0.0);
+    }
+
+    TEST(TestCalendarQueue, testWidthAdaptation)
+    {
+        // 节点数量不变而时间间隔变大上千倍时，桶的宽度应当随之变大。
+        std::mt19937 rand_gen(RAND_SEED);
+        std::uniform_real_distribution<double> rand_dist(0.0, 1.0);
+        auto calendar_queue = createEmptyCalendarQueue<double>();
+        auto min_heap = createEmptyMinDHeap<double, 4>();
+        for (int i = 0; i < 1000; i++) {
+            double time = rand_dist(rand_gen);
+            calendar_queue.push(time);
+            min_heap.push(time);
+        }
+        double initial_width = calendar_queue.bucketWidth();
+        size_t num_buckets = calendar_queue.numBuckets();
+        for (int i = 0; i < 20000; i++) {
+            ASSERT_EQ(calendar_queue.top(), min_heap.top());
+            double time = calendar_queue.popAndReturn() + 1000.0 * rand_dist(rand_gen);
+            min_heap.pop();
+            calendar_queue.push(time);
+            min_heap.push(time);
+        }
+        EXPECT_EQ(calendar_queue.numBuckets(), num_buckets);
+        EXPECT_GT(calendar_queue.bucketWidth(), 100.0 * initial_width);
+    }
+
+    TEST(TestCalendarQueue, testTiesAndCustomTime)
+    {
+        // 时间相同的事件按照插入的顺序取出，桶的数量调整后依然如此。
+        auto calendar_queue = createEmptyCalendarQueue<Event>(EventTimeOf());
+        for (int i = 0; i < 1000; i++) {
+            calendar_queue.push(Event { static_cast<double>(i % 10), i });
+        }
+        calendar_queue.emplace(Event { -5.0, 1000 });
+        EXPECT_EQ(calendar_queue.top().event_id_, 1000);
+        calendar_queue.pop();
+        for (int time = 0; time < 10; time++) {
+            for (int i = time; i < 1000; i += 10) {
+                auto event = calendar_queue.popAndReturn();
+                EXPECT_EQ(event.time_, time);
+                EXPECT_EQ(event.event_id_, i);
+            }
+        }
+        EXPECT_TRUE(calendar_queue.empty());
+    }
+
+    TEST(TestCalendarQueue, testLargeAndFarApartTimes)
+    {
+        // 时间远超出int64_t的范围或彼此相差极大时依然按照时间顺序取出。
+        auto calendar_queue = createEmptyCalendarQueue<double>();
+        std::vector<double> times { 1e19, 5.0, 3.0, -1e300, 1e300, 1e19 + 4096.0, -2.5, 1e15, 1e15 + 1.0 };
+        for (double time : times) {
+            calendar_queue.push(time);
+        }
+        std::mt19937 rand_gen(RAND_SEED);
+        std::uniform_real_distribution<double> rand_dist(0.0, 1e6);
+        for (int i = 0; i < 1000; i++) {
+            double time = 1e18 + rand_dist(rand_gen) * 1e4;
+            times.push_back(time);
+            calendar_queue.push(time);
+        }
+        std::sort(times.begin(), times.end());
+        for (double expected_time : times) {
+            ASSERT_EQ(calendar_queue.popAndReturn(), expected_time);
+        }
+        EXPECT_TRUE(calendar_queue.empty());
+        // 时间原点在队列为空后重新确定，新的节点的天不受之前巨大时间的影响。
+        std::vector<double> late_times { 1e19 + 2048.0, 1e19, 1e19 + 1024.0 };
+        auto built_queue = buildCalendarQueue<double>(std::move(late_times));
+        EXPECT_EQ(built_queue.popAndReturn(), 1e19);
+        EXPECT_EQ(built_queue.popAndReturn(), 1e19 + 1024.0);
+        EXPECT_THROW(built_queue.push(std::nan("")), std::invalid_argument);
+        EXPECT_EQ(built_queue.size(), 1u);
+        EXPECT_EQ(built_queue.popAndReturn(), 1e19 + 2048.0);
+        std::vector<double> nan_times { 1.0, std::nan("") };
+        EXPECT_THROW(buildCalendarQueue<double>(nan_times), std::invalid_argument);
+    }
+}
+}
@@ -0,0 +1,98 @@
+#include <algorithm>
+#include <gtest/gtest.h>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "../src/concurrent_multi_queue.hpp"
+
+namespace custom_cont {
+namespace test_concurrent_multi_queue {
+    constexpr int RAND_SEED = 20240715;
+
+    // 生成num_data个随机整数。
+    std::vector<int> genIntsForTest(size_t num_data)
+    {
+        std::mt19937 rand_gen(RAND_SEED);
+        std::uniform_int_distribution<int> rand_dist(-100000, 100000);
+        std::vector<int> dataset(num_data);
+        for (auto& data : dataset) {
+            data = rand_dist(rand_gen);
+        }
+        return dataset;
+    }
+
+    TEST(TestConcurrentMultiQueue, testSingleThread)
+    {
+        auto values = genIntsForTest(2000);
+        // 只有一个分片时与普通的最小堆相同。
+        auto min_queue = createEmptyMinMultiQueue<int>(1, 1);
+        auto max_queue = createEmptyMaxMultiQueue<int, 2>(2, 4);
+        for (int value : values) {
+            min_queue.push(value);
+            max_queue.push(value);
+        }
+        EXPECT_EQ(min_queue.numShards(), 1u);
+        EXPECT_EQ(max_queue.numShards(), 8u);
+        EXPECT_EQ(max_queue.size(), values.size());
+        std::vector<int> popped_from_max_queue;
+        int value = 0;
+        while (max_queue.tryPop(value)) {
+            popped_from_max_queue.push_back(value);
+        }
+        EXPECT_TRUE(max_queue.empty());
+        EXPECT_FALSE(max_queue.tryPop(value));
+        // 有多个分片时取出的节点大致有序，每个节点都恰好被取出一次。
+        EXPECT_GT(popped_from_max_queue.front(), popped_from_max_queue.back());
+        std::sort(popped_from_max_queue.begin(), popped_from_max_queue.end());
+        std::sort(values.begin(), values.end());
+        EXPECT_EQ(popped_from_max_queue, values);
+        for (int expected_value : values) {
+            ASSERT_TRUE(min_queue.tryPop(value));
+            EXPECT_EQ(value, expected_value);
+        }
+        EXPECT_FALSE(min_queue.tryPop(value));
+        EXPECT_THROW((ConcurrentMultiQueue<int>(0)), std::invalid_argument);
+    }
+
+    TEST(TestConcurrentMultiQueue, testMultipleThreads)
+    {
+        // 多个线程同时插入和取出节点，每个节点都恰好被取出一次。
+        constexpr int NUM_THREADS = 4;
+        constexpr int NUM_VALUES_PER_THREAD = 20000;
+        auto min_queue = createEmptyMinMultiQueue<int>(NUM_THREADS);
+        std::vector<std::vector<int>> popped_values(NUM_THREADS);
+        std::vector<std::thread> threads;
+        for (int thread_idx = 0; thread_idx < NUM_THREADS; thread_idx++) {
+            threads.emplace_back([&, thread_idx]() {
+                for (int i = 0; i < NUM_VALUES_PER_THREAD; i++) {
+                    min_queue.push(thread_idx * NUM_VALUES_PER_THREAD + i);
+                    if (i % 2 == 1) {
+                        int value = 0;
+                        if (min_queue.tryPop(value)) {
+                            popped_values[thread_idx].push_back(value);
+                        }
+                    }
+                }
+            });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+        std::vector<int> all_values;
+        for (const auto& values : popped_values) {
+            all_values.insert(all_values.end(), values.begin(), values.end());
+        }
+        EXPECT_EQ(min_queue.size() + all_values.size(), static_cast<size_t>(NUM_THREADS * NUM_VALUES_PER_THREAD));
+        int value = 0;
+        while (min_queue.tryPop(value)) {
+            all_values.push_back(value);
+        }
+        std::sort(all_values.begin(), all_values.end());
+        ASSERT_EQ(all_values.size(), static_cast<size_t>(NUM_THREADS * NUM_VALUES_PER_THREAD));
+        for (int i = 0; i < NUM_THREADS * NUM_VALUES_PER_THREAD; i++) {
+            EXPECT_EQ(all_values[i], i);
+        }
+    }
+}
+}
@@ -0,0 +1,167 @@
+#include <algorithm>
+#include <gtest/gtest.h>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "../src/concurrent_priority_queue.hpp"
+
+namespace custom_cont {
+namespace test_concurrent_priority_queue {
+    constexpr int RAND_SEED = 20240722;
+    constexpr int NUM_THREADS = 4;
+
+    // 移动构造时可能抛出异常的优先级，moves_before_throw_次移动之后的下一次移动会抛出异常，为负数时从不抛出。
+    struct ThrowingPri {
+        static inline int moves_before_throw_ = -1;
+        int value_ { 0 };
+
+        ThrowingPri() = default;
+        explicit ThrowingPri(int value)
+            : value_(value)
+        {
+        }
+        ThrowingPri(const ThrowingPri&) = default;
+        ThrowingPri(ThrowingPri&& other)
+            : value_(other.value_)
+        {
+            if (moves_before_throw_ == 0) {
+                moves_before_throw_ = -1;
+                throw std::runtime_error("Failed to move the priority!!!");
+            }
+            if (moves_before_throw_ > 0) {
+                moves_before_throw_ -= 1;
+            }
+        }
+        ThrowingPri& operator=(const ThrowingPri&) = default;
+        ThrowingPri& operator=(ThrowingPri&&) = default;
+        bool operator<(const ThrowingPri& other) const { return value_ < other.value_; }
+        bool operator>(const ThrowingPri& other) const { return value_ > other.value_; }
+    };
+
+    TEST(TestConcurrentPriQueue, testSingleThread)
+    {
+        auto min_queue = createEmptyMinConcurrentPriQueue<std::string, int>(2);
+        min_queue.push("Dijkstra", 3);
+        min_queue.push("A-star", 1);
+        min_queue.push("RRT", 2);
+        EXPECT_THROW(min_queue.push("RRT", 5), std::logic_error);
+        EXPECT_THROW(min_queue.updatePriority("RRT-star", 5), std::out_of_range);
+        EXPECT_THROW(min_queue.erase("RRT-star"), std::out_of_range);
+        EXPECT_TRUE(min_queue.pushOrUpdate("RRT-star", 0));
+        EXPECT_FALSE(min_queue.pushOrUpdate("RRT", 4));
+        min_queue.updatePriority("Dijkstra", -1);
+        min_queue.erase("A-star");
+        EXPECT_EQ(min_queue.size(), 3u);
+        std::pair<std::string, int> node;
+        std::vector<std::pair<std::string, int>> expected_nodes { { "Dijkstra", -1 }, { "RRT-star", 0 }, { "RRT", 4 } };
+        for (const auto& expected_node : expected_nodes) {
+            ASSERT_TRUE(min_queue.tryPop(node));
+            EXPECT_EQ(node, expected_node);
+        }
+        EXPECT_TRUE(min_queue.empty());
+        EXPECT_FALSE(min_queue.tryPop(node));
+    }
+
+    TEST(TestConcurrentPriQueue, testMultipleThreads)
+    {
+        // 多个线程同时插入、更新和取出元素，每个元素都恰好被取出一次。
+        constexpr int NUM_ELEMENTS_PER_THREAD = 5000;
+        auto max_queue = createEmptyMaxConcurrentPriQueue<int, int>(NUM_THREADS);
+        std::vector<std::vector<int>> popped_elements(NUM_THREADS);
+        std::vector<std::thread> threads;
+        for (int thread_idx = 0; thread_idx < NUM_THREADS; thread_idx++) {
+            threads.emplace_back([&, thread_idx]() {
+                std::mt19937 rand_gen(RAND_SEED + thread_idx);
+                std::uniform_int_distribution<int> rand_dist(0, 100000);
+                int first_element = thread_idx * NUM_ELEMENTS_PER_THREAD;
+                for (int i = 0; i < NUM_ELEMENTS_PER_THREAD; i++) {
+                    max_queue.push(first_element + i, rand_dist(rand_gen));
+                    // 元素可能已被其他线程取出，此时更新会抛出异常。
+                    if (i % 3 == 0) {
+                        try {
+                            max_queue.updatePriority(first_element + i, rand_dist(rand_gen));
+                        } catch (const std::out_of_range&) {
+                        }
+                    }
+                    std::pair<int, int> node;
+                    if (i % 2 == 1 && max_queue.tryPop(node)) {
+                        popped_elements[thread_idx].push_back(node.first);
+                    }
+                }
+            });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+        std::vector<int> all_elements;
+        for (const auto& elements : popped_elements) {
+            all_elements.insert(all_elements.end(), elements.begin(), elements.end());
+        }
+        // 所有线程结束后剩余的元素严格按照优先级从大到小取出。
+        std::pair<int, int> node;
+        int last_pri = 100000;
+        while (max_queue.tryPop(node)) {
+            EXPECT_LE(node.second, last_pri);
+            last_pri = node.second;
+            all_elements.push_back(node.first);
+        }
+        std::sort(all_elements.begin(), all_elements.end());
+        ASSERT_EQ(all_elements.size(), static_cast<size_t>(NUM_THREADS * NUM_ELEMENTS_PER_THREAD));
+        for (int i = 0; i < NUM_THREADS * NUM_ELEMENTS_PER_THREAD; i++) {
+            EXPECT_EQ(all_elements[i], i);
+        }
+    }
+
+    TEST(TestConcurrentPriQueue, testConcurrentDuplicates)
+    {
+        // 多个线程同时插入相同的元素，只有一个线程成功，其余线程收到异常。
+        auto min_queue = createEmptyMinConcurrentPriQueue<int, int>(NUM_THREADS);
+        std::vector<int> num_failures(NUM_THREADS, 0);
+        std::vector<std::thread> threads;
+        for (int thread_idx = 0; thread_idx < NUM_THREADS; thread_idx++) {
+            threads.emplace_back([&, thread_idx]() {
+                for (int i = 0; i < 1000; i++) {
+                    try {
+                        min_queue.push(i, thread_idx);
+                    } catch (const std::logic_error&) {
+                        num_failures[thread_idx] += 1;
+                    }
+                }
+            });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+        int total_failures = 0;
+        for (int num_failure : num_failures) {
+            total_failures += num_failure;
+        }
+        EXPECT_EQ(total_failures, (NUM_THREADS - 1) * 1000);
+        EXPECT_EQ(min_queue.size(), 1000u);
+    }
+
+    TEST(TestConcurrentPriQueue, testThrowingMove)
+    {
+        // 发布插入操作时优先级被移动3次，第4次移动发生在合并者将它收集到批量插入的数组中时。合并者抛出的异常被交给
+        // 发起操作的线程，锁和槽位都被释放，之后的操作不受影响。
+        auto min_queue = createEmptyMinConcurrentPriQueue<int, ThrowingPri>(1);
+        min_queue.push(1, ThrowingPri(1));
+        ThrowingPri::moves_before_throw_ = 3;
+        EXPECT_THROW(min_queue.push(2, ThrowingPri(2)), std::runtime_error);
+        EXPECT_EQ(ThrowingPri::moves_before_throw_, -1);
+        EXPECT_THROW(min_queue.erase(2), std::out_of_range);
+        EXPECT_EQ(min_queue.size(), 1u);
+        min_queue.push(0, ThrowingPri(0));
+        std::pair<int, ThrowingPri> node;
+        for (int expected_element : { 0, 1 }) {
+            ASSERT_TRUE(min_queue.tryPop(node));
+            EXPECT_EQ(node.first, expected_element);
+        }
+        EXPECT_FALSE(min_queue.tryPop(node));
+    }
+}
+}
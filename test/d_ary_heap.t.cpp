@@ -1,6 +1,11 @@
+#include <algorithm>
+#include <cstdint>
 #include <functional>
 #include <gtest/gtest.h>
 #include <iostream>
+#include <iterator>
+#include <memory>
+#include <memory_resource>
 #include <random>
 #include <string>
 
@@ -45,8 +50,8 @@ public:
         std::make_heap(values_in_str_.begin(), values_in_str_.end(), std::greater<std::string> {});
         std::make_heap(values_in_int_.begin(), values_in_int_.end(), std::less<int> {});
     }
-    template <typename T>
-    bool isTwoHeapsEqual(std::vector<T> std_heap, DAryHeap<T> k_heap, std::function<bool(T, T)> cmp_func) const
+    template <typename T, typename THeap = DAryHeap<T>>
+    bool isTwoHeapsEqual(std::vector<T> std_heap, THeap k_heap, std::function<bool(T, T)> cmp_func) const
     {
         size_t length = std_heap.size();
         for (size_t i = 0; i < length; i++) {
@@ -124,4 +129,421 @@ TEST_F(TestHeapFixture, testMbrFuncPush)
             std::less<int> {}));
     }
 }
+
+TEST_F(TestHeapFixture, testCompileTimeArity)
+{
+    auto min_heap_d4 = buildMinDHeap<std::string, 4>(values_in_str_);
+    auto min_heap_d10 = buildMinDHeap<std::string, 10>(values_in_str_);
+    EXPECT_TRUE((this->isTwoHeapsEqual<std::string, decltype(min_heap_d4)>(values_in_str_, min_heap_d4,
+        std::greater<std::string> {})));
+    EXPECT_TRUE((this->isTwoHeapsEqual<std::string, decltype(min_heap_d10)>(values_in_str_, min_heap_d10,
+        std::greater<std::string> {})));
+    auto max_heap_d2 = createEmptyMaxDHeap<int, 2>();
+    auto max_heap_d3 = createEmptyMaxDHeap<int, 3>();
+    auto max_heap_d8 = createEmptyMaxDHeap<int, 8>();
+    for (int num_to_push : values_in_int_) {
+        max_heap_d2.push(num_to_push);
+        max_heap_d3.push(num_to_push);
+        max_heap_d8.push(num_to_push);
+    }
+    for (size_t i = 0; i < 1000; i++) {
+        int num_to_push = std::rand();
+        max_heap_d2.push(num_to_push);
+        max_heap_d3.push(num_to_push);
+        max_heap_d8.push(num_to_push);
+        values_in_int_.push_back(num_to_push);
+    }
+    std::make_heap(values_in_int_.begin(), values_in_int_.end(), std::less<int> {});
+    EXPECT_TRUE((this->isTwoHeapsEqual<int, decltype(max_heap_d2)>(values_in_int_, max_heap_d2, std::less<int> {})));
+    EXPECT_TRUE((this->isTwoHeapsEqual<int, decltype(max_heap_d3)>(values_in_int_, max_heap_d3, std::less<int> {})));
+    EXPECT_TRUE((this->isTwoHeapsEqual<int, decltype(max_heap_d8)>(values_in_int_, max_heap_d8, std::less<int> {})));
+    EXPECT_THROW((DAryHeap<int, 4, std::less<int>>(3, std::less<int> {}, std::vector<int>())), std::invalid_argument);
+}
+
+TEST_F(TestHeapFixture, testMbrFuncEmplace)
+{
+    auto min_d_heap = createEmptyMinDHeap<std::string, 3>();
+    for (const auto& str : values_in_str_) {
+        min_d_heap.emplace(str.c_str(), str.size());
+    }
+    min_d_heap.emplace(size_t(3), 'z');
+    values_in_str_.emplace_back(size_t(3), 'z');
+    std::make_heap(values_in_str_.begin(), values_in_str_.end(), std::greater<std::string> {});
+    EXPECT_TRUE((this->isTwoHeapsEqual<std::string, decltype(min_d_heap)>(values_in_str_, min_d_heap,
+        std::greater<std::string> {})));
+}
+
+TEST_F(TestHeapFixture, testMoveOnlyNodes)
+{
+    auto cmp_func = [](const std::unique_ptr<int>& lhs, const std::unique_ptr<int>& rhs) { return *lhs < *rhs; };
+    auto max_d_heap = DAryHeap<std::unique_ptr<int>, 4, decltype(cmp_func)>(4, cmp_func,
+        std::vector<std::unique_ptr<int>>());
+    std::vector<int> expected_nums;
+    for (int num : values_in_int_) {
+        max_d_heap.push(std::make_unique<int>(num));
+        max_d_heap.emplace(new int(num + 1));
+        expected_nums.push_back(num);
+        expected_nums.push_back(num + 1);
+    }
+    std::sort(expected_nums.begin(), expected_nums.end(), std::greater<int> {});
+    // 移动堆时直接接管其中的节点。
+    const int* top_ptr = max_d_heap.top().get();
+    auto moved_max_d_heap = std::move(max_d_heap);
+    EXPECT_EQ(moved_max_d_heap.top().get(), top_ptr);
+    EXPECT_EQ(moved_max_d_heap.size(), expected_nums.size());
+    for (size_t i = 0; i < expected_nums.size(); i += 2) {
+        EXPECT_EQ(*moved_max_d_heap.top(), expected_nums.at(i));
+        auto top_node = moved_max_d_heap.popAndReturn();
+        EXPECT_EQ(*top_node, expected_nums.at(i));
+        EXPECT_EQ(*moved_max_d_heap.top(), expected_nums.at(i + 1));
+        moved_max_d_heap.pop();
+    }
+    EXPECT_TRUE(moved_max_d_heap.empty());
+    // 比较函数可以赋值时也可以移动赋值。
+    auto min_ptr_heap = DAryHeap<std::unique_ptr<int>>(2,
+        [](const std::unique_ptr<int>& lhs, const std::unique_ptr<int>& rhs) { return *lhs > *rhs; },
+        std::vector<std::unique_ptr<int>>());
+    min_ptr_heap.push(std::make_unique<int>(2));
+    min_ptr_heap.push(std::make_unique<int>(1));
+    auto other_ptr_heap = DAryHeap<std::unique_ptr<int>>();
+    other_ptr_heap = std::move(min_ptr_heap);
+    EXPECT_EQ(*other_ptr_heap.popAndReturn(), 1);
+    EXPECT_EQ(*other_ptr_heap.popAndReturn(), 2);
+}
+
+TEST_F(TestHeapFixture, testBottomUpPopStrategy)
+{
+    min_d_heap_.setPopStrategy(PopStrategy::BOTTOM_UP);
+    max_d_heap_.setPopStrategy(PopStrategy::BOTTOM_UP);
+    EXPECT_EQ(max_d_heap_.popStrategy(), PopStrategy::BOTTOM_UP);
+    EXPECT_TRUE(this->isTwoHeapsEqual<std::string>(values_in_str_, min_d_heap_, std::greater<std::string> {}));
+    auto max_heap_d5 = createEmptyMaxDHeap<int>(5);
+    auto max_heap_d16 = createEmptyMaxDHeap<int, 16>();
+    max_heap_d5.setPopStrategy(PopStrategy::BOTTOM_UP);
+    max_heap_d16.setPopStrategy(PopStrategy::BOTTOM_UP);
+    for (int num_to_push : values_in_int_) {
+        max_heap_d5.push(num_to_push);
+        max_heap_d16.push(num_to_push);
+    }
+    for (size_t i = 0; i < 1000; i++) {
+        int num_to_push = std::rand();
+        max_d_heap_.push(num_to_push);
+        max_heap_d5.push(num_to_push);
+        max_heap_d16.push(num_to_push);
+        values_in_int_.push_back(num_to_push);
+    }
+    std::make_heap(values_in_int_.begin(), values_in_int_.end(), std::less<int> {});
+    EXPECT_TRUE(this->isTwoHeapsEqual<int>(values_in_int_, max_d_heap_, std::less<int> {}));
+    EXPECT_TRUE(this->isTwoHeapsEqual<int>(values_in_int_, max_heap_d5, std::less<int> {}));
+    EXPECT_TRUE((this->isTwoHeapsEqual<int, decltype(max_heap_d16)>(values_in_int_, max_heap_d16, std::less<int> {})));
+}
+
+// 用于检查节点在数组中的地址的堆。
+template <typename T, int D>
+class AlignedMaxHeap : public DAryHeap<T, D, std::less<T>, CacheAlignedLayout> {
+public:
+    AlignedMaxHeap()
+        : DAryHeap<T, D, std::less<T>, CacheAlignedLayout>(D, std::less<T>(), std::vector<T>())
+    {
+    }
+    // 判断每组兄弟节点的首个节点是否都按sizeof(T) * D字节对齐。
+    bool isSiblingGroupsAligned() const
+    {
+        for (size_t pos = 1; pos < this->size(); pos += D) {
+            if (reinterpret_cast<uintptr_t>(&this->nodeAt(pos)) % (sizeof(T) * D) != 0) {
+                return false;
+            }
+        }
+        return true;
+    }
+};
+
+TEST_F(TestHeapFixture, testCacheAlignedLayout)
+{
+    auto max_heap_d16 = AlignedMaxHeap<int, 16>();
+    auto max_heap_d4 = AlignedMaxHeap<int, 4>();
+    auto max_heap_d3 = DAryHeap<int, DYNAMIC_ARITY, std::less<int>, CacheAlignedLayout>(3, std::less<int>(),
+        std::vector<int>());
+    max_heap_d16.setPopStrategy(PopStrategy::BOTTOM_UP);
+    for (size_t i = 0; i < 3000; i++) {
+        values_in_int_.push_back(std::rand());
+    }
+    for (int num_to_push : values_in_int_) {
+        max_heap_d16.push(num_to_push);
+        max_heap_d4.push(num_to_push);
+        max_heap_d3.push(num_to_push);
+    }
+    EXPECT_TRUE(max_heap_d16.isSiblingGroupsAligned());
+    EXPECT_TRUE(max_heap_d4.isSiblingGroupsAligned());
+    std::make_heap(values_in_int_.begin(), values_in_int_.end(), std::less<int> {});
+    EXPECT_TRUE((this->isTwoHeapsEqual<int, decltype(max_heap_d16)>(values_in_int_, max_heap_d16, std::less<int> {})));
+    EXPECT_TRUE((this->isTwoHeapsEqual<int, decltype(max_heap_d4)>(values_in_int_, max_heap_d4, std::less<int> {})));
+    EXPECT_TRUE((this->isTwoHeapsEqual<int, decltype(max_heap_d3)>(values_in_int_, max_heap_d3, std::less<int> {})));
+    auto min_heap_str = DAryHeap<std::string, 4, std::greater<std::string>, CacheAlignedLayout>(4,
+        std::greater<std::string>(), values_in_str_);
+    EXPECT_TRUE((this->isTwoHeapsEqual<std::string, decltype(min_heap_str)>(values_in_str_, min_heap_str,
+        std::greater<std::string> {})));
+}
+
+TEST_F(TestHeapFixture, testMbrFuncPushRange)
+{
+    // 分别插入少量节点（逐个上浮）和大量节点（自底向上重建），插入到空堆中也应当得到合法的堆。
+    for (size_t num_new_nodes : { 3, 40, 3000 }) {
+        auto max_heap = max_d_heap_;
+        auto aligned_max_heap = AlignedMaxHeap<int, 4>();
+        for (int value : values_in_int_) {
+            aligned_max_heap.push(value);
+        }
+        auto empty_max_heap = createEmptyMaxDHeap<int>(3);
+        std::vector<int> new_values, expected_values = values_in_int_;
+        for (size_t i = 0; i < num_new_nodes; i++) {
+            new_values.push_back(std::rand() % 1000);
+        }
+        max_heap.pushRange(new_values.begin(), new_values.end());
+        aligned_max_heap.pushRange(new_values.begin(), new_values.end());
+        empty_max_heap.pushRange(new_values.begin(), new_values.end());
+        EXPECT_TRUE(aligned_max_heap.isSiblingGroupsAligned());
+        expected_values.insert(expected_values.end(), new_values.begin(), new_values.end());
+        std::make_heap(expected_values.begin(), expected_values.end(), std::less<int> {});
+        std::make_heap(new_values.begin(), new_values.end(), std::less<int> {});
+        EXPECT_TRUE((this->isTwoHeapsEqual<int>(expected_values, max_heap, std::less<int> {})));
+        EXPECT_TRUE((this->isTwoHeapsEqual<int, decltype(aligned_max_heap)>(expected_values, aligned_max_heap,
+            std::less<int> {})));
+        EXPECT_TRUE((this->isTwoHeapsEqual<int, decltype(empty_max_heap)>(new_values, empty_max_heap,
+            std::less<int> {})));
+    }
+}
+
+TEST_F(TestHeapFixture, testMbrFuncPopN)
+{
+    // 出堆节点较少时逐个出堆，较多时选择后排序，两种方式都应当与逐个调用popAndReturn的结果相同。
+    for (size_t i = 0; i < 3000; i++) {
+        values_in_int_.push_back(std::rand() % 1000);
+    }
+    for (size_t k : { 0, 5, 500, 3000, 5000 }) {
+        auto max_heap = buildMaxDHeap<int, 4>(values_in_int_);
+        auto expected_heap = max_heap;
+        std::vector<int> popped_values;
+        max_heap.popN(k, std::back_inserter(popped_values));
+        EXPECT_EQ(popped_values.size(), std::min(k, values_in_int_.size()));
+        for (int popped_value : popped_values) {
+            EXPECT_EQ(popped_value, expected_heap.popAndReturn());
+        }
+        EXPECT_EQ(max_heap.size(), expected_heap.size());
+        std::vector<int> remaining_values(max_heap.size());
+        EXPECT_EQ(max_heap.drainSorted(remaining_values.begin()), remaining_values.end());
+        EXPECT_TRUE(max_heap.empty());
+        for (int remaining_value : remaining_values) {
+            EXPECT_EQ(remaining_value, expected_heap.popAndReturn());
+        }
+    }
+    std::vector<std::string> popped_strs;
+    min_d_heap_.popN(2, std::back_inserter(popped_strs));
+    EXPECT_EQ(popped_strs, (std::vector<std::string> { "A-star", "Bellman-Ford" }));
+    EXPECT_EQ(min_d_heap_.top(), "Dijkstra");
+}
+
+TEST_F(TestHeapFixture, testMbrFuncTopK)
+{
+    for (size_t i = 0; i < 3000; i++) {
+        values_in_int_.push_back(std::rand() % 1000);
+    }
+    auto max_heap = buildMaxDHeap<int, 3>(values_in_int_);
+    for (size_t k : { 0, 1, 7, 300, 5000 }) {
+        std::vector<int> peeked_values, expected_values;
+        max_heap.topK(k, std::back_inserter(peeked_values));
+        auto heap_copy = max_heap;
+        heap_copy.popN(k, std::back_inserter(expected_values));
+        EXPECT_EQ(peeked_values, expected_values);
+        EXPECT_EQ(max_heap.size(), values_in_int_.size());
+    }
+    std::vector<std::string> peeked_strs(2);
+    min_d_heap_.topK(2, peeked_strs.begin());
+    EXPECT_EQ(peeked_strs, (std::vector<std::string> { "A-star", "Bellman-Ford" }));
+    EXPECT_EQ(min_d_heap_.top(), "A-star");
+}
+
+TEST_F(TestHeapFixture, testParallelBuildHeap)
+{
+    // 节点足够多时才会并行建堆，结果应与在单个线程中建堆时相同。
+    for (size_t i = 0; i < 200000; i++) {
+        values_in_int_.push_back(std::rand() % 100000);
+    }
+    auto max_heap = buildMaxDHeap<int, 4>(values_in_int_, 4);
+    auto max_heap_d3 = buildMaxDHeap<int>(3, values_in_int_, 3);
+    auto max_heap_aligned = DAryHeap<int, 8, std::less<int>, CacheAlignedLayout>(8, std::less<int>(),
+        values_in_int_, 5);
+    std::sort(values_in_int_.begin(), values_in_int_.end(), std::greater<int> {});
+    for (int expected_value : values_in_int_) {
+        ASSERT_EQ(max_heap.popAndReturn(), expected_value);
+        ASSERT_EQ(max_heap_d3.popAndReturn(), expected_value);
+        ASSERT_EQ(max_heap_aligned.popAndReturn(), expected_value);
+    }
+    // 节点较少时退化为单线程建堆。
+    auto min_heap = buildMinDHeap<std::string>(2, values_in_str_, 8);
+    std::sort(values_in_str_.begin(), values_in_str_.end());
+    for (const auto& expected_str : values_in_str_) {
+        EXPECT_EQ(min_heap.popAndReturn(), expected_str);
+    }
+}
+
+// 记录分配次数的内存资源，实际的分配交给上游资源。
+class CountingResource : public std::pmr::memory_resource {
+public:
+    size_t num_allocations_ { 0 };
+
+private:
+    void* do_allocate(size_t bytes, size_t alignment) override
+    {
+        num_allocations_ += 1;
+        return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+    }
+    void do_deallocate(void* ptr, size_t bytes, size_t alignment) override
+    {
+        std::pmr::new_delete_resource()->deallocate(ptr, bytes, alignment);
+    }
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+};
+
+TEST_F(TestHeapFixture, testPmrAllocator)
+{
+    // 节点存储于指定的内存资源中，行为与使用默认分配器时相同。
+    CountingResource resource;
+    auto max_heap = pmr::createEmptyMaxDHeap<int, 4>(&resource);
+    for (int value : values_in_int_) {
+        max_heap.push(value);
+    }
+    EXPECT_GT(resource.num_allocations_, 0u);
+    EXPECT_TRUE((this->isTwoHeapsEqual<int, decltype(max_heap)>(values_in_int_, max_heap, std::less<int> {})));
+    // 从右值节点数组构造时，分配器相同则直接接管数组，否则转存到指定的内存资源中。
+    std::pmr::vector<int> pmr_values(values_in_int_.begin(), values_in_int_.end(), &resource);
+    size_t num_allocations = resource.num_allocations_;
+    auto adopted_heap = pmr::DAryHeap<int, 4, std::less<int>>(4, std::less<int>(), std::move(pmr_values), &resource);
+    EXPECT_EQ(resource.num_allocations_, num_allocations);
+    EXPECT_EQ(adopted_heap.top(), max_heap.top());
+    std::pmr::monotonic_buffer_resource arena;
+    auto min_heap_str = pmr::DAryHeap<std::string, 3, std::greater<std::string>, CacheAlignedLayout>(3,
+        std::greater<std::string>(), values_in_str_, &arena);
+    EXPECT_TRUE((this->isTwoHeapsEqual<std::string, decltype(min_heap_str)>(values_in_str_, min_heap_str,
+        std::greater<std::string> {})));
+}
+
+TEST_F(TestHeapFixture, testHugePageLayout)
+{
+    // 不小于一个大页的数组按大页对齐，较小的数组使用operator new，两者都可以正常读写。
+    HugePageAllocator<uint64_t> alloc;
+    size_t num_large = HUGE_PAGE_SIZE / sizeof(uint64_t) + 1;
+    uint64_t* large_array = alloc.allocate(num_large);
+#if defined(__linux__)
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(large_array) % HUGE_PAGE_SIZE, 0u);
+#endif
+    large_array[0] = 1;
+    large_array[num_large - 1] = 2;
+    alloc.deallocate(large_array, num_large);
+    uint64_t* small_array = alloc.allocate(16);
+    small_array[15] = 3;
+    alloc.deallocate(small_array, 16);
+    // 映射失败时大数组改用operator new分配，释放时不会被当作映射得到的内存块。
+    auto* fallback_array = static_cast<uint64_t*>(::operator new(num_large * sizeof(uint64_t)));
+#if defined(__linux__)
+    EXPECT_FALSE(HugePageRegistry::unmap(fallback_array, roundUpToHugePage(num_large * sizeof(uint64_t))));
+#endif
+    fallback_array[num_large - 1] = 4;
+    alloc.deallocate(fallback_array, num_large);
+    // 扩容后不小于一个大页时容量按倍数增长，并占满整数个大页。
+    EXPECT_EQ(hugePageGrowth(1024, sizeof(uint64_t)), 0u);
+    size_t grown_capacity = hugePageGrowth(HUGE_PAGE_SIZE / sizeof(uint64_t) + 1, sizeof(uint64_t));
+    EXPECT_GE(grown_capacity, HUGE_PAGE_GROWTH_FACTOR * (HUGE_PAGE_SIZE / sizeof(uint64_t) + 1));
+    EXPECT_EQ(grown_capacity * sizeof(uint64_t) % HUGE_PAGE_SIZE, 0u);
+    EXPECT_LT(roundUpToHugePage(hugePageGrowth(100000, 24) * 24) - hugePageGrowth(100000, 24) * 24, 24u);
+    // 节点数组经过多次扩容后从普通内存转移到大页中，堆的行为不受影响。
+    auto min_heap = DAryHeap<uint64_t, 8, std::greater<uint64_t>, HugePageLayout>(8, std::greater<uint64_t>(),
+        std::vector<uint64_t>());
+    std::mt19937_64 rand_gen(1995);
+    std::vector<uint64_t> values(1 << 19);
+    for (auto& value : values) {
+        value = rand_gen();
+        min_heap.push(value);
+    }
+    auto reserved_min_heap = DAryHeap<uint64_t, 8, std::greater<uint64_t>, HugePageLayout>(8,
+        std::greater<uint64_t>(), std::vector<uint64_t>());
+    reserved_min_heap.reserve(values.size());
+    reserved_min_heap.pushRange(values.begin(), values.end());
+    std::sort(values.begin(), values.end());
+    for (uint64_t expected_value : values) {
+        ASSERT_EQ(min_heap.popAndReturn(), expected_value);
+        ASSERT_EQ(reserved_min_heap.popAndReturn(), expected_value);
+    }
+}
+
+// 检查布局Layout中每个节点与父节点和子节点的关系：节点的位置随插入顺序递增，父节点的位置更小，每组兄弟节点的
+// 位置是连续的，且不会跨越两页。
+template <typename Layout, size_t NODE_SIZE, size_t D>
+bool isPageLayoutConsistent(size_t num_nodes)
+{
+    constexpr size_t NUM_SLOTS = Layout::template PageShape<NODE_SIZE, D>::NUM_SLOTS;
+    auto page_of = [](size_t pos) { return (pos + D - 1) / NUM_SLOTS; };
+    for (size_t idx = 1; idx < num_nodes; idx++) {
+        size_t pos = Layout::template nodePos<NODE_SIZE, D>(idx);
+        size_t parent_pos = Layout::template parentPos<NODE_SIZE, D>(pos);
+        size_t first_sibling_pos = Layout::template firstChildPos<NODE_SIZE, D>(parent_pos);
+        if (pos <= Layout::template nodePos<NODE_SIZE, D>(idx - 1) || parent_pos >= pos || pos < first_sibling_pos
+            || pos >= first_sibling_pos + D || page_of(first_sibling_pos) != page_of(first_sibling_pos + D - 1)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+TEST_F(TestHeapFixture, testBHeapLayout)
+{
+    // 64字节的页：d = 2时每页3层共14个节点，d = 4时每页1层共4个节点（第2层放不下）。
+    EXPECT_EQ((BHeapLayout<64>::PageShape<4, 2>::NUM_NODES), 14u);
+    EXPECT_EQ((BHeapLayout<64>::PageShape<4, 4>::NUM_NODES), 4u);
+    EXPECT_EQ((BHeapLayout<>::PageShape<8, 4>::NUM_NODES), 340u);
+    EXPECT_EQ((BHeapLayout<>::PageShape<8, 2>::NUM_NODES), 510u);
+    EXPECT_TRUE((isPageLayoutConsistent<BHeapLayout<64>, 4, 2>(100000)));
+    EXPECT_TRUE((isPageLayoutConsistent<BHeapLayout<64>, 4, 4>(100000)));
+    EXPECT_TRUE((isPageLayoutConsistent<BHeapLayout<>, 8, 4>(100000)));
+    EXPECT_TRUE((isPageLayoutConsistent<BHeapLayout<>, 4, 16>(100000)));
+    // 使用分页布局的堆与使用层序布局的堆的行为相同。
+    for (size_t i = 0; i < 3000; i++) {
+        values_in_int_.push_back(std::rand());
+    }
+    auto max_heap_d2 = DAryHeap<int, 2, std::less<int>, BHeapLayout<64>>(2, std::less<int>(), std::vector<int>());
+    auto max_heap_d16 = DAryHeap<int, 16, std::less<int>, BHeapLayout<>>(16, std::less<int>(), values_in_int_);
+    max_heap_d16.setPopStrategy(PopStrategy::BOTTOM_UP);
+    for (int num_to_push : values_in_int_) {
+        max_heap_d2.push(num_to_push);
+    }
+    // 节点数组按页对齐，根节点位于第0页开头预留的d-1个位置之后。
+    EXPECT_EQ((reinterpret_cast<uintptr_t>(&max_heap_d16.top()) - 15 * sizeof(int)) % MEMORY_PAGE_SIZE, 0u);
+    std::make_heap(values_in_int_.begin(), values_in_int_.end(), std::less<int> {});
+    EXPECT_TRUE((this->isTwoHeapsEqual<int, decltype(max_heap_d2)>(values_in_int_, max_heap_d2, std::less<int> {})));
+    EXPECT_TRUE((this->isTwoHeapsEqual<int, decltype(max_heap_d16)>(values_in_int_, max_heap_d16, std::less<int> {})));
+    // 批量插入、查看和移除节点。
+    auto min_heap = DAryHeap<int, 4, std::greater<int>, BHeapLayout<128>>(4, std::greater<int>(), std::vector<int>());
+    std::vector<int> expected_values;
+    for (size_t num_new_nodes : { 3, 200, 1 }) {
+        std::vector<int> new_values;
+        for (size_t i = 0; i < num_new_nodes; i++) {
+            new_values.push_back(std::rand() % 1000);
+        }
+        min_heap.pushRange(new_values.begin(), new_values.end());
+        expected_values.insert(expected_values.end(), new_values.begin(), new_values.end());
+    }
+    EXPECT_EQ(min_heap.eraseIf([](int value) { return value % 3 == 0; }),
+        static_cast<size_t>(std::count_if(expected_values.begin(), expected_values.end(),
+            [](int value) { return value % 3 == 0; })));
+    expected_values.erase(std::remove_if(expected_values.begin(), expected_values.end(),
+                              [](int value) { return value % 3 == 0; }),
+        expected_values.end());
+    std::sort(expected_values.begin(), expected_values.end());
+    std::vector<int> peeked, popped;
+    min_heap.topK(10, std::back_inserter(peeked));
+    EXPECT_TRUE(std::equal(peeked.begin(), peeked.end(), expected_values.begin()));
+    min_heap.popN(10, std::back_inserter(popped));
+    min_heap.drainSorted(std::back_inserter(popped));
+    EXPECT_EQ(popped, expected_values);
+}
 }
@@ -0,0 +1,138 @@
+#include <gtest/gtest.h>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "../src/element_index.hpp"
+#include "test_data_generator.h"
+
+namespace custom_cont::test_element_index {
+constexpr int RAND_SEED = 20240520;
+
+TEST(TestElementIndex, testInsertFindErase)
+{
+    // 与std::unordered_map对比，取值范围较小的元素会被反复插入和移除，从而覆盖移除元素时桶的前移。
+    std::mt19937 rand_gen(RAND_SEED);
+    std::uniform_int_distribution<int> rand_dist(0, 3000);
+    ElementIndex<int> index;
+    std::unordered_map<int, ElementIndex<int>::SlotId> expected_slots;
+    for (int i = 0; i < 100000; i++) {
+        int element = rand_dist(rand_gen);
+        auto slot_it = expected_slots.find(element);
+        if (slot_it == expected_slots.end()) {
+            EXPECT_EQ(index.find(element), ElementIndex<int>::NO_SLOT);
+            auto [slot_id, inserted] = index.insert(element);
+            EXPECT_TRUE(inserted);
+            index.pos(slot_id) = static_cast<size_t>(element);
+            expected_slots[element] = slot_id;
+        } else {
+            EXPECT_EQ(index.find(element), slot_it->second);
+            EXPECT_EQ(index.pos(slot_it->second), static_cast<size_t>(element));
+            EXPECT_FALSE(index.insert(element).second);
+            EXPECT_EQ(index.extract(slot_it->second), element);
+            expected_slots.erase(slot_it);
+        }
+        EXPECT_EQ(index.size(), expected_slots.size());
+    }
+    for (const auto& [element, slot_id] : expected_slots) {
+        EXPECT_EQ(index.element(slot_id), element);
+        EXPECT_EQ(index.find(element), slot_id);
+    }
+}
+
+TEST(TestElementIndex, testStableSlots)
+{
+    // 扩容和移除其它元素都不会改变元素所在的槽位，被释放的槽位会被复用。
+    ElementIndex<std::string> index;
+    index.reserve(10);
+    std::vector<ElementIndex<std::string>::SlotId> slot_ids;
+    for (int i = 0; i < 1000; i++) {
+        slot_ids.push_back(index.insert(std::to_string(i)).first);
+    }
+    for (int i = 0; i < 1000; i += 2) {
+        index.erase(slot_ids[i]);
+    }
+    for (int i = 1; i < 1000; i += 2) {
+        EXPECT_EQ(index.find(std::to_string(i)), slot_ids[i]);
+        EXPECT_EQ(index.element(slot_ids[i]), std::to_string(i));
+    }
+    auto [reused_slot_id, inserted] = index.insert("reused");
+    EXPECT_TRUE(inserted);
+    EXPECT_EQ(reused_slot_id % 2, 0u);
+    EXPECT_LT(reused_slot_id, 1000u);
+    EXPECT_EQ(index.size(), 501u);
+}
+
+TEST(TestElementIndex, testCustomHasher)
+{
+    using NodeIndex = ElementIndex<MyNode, MyNodeHasher>;
+    NodeIndex index;
+    for (int i = 0; i < 100; i++) {
+        index.insert(MyNode(i * 1024, i, i));
+    }
+    // 只比较node_id_，因此g和h不同的节点也被视为同一个元素。
+    EXPECT_FALSE(index.insert(MyNode(2048, 0, 0)).second);
+    EXPECT_NE(index.find(MyNode(99 * 1024, 0, 0)), NodeIndex::NO_SLOT);
+    EXPECT_EQ(index.find(MyNode(1, 0, 0)), NodeIndex::NO_SLOT);
+    // 不执行重复性检测时相同的元素会被存入不同的槽位。
+    auto [duplicate_slot_id, inserted] = index.insert<false>(MyNode(2048, 0, 0));
+    EXPECT_TRUE(inserted);
+    EXPECT_EQ(index.size(), 101u);
+    index.erase(duplicate_slot_id);
+    EXPECT_NE(index.find(MyNode(2048, 0, 0)), NodeIndex::NO_SLOT);
+}
+
+TEST(TestElementIndex, testClear)
+{
+    ElementIndex<std::string> index;
+    std::vector<ElementIndex<std::string>::Handle> handles;
+    for (int i = 0; i < 100; i++) {
+        handles.push_back(index.handleOf(index.insert(std::to_string(i)).first));
+    }
+    index.clear();
+    EXPECT_EQ(index.size(), 0u);
+    EXPECT_EQ(index.find("1"), ElementIndex<std::string>::NO_SLOT);
+    for (const auto& handle : handles) {
+        EXPECT_EQ(index.slotOf(handle), ElementIndex<std::string>::NO_SLOT);
+    }
+    // 清空后槽位从编号最小的开始复用。
+    auto [slot_id, inserted] = index.insert("1");
+    EXPECT_TRUE(inserted);
+    EXPECT_EQ(slot_id, 0u);
+    EXPECT_EQ(index.find("1"), slot_id);
+}
+
+TEST(TestElementIndex, testAssignUnique)
+{
+    // 并行存入的第i个元素位于第i个槽位，之后可以像逐个插入时一样使用索引。
+    std::vector<std::string> strs;
+    for (int i = 0; i < 50000; i++) {
+        strs.push_back(std::to_string(i * 7));
+    }
+    ElementIndex<std::string> str_index;
+    str_index.insert("old");
+    EXPECT_TRUE(str_index.assignUnique(strs, 4));
+    EXPECT_EQ(str_index.size(), strs.size());
+    EXPECT_EQ(str_index.find("old"), ElementIndex<std::string>::NO_SLOT);
+    for (size_t i = 0; i < strs.size(); i++) {
+        EXPECT_EQ(str_index.find(strs[i]), i);
+    }
+    EXPECT_FALSE(str_index.insert(strs[123]).second);
+    str_index.erase(0);
+    EXPECT_EQ(str_index.find(strs[0]), ElementIndex<std::string>::NO_SLOT);
+    EXPECT_EQ(str_index.insert("new").first, 0u);
+    // 不可默认构造的元素，哈希值集中在少数桶中，探测会越过分段的末尾。
+    std::vector<MyNode> nodes;
+    for (int i = 0; i < 20000; i++) {
+        nodes.push_back(MyNode(i % 64 * 1024 + i / 64, i, i));
+    }
+    ElementIndex<MyNode, MyNodeHasher> node_index;
+    EXPECT_TRUE(node_index.assignUnique(nodes, 3));
+    for (size_t i = 0; i < nodes.size(); i++) {
+        EXPECT_EQ(node_index.find(nodes[i]), i);
+    }
+    nodes.push_back(MyNode(5 * 1024 + 7, 0, 0));
+    EXPECT_FALSE(node_index.assignUnique(nodes, 3));
+}
+}
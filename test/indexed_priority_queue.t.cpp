@@ -0,0 +1,227 @@
+#include <algorithm>
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <numeric>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include "../src/indexed_priority_queue.hpp"
+#include "../src/priority_queue.hpp"
+
+namespace custom_cont {
+namespace test_indexed_priority_queue {
+    constexpr int RAND_SEED = 20240501;
+
+    class TestIndexedPriQueueFixture : public ::testing::Test {
+    public:
+        void SetUp() override
+        {
+            // 生成测试数据，优先级的取值范围较小，从而产生大量相同的优先级。
+            std::mt19937 rand_gen(RAND_SEED);
+            std::uniform_int_distribution<int> rand_dist(0, 500);
+            elements_.resize(capacity_);
+            std::iota(elements_.begin(), elements_.end(), 0);
+            std::shuffle(elements_.begin(), elements_.end(), rand_gen);
+            elements_.resize(num_elements_);
+            for (size_t i = 0; i < num_elements_; i++) {
+                priorities_.push_back(rand_dist(rand_gen));
+            }
+        }
+
+        // 将测试数据中的元素和优先级依次插入优先队列pri_queue中。
+        template <typename TPriQueue>
+        void fillPriQueue(TPriQueue& pri_queue) const
+        {
+            for (size_t i = 0; i < num_elements_; i++) {
+                pri_queue.push(elements_[i], priorities_[i]);
+            }
+        }
+
+        // 依次比较两个优先队列出队的优先级，优先级相同的元素的出队顺序可能不同。
+        template <typename TPriQueue, typename TExpectedPriQueue>
+        void expectSamePriorities(TPriQueue& pri_queue, TExpectedPriQueue& expected_pri_queue) const
+        {
+            EXPECT_EQ(pri_queue.size(), expected_pri_queue.size());
+            while (!expected_pri_queue.empty()) {
+                auto [element, pri] = pri_queue.popAndReturn();
+                EXPECT_EQ(pri, expected_pri_queue.topNode().second);
+                EXPECT_FALSE(pri_queue.contains(element));
+                expected_pri_queue.pop();
+            }
+            EXPECT_TRUE(pri_queue.empty());
+        }
+
+        std::vector<int> elements_;
+        std::vector<int> priorities_;
+        size_t capacity_ { 1000 }, num_elements_ { 600 };
+    };
+
+    TEST_F(TestIndexedPriQueueFixture, testContentsEqual)
+    {
+        auto min_pri_queue = createEmptyMinIndexedPriQueue<int, int>(capacity_, 3);
+        auto max_pri_queue = createEmptyMaxIndexedPriQueue<int, int, 16>(capacity_);
+        auto expected_min_pri_queue = createEmptyMinPriQueue<int, int>(3);
+        auto expected_max_pri_queue = createEmptyMaxPriQueue<int, int>(3);
+        this->fillPriQueue(min_pri_queue);
+        this->fillPriQueue(max_pri_queue);
+        this->fillPriQueue(expected_min_pri_queue);
+        this->fillPriQueue(expected_max_pri_queue);
+        for (size_t i = 0; i < num_elements_; i++) {
+            EXPECT_TRUE(min_pri_queue.contains(elements_[i]));
+            EXPECT_EQ(min_pri_queue.getPriority(elements_[i]), priorities_[i]);
+        }
+        this->expectSamePriorities(min_pri_queue, expected_min_pri_queue);
+        this->expectSamePriorities(max_pri_queue, expected_max_pri_queue);
+    }
+
+    TEST_F(TestIndexedPriQueueFixture, testBuildPriQueue)
+    {
+        auto min_pri_queue = IndexedPriQueue<uint32_t, double, 4, std::greater<>>(4, PriQueueTyp::MIN_PRI_QUEUE,
+            std::greater<> {}, capacity_, std::vector<uint32_t>(elements_.begin(), elements_.end()),
+            std::vector<double>(priorities_.begin(), priorities_.end()));
+        auto expected_min_pri_queue = createEmptyMinPriQueue<int, int>(4);
+        this->fillPriQueue(expected_min_pri_queue);
+        this->expectSamePriorities(min_pri_queue, expected_min_pri_queue);
+        EXPECT_THROW((IndexedPriQueue<int, int>(2, PriQueueTyp::MIN_PRI_QUEUE, std::greater<> {}, 10, { 1, 1 },
+                         { 1, 2 })),
+            std::logic_error);
+        EXPECT_THROW((IndexedPriQueue<int, int>(2, PriQueueTyp::MIN_PRI_QUEUE, std::greater<> {}, 10, { 1 },
+                         { 1, 2 })),
+            std::invalid_argument);
+    }
+
+    TEST_F(TestIndexedPriQueueFixture, testOutOfCapacity)
+    {
+        auto min_pri_queue = createEmptyMinIndexedPriQueue<int, int>(capacity_);
+        EXPECT_THROW(min_pri_queue.push(-1, 0), std::out_of_range);
+        EXPECT_THROW(min_pri_queue.push(static_cast<int>(capacity_), 0), std::out_of_range);
+        EXPECT_FALSE(min_pri_queue.contains(-1));
+        EXPECT_FALSE(min_pri_queue.contains(static_cast<int>(capacity_)));
+        EXPECT_EQ(min_pri_queue.capacity(), capacity_);
+        min_pri_queue.push(0, 0);
+        EXPECT_THROW(min_pri_queue.push(0, 1), std::logic_error);
+        EXPECT_THROW(min_pri_queue.getPriority(1), std::out_of_range);
+        min_pri_queue.pop();
+        EXPECT_THROW(min_pri_queue.pop(), std::out_of_range);
+        EXPECT_THROW(min_pri_queue.top(), std::out_of_range);
+    }
+
+    TEST_F(TestIndexedPriQueueFixture, testUpdatePri)
+    {
+        auto min_pri_queue = createEmptyMinIndexedPriQueue<int, int, 8>(capacity_);
+        auto max_pri_queue = createEmptyMaxIndexedPriQueue<int, int>(capacity_, 5);
+        this->fillPriQueue(min_pri_queue);
+        this->fillPriQueue(max_pri_queue);
+        auto expected_min_priorities = priorities_, expected_max_priorities = priorities_;
+        for (size_t i = 0; i < num_elements_; i += 3) {
+            min_pri_queue.updatePriority(elements_[i], priorities_[i] - 100);
+            expected_min_priorities[i] -= 100;
+            max_pri_queue.updatePriority(elements_[i], priorities_[i] + 100);
+            expected_max_priorities[i] += 100;
+        }
+        // 优先级也可以向远离堆顶的方向改变。
+        for (size_t i = 1; i < num_elements_; i += 3) {
+            min_pri_queue.updatePriority(elements_[i], priorities_[i] + 100);
+            expected_min_priorities[i] += 100;
+            max_pri_queue.updatePriority(elements_[i], priorities_[i] - 100);
+            expected_max_priorities[i] -= 100;
+        }
+        EXPECT_THROW(min_pri_queue.updatePriority(elements_[num_elements_], 0), std::out_of_range);
+        for (size_t i = 0; i < num_elements_; i++) {
+            EXPECT_EQ(min_pri_queue.getPriority(elements_[i]), expected_min_priorities[i]);
+            EXPECT_EQ(max_pri_queue.getPriority(elements_[i]), expected_max_priorities[i]);
+        }
+        std::sort(expected_min_priorities.begin(), expected_min_priorities.end());
+        std::sort(expected_max_priorities.begin(), expected_max_priorities.end(), std::greater<int>());
+        for (size_t i = 0; i < num_elements_; i++) {
+            EXPECT_EQ(min_pri_queue.popAndReturn().second, expected_min_priorities[i]);
+            EXPECT_EQ(max_pri_queue.popAndReturn().second, expected_max_priorities[i]);
+        }
+        EXPECT_TRUE(min_pri_queue.empty());
+        EXPECT_TRUE(max_pri_queue.empty());
+    }
+
+    TEST_F(TestIndexedPriQueueFixture, testReuseElements)
+    {
+        // 出队后的元素可以再次入队。
+        auto min_pri_queue = createEmptyMinIndexedPriQueue<int, int>(capacity_, 4);
+        this->fillPriQueue(min_pri_queue);
+        while (!min_pri_queue.empty()) {
+            min_pri_queue.pop();
+        }
+        this->fillPriQueue(min_pri_queue);
+        auto expected_min_pri_queue = createEmptyMinPriQueue<int, int>(4);
+        this->fillPriQueue(expected_min_pri_queue);
+        EXPECT_EQ(min_pri_queue.top(), min_pri_queue.topNode().first);
+        this->expectSamePriorities(min_pri_queue, expected_min_pri_queue);
+    }
+
+    TEST_F(TestIndexedPriQueueFixture, testEraseAndPushOrUpdate)
+    {
+        auto min_pri_queue = createEmptyMinIndexedPriQueue<int, int, 4>(capacity_);
+        this->fillPriQueue(min_pri_queue);
+        std::vector<int> expected_priorities;
+        for (size_t i = 0; i < num_elements_; i++) {
+            if (i % 2 == 0) {
+                min_pri_queue.erase(elements_[i]);
+                EXPECT_FALSE(min_pri_queue.contains(elements_[i]));
+            } else {
+                EXPECT_FALSE(min_pri_queue.pushOrUpdate(elements_[i], priorities_[i] - 250));
+                expected_priorities.push_back(priorities_[i] - 250);
+            }
+        }
+        EXPECT_THROW(min_pri_queue.erase(elements_[0]), std::out_of_range);
+        EXPECT_TRUE(min_pri_queue.pushOrUpdate(elements_[0], 0));
+        expected_priorities.push_back(0);
+        std::sort(expected_priorities.begin(), expected_priorities.end());
+        for (const auto& expected_pri : expected_priorities) {
+            EXPECT_EQ(min_pri_queue.popAndReturn().second, expected_pri);
+        }
+        EXPECT_TRUE(min_pri_queue.empty());
+    }
+    // 复制时可以按需抛出异常的优先级，用于模拟向堆中添加节点失败。
+    struct ThrowingPri {
+        static inline bool throw_on_copy_ = false;
+        int value_ { 0 };
+
+        ThrowingPri(int value)
+            : value_(value)
+        {
+        }
+        ThrowingPri(const ThrowingPri& other)
+            : value_(other.value_)
+        {
+            if (throw_on_copy_) {
+                throw std::runtime_error("Failed to copy the priority!!!");
+            }
+        }
+        ThrowingPri(ThrowingPri&&) noexcept = default;
+        ThrowingPri& operator=(const ThrowingPri&) = default;
+        ThrowingPri& operator=(ThrowingPri&&) noexcept = default;
+        bool operator>(const ThrowingPri& other) const noexcept { return value_ > other.value_; }
+    };
+
+    TEST_F(TestIndexedPriQueueFixture, testPushFailure)
+    {
+        auto min_pri_queue = IndexedPriQueue<int, ThrowingPri, 4, std::greater<>>(
+            4, PriQueueTyp::MIN_PRI_QUEUE, std::greater<> {}, 8);
+        min_pri_queue.push(1, ThrowingPri(1));
+        ThrowingPri pri(0);
+        ThrowingPri::throw_on_copy_ = true;
+        EXPECT_THROW(min_pri_queue.push(0, pri), std::runtime_error);
+        EXPECT_THROW(min_pri_queue.pushOrUpdate(2, pri), std::runtime_error);
+        ThrowingPri::throw_on_copy_ = false;
+        // 添加节点失败的元素不在队列中，之后可以正常插入。
+        EXPECT_EQ(min_pri_queue.size(), 1u);
+        EXPECT_FALSE(min_pri_queue.contains(0));
+        EXPECT_FALSE(min_pri_queue.contains(2));
+        min_pri_queue.push(0, pri);
+        min_pri_queue.push(2, ThrowingPri(2));
+        for (int expected_element = 0; expected_element < 3; expected_element++) {
+            EXPECT_EQ(min_pri_queue.popAndReturn().first, expected_element);
+        }
+        EXPECT_TRUE(min_pri_queue.empty());
+    }
+}
+}
@@ -0,0 +1,116 @@
+#include <algorithm>
+#include <functional>
+#include <gtest/gtest.h>
+#include <optional>
+#include <random>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "../src/inline_d_ary_heap.hpp"
+
+namespace custom_cont::test_inline_d_ary_heap {
+constexpr int RAND_SEED = 20240801;
+
+// 生成包含num_data个随机整数的数据集。
+std::vector<int> genIntsForTest(size_t num_data)
+{
+    std::mt19937 rand_gen(RAND_SEED);
+    std::uniform_int_distribution<int> rand_dist(0, 1000);
+    std::vector<int> dataset(num_data);
+    for (auto& data : dataset) {
+        data = rand_dist(rand_gen);
+    }
+    return dataset;
+}
+
+TEST(TestInlineDAryHeap, testSpillToHeapMemory)
+{
+    // 节点数量不超过N时存储于对象内的缓冲区中，超过后转移到堆内存中，取出的顺序不受影响。
+    auto min_heap = createEmptyMinInlineDHeap<int, 16, 4>();
+    EXPECT_EQ(min_heap.inlineCapacity(), 16u);
+    EXPECT_TRUE(min_heap.isInline());
+    auto values = genIntsForTest(40);
+    for (size_t i = 0; i < values.size(); i++) {
+        min_heap.push(values[i]);
+        EXPECT_EQ(min_heap.isInline(), i < 16);
+    }
+    std::sort(values.begin(), values.end());
+    for (int expected_value : values) {
+        ASSERT_FALSE(min_heap.empty());
+        EXPECT_EQ(min_heap.popAndReturn(), expected_value);
+    }
+    EXPECT_TRUE(min_heap.empty());
+    EXPECT_THROW(min_heap.top(), std::out_of_range);
+}
+
+TEST(TestInlineDAryHeap, testBuildFromNodes)
+{
+    std::vector<std::string> values { "Dijkstra", "Bellman-Ford", "A-star", "Hybrid A-star", "RRT", "RRT-star" };
+    InlineDAryHeap<std::string, 8> max_heap(3, std::less<std::string>(), values);
+    EXPECT_TRUE(max_heap.isInline());
+    EXPECT_EQ(max_heap.size(), values.size());
+    max_heap.emplace("PRM");
+    max_heap.setPopStrategy(PopStrategy::BOTTOM_UP);
+    std::vector<std::string> popped;
+    max_heap.drainSorted(std::back_inserter(popped));
+    values.push_back("PRM");
+    std::sort(values.begin(), values.end(), std::greater<std::string>());
+    EXPECT_EQ(popped, values);
+}
+
+TEST(TestInlineDAryHeap, testCopyAndMove)
+{
+    // 复制和移动后每个堆都使用自己的缓冲区，修改其中一个不影响另一个。
+    auto values = genIntsForTest(10);
+    auto max_heap = createEmptyMaxInlineDHeap<int, 32>(2);
+    max_heap.pushRange(values.begin(), values.end());
+    auto copied_heap = max_heap;
+    EXPECT_TRUE(copied_heap.isInline());
+    copied_heap.pop();
+    EXPECT_EQ(max_heap.size(), values.size());
+    EXPECT_EQ(copied_heap.size(), values.size() - 1);
+    auto moved_heap = std::move(max_heap);
+    EXPECT_TRUE(moved_heap.isInline());
+    EXPECT_TRUE(max_heap.empty());
+    EXPECT_EQ(moved_heap.top(), *std::max_element(values.begin(), values.end()));
+    // 被复制的堆已经转移到堆内存中时，复制得到的堆仍然优先使用自己的缓冲区。
+    auto large_values = genIntsForTest(100);
+    auto large_heap = createEmptyMaxInlineDHeap<int, 32>(2);
+    large_heap.pushRange(large_values.begin(), large_values.end());
+    EXPECT_FALSE(large_heap.isInline());
+    copied_heap = large_heap;
+    EXPECT_EQ(copied_heap.size(), large_values.size());
+    moved_heap = std::move(copied_heap);
+    std::sort(large_values.begin(), large_values.end(), std::greater<int>());
+    std::vector<int> popped;
+    moved_heap.popN(large_values.size(), std::back_inserter(popped));
+    EXPECT_EQ(popped, large_values);
+    EXPECT_EQ(large_heap.size(), large_values.size());
+}
+
+TEST(TestInlineDAryHeap, testNoSlicing)
+{
+    // 复制或移动到DAryHeap中得到的堆会继续使用原对象的缓冲区，因此禁止这样的转换。
+    using InlineHeap = InlineDAryHeap<int, 16, 4, std::less<int>>;
+    using BaseHeap
+        = DAryHeap<int, 4, std::less<int>, ImplicitLayout, InlineBufferAllocator<int, 16 * sizeof(int), alignof(int)>>;
+    static_assert(!std::is_constructible_v<BaseHeap, InlineHeap&&>);
+    static_assert(!std::is_constructible_v<BaseHeap, const InlineHeap&>);
+    static_assert(!std::is_convertible_v<InlineHeap*, BaseHeap*>);
+    // 移动后的堆使用自己的缓冲区，原对象销毁后仍然可以正常使用。
+    auto values = genIntsForTest(10);
+    std::optional<InlineHeap> source(std::in_place, 4, std::less<int>());
+    source->pushRange(values.begin(), values.end());
+    InlineHeap moved_heap = std::move(*source);
+    source.reset();
+    EXPECT_TRUE(moved_heap.isInline());
+    moved_heap.push(1001);
+    std::sort(values.begin(), values.end(), std::greater<int>());
+    values.insert(values.begin(), 1001);
+    std::vector<int> popped;
+    moved_heap.drainSorted(std::back_inserter(popped));
+    EXPECT_EQ(popped, values);
+}
+}
@@ -0,0 +1,133 @@
+#include <algorithm>
+#include <gtest/gtest.h>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "../src/lazy_priority_queue.hpp"
+#include "../src/priority_queue.hpp"
+#include "test_data_generator.h"
+
+namespace custom_cont {
+namespace test_lazy_priority_queue {
+    constexpr int RAND_SEED = 20240610;
+
+    class TestLazyPriQueueFixture : public ::testing::Test {
+    public:
+        void SetUp() override
+        {
+            // 生成测试数据，优先级的取值范围较小，从而产生大量相同的优先级。
+            std::mt19937 rand_gen(RAND_SEED);
+            std::uniform_int_distribution<int> rand_dist(0, 500);
+            for (int i = 0; i < num_elements_; i++) {
+                elements_.push_back(std::to_string(i * 7));
+                priorities_.push_back(rand_dist(rand_gen));
+            }
+        }
+
+        // 依次比较两个优先队列出队的优先级，优先级相同的元素的出队顺序可能不同。
+        template <typename TPriQueue, typename TExpectedPriQueue>
+        void expectSamePriorities(TPriQueue& pri_queue, TExpectedPriQueue& expected_pri_queue) const
+        {
+            EXPECT_EQ(pri_queue.size(), expected_pri_queue.size());
+            while (!expected_pri_queue.empty()) {
+                EXPECT_EQ(pri_queue.topNode().second, expected_pri_queue.topNode().second);
+                auto [element, pri] = pri_queue.popAndReturn();
+                EXPECT_EQ(pri, expected_pri_queue.topNode().second);
+                EXPECT_FALSE(pri_queue.contains(element));
+                expected_pri_queue.pop();
+            }
+            EXPECT_TRUE(pri_queue.empty());
+        }
+
+        std::vector<std::string> elements_;
+        std::vector<int> priorities_;
+        int num_elements_ { 600 };
+    };
+
+    TEST_F(TestLazyPriQueueFixture, testContentsEqual)
+    {
+        auto min_pri_queue = createEmptyMinLazyPriQueue<std::string, int>(3);
+        auto max_pri_queue = LazyPriQueue<std::string, int, std::hash<std::string>, 4, std::less<>>(4,
+            PriQueueTyp::MAX_PRI_QUEUE, std::less<> {}, elements_, priorities_);
+        auto expected_min_pri_queue = buildMinPriQueue<std::string, int>(3, elements_, priorities_);
+        auto expected_max_pri_queue = buildMaxPriQueue<std::string, int>(3, elements_, priorities_);
+        for (int i = 0; i < num_elements_; i++) {
+            min_pri_queue.push(elements_[i], priorities_[i]);
+        }
+        for (int i = 0; i < num_elements_; i++) {
+            EXPECT_TRUE(min_pri_queue.contains(elements_[i]));
+            EXPECT_EQ(min_pri_queue.getPriority(elements_[i]), priorities_[i]);
+        }
+        EXPECT_THROW(min_pri_queue.push(elements_[0], 0), std::logic_error);
+        EXPECT_THROW((createEmptyMinLazyPriQueue<std::string, int>().updatePriority("RRT", 1)), std::out_of_range);
+        EXPECT_THROW((LazyPriQueue<std::string, int>(2, PriQueueTyp::MIN_PRI_QUEUE, std::greater<> {},
+                         { "RRT", "RRT" }, { 1, 2 })),
+            std::logic_error);
+        EXPECT_THROW((LazyPriQueue<std::string, int>(2, PriQueueTyp::MIN_PRI_QUEUE, std::greater<> {}, { "RRT" },
+                         { 1, 2 })),
+            std::invalid_argument);
+        this->expectSamePriorities(min_pri_queue, expected_min_pri_queue);
+        this->expectSamePriorities(max_pri_queue, expected_max_pri_queue);
+        EXPECT_THROW(min_pri_queue.pop(), std::out_of_range);
+        EXPECT_THROW(min_pri_queue.top(), std::out_of_range);
+    }
+
+    TEST_F(TestLazyPriQueueFixture, testUpdateAndErase)
+    {
+        // 反复向两个方向更新优先级并移除部分元素，结果应当与PriQueue相同。
+        auto min_pri_queue = createEmptyMinLazyPriQueue<std::string, int, 4>();
+        auto expected_min_pri_queue = createEmptyMinPriQueue<std::string, int, 4>();
+        std::mt19937 rand_gen(RAND_SEED);
+        std::uniform_int_distribution<int> rand_dist(-1000, 1000);
+        for (int i = 0; i < num_elements_; i++) {
+            min_pri_queue.push(elements_[i], priorities_[i]);
+            expected_min_pri_queue.push(elements_[i], priorities_[i]);
+        }
+        for (int round = 0; round < 20; round++) {
+            for (int i = round % 3; i < num_elements_; i += 3) {
+                if (!expected_min_pri_queue.contains(elements_[i])) {
+                    continue;
+                }
+                int pri = rand_dist(rand_gen);
+                min_pri_queue.updatePriority(elements_[i], pri);
+                expected_min_pri_queue.updatePriority(elements_[i], pri);
+                EXPECT_EQ(min_pri_queue.getPriority(elements_[i]), pri);
+            }
+            EXPECT_EQ(min_pri_queue.topNode().second, expected_min_pri_queue.topNode().second);
+            // 失效的节点数量始终不超过有效节点数量与64中的较大者。
+            EXPECT_LE(min_pri_queue.numEntries(), min_pri_queue.size() + std::max<size_t>(min_pri_queue.size(), 64));
+            const auto& element_to_erase = elements_[round * 7];
+            if (expected_min_pri_queue.contains(element_to_erase)) {
+                min_pri_queue.erase(element_to_erase);
+                expected_min_pri_queue.erase(element_to_erase);
+            }
+            EXPECT_THROW(min_pri_queue.erase(element_to_erase), std::out_of_range);
+            min_pri_queue.pop();
+            expected_min_pri_queue.pop();
+        }
+        // 被移除的元素可以重新插入，之前遗留的失效节点不会影响它。
+        for (int i = 0; i < 20; i++) {
+            const auto& element = elements_[i * 7];
+            int pri = rand_dist(rand_gen);
+            bool inserted = min_pri_queue.pushOrUpdate(element, pri);
+            EXPECT_EQ(inserted, expected_min_pri_queue.pushOrUpdate(element, pri).second);
+        }
+        this->expectSamePriorities(min_pri_queue, expected_min_pri_queue);
+    }
+
+    TEST_F(TestLazyPriQueueFixture, testCustomHasher)
+    {
+        auto min_pri_queue = createEmptyMinLazyPriQueue<MyNode, int, MyNodeHasher>(2);
+        for (int i = 0; i < 100; i++) {
+            min_pri_queue.push(MyNode(i, 100 - i, 0), 100 - i);
+        }
+        min_pri_queue.updatePriority(MyNode(0, 0, 0), -1);
+        EXPECT_EQ(min_pri_queue.top().node_id_, 0);
+        min_pri_queue.setPopStrategy(PopStrategy::BOTTOM_UP);
+        EXPECT_EQ(min_pri_queue.popAndReturn().second, -1);
+        EXPECT_EQ(min_pri_queue.popAndReturn().first.node_id_, 99);
+        EXPECT_EQ(min_pri_queue.size(), 98u);
+    }
+}
+}
@@ -1,6 +1,10 @@
+#include <algorithm>
 #include <functional>
 #include <gtest/gtest.h>
 #include <iostream>
+#include <iterator>
+#include <memory>
+#include <memory_resource>
 #include <queue>
 #include <random>
 #include <string>
@@ -252,12 +256,541 @@ namespace test_priority_queue {
 
     TEST_F(TestPriQueueFixture, testUpdatePriArbitrarily)
     {
-        auto existing_node = *my_nodes_.begin();
-        EXPECT_THROW(min_pri_queue_.updatePriority(existing_node, existing_node.f_ + 10), std::logic_error);
-        EXPECT_NO_THROW(min_pri_queue_.updatePriority(existing_node, existing_node.f_ - 10));
-        auto existing_str = *my_strings_.begin();
-        EXPECT_THROW(max_pri_queue_.updatePriority(existing_str, ""), std::logic_error);
-        EXPECT_NO_THROW(max_pri_queue_.updatePriority(existing_str, existing_str + "233"));
+        // 优先级可以向任意方向改变。
+        for (size_t i = 0; i < num_nodes_; i++) {
+            auto prev_node = MyNode(my_nodes_[i]);
+            my_nodes_[i].f_ += (i % 2 == 0 ? 1 : -1) * (std::rand() % 100 + 1);
+            min_pri_queue_.updatePriority(prev_node, my_nodes_[i].f_);
+        }
+        for (size_t i = 0; i < num_strings_; i++) {
+            auto prev_str = std::string(my_strings_[i]);
+            my_strings_[i] = i % 2 == 0 ? my_strings_[i] + "233" : my_strings_[i].substr(0, my_strings_[i].size() / 2);
+            max_pri_queue_.updatePriority(prev_str, my_strings_[i]);
+        }
+        std::vector<int> expected_priorities;
+        for (const auto& node : my_nodes_) {
+            expected_priorities.push_back(node.f_);
+        }
+        std::sort(expected_priorities.begin(), expected_priorities.end());
+        for (const auto& expected_pri : expected_priorities) {
+            EXPECT_EQ(min_pri_queue_.popAndReturn().second, expected_pri);
+        }
+        auto expected_strings = my_strings_;
+        std::sort(expected_strings.begin(), expected_strings.end(), std::greater<std::string>());
+        for (const auto& expected_str : expected_strings) {
+            EXPECT_TRUE(max_pri_queue_.popAndReturn().second == expected_str);
+        }
+        EXPECT_TRUE(min_pri_queue_.empty());
+        EXPECT_TRUE(max_pri_queue_.empty());
+    }
+
+    TEST_F(TestPriQueueFixture, testEraseAndPushOrUpdate)
+    {
+        std::vector<int> expected_priorities;
+        for (size_t i = 0; i < num_nodes_; i++) {
+            if (i % 3 == 0) {
+                min_pri_queue_.erase(my_nodes_[i]);
+                EXPECT_FALSE(min_pri_queue_.contains(my_nodes_[i]));
+                EXPECT_THROW(min_pri_queue_.erase(my_nodes_[i]), std::out_of_range);
+            } else if (i % 3 == 1) {
+                auto [handle, inserted] = min_pri_queue_.pushOrUpdate(my_nodes_[i], my_nodes_[i].f_ + 50);
+                EXPECT_FALSE(inserted);
+                EXPECT_EQ(min_pri_queue_.getPriority(handle), my_nodes_[i].f_ + 50);
+                expected_priorities.push_back(my_nodes_[i].f_ + 50);
+            } else {
+                expected_priorities.push_back(my_nodes_[i].f_);
+            }
+        }
+        // 被移除的元素通过pushOrUpdate重新插入队列中。
+        for (size_t i = 0; i < num_nodes_; i += 6) {
+            auto [handle, inserted] = min_pri_queue_.pushOrUpdate(my_nodes_[i], -static_cast<int>(i));
+            EXPECT_TRUE(inserted);
+            EXPECT_TRUE(min_pri_queue_.getElement(handle) == my_nodes_[i]);
+            expected_priorities.push_back(-static_cast<int>(i));
+        }
+        EXPECT_EQ(min_pri_queue_.size(), expected_priorities.size());
+        std::sort(expected_priorities.begin(), expected_priorities.end());
+        for (const auto& expected_pri : expected_priorities) {
+            EXPECT_EQ(min_pri_queue_.popAndReturn().second, expected_pri);
+        }
+        EXPECT_TRUE(min_pri_queue_.empty());
+    }
+
+    TEST_F(TestPriQueueFixture, testCompileTimeArity)
+    {
+        auto min_pri_queue_d4 = createEmptyMinPriQueue<MyNode, int, 4, MyNodeHasher>();
+        auto max_pri_queue_d8 = buildMaxPriQueue<std::string, std::string, 8>(my_strings_, my_strings_);
+        for (const auto& node : my_nodes_) {
+            min_pri_queue_d4.push(node, node.f_);
+        }
+        auto [std_min_pri_queue, std_max_pri_queue] = this->buildSTDPriQueue();
+        for (size_t i = 0; i < num_nodes_; i++) {
+            EXPECT_TRUE(min_pri_queue_d4.top() == std_min_pri_queue.top());
+            min_pri_queue_d4.pop();
+            std_min_pri_queue.pop();
+        }
+        EXPECT_TRUE(min_pri_queue_d4.empty());
+        for (size_t i = 0; i < num_strings_; i++) {
+            EXPECT_TRUE(max_pri_queue_d8.top() == std_max_pri_queue.top());
+            max_pri_queue_d8.pop();
+            std_max_pri_queue.pop();
+        }
+        EXPECT_TRUE(max_pri_queue_d8.empty());
+    }
+
+    TEST_F(TestPriQueueFixture, testEmplace)
+    {
+        auto min_pri_queue = createEmptyMinPriQueue<MyNode, int, MyNodeHasher>(4);
+        for (const auto& node : my_nodes_) {
+            min_pri_queue.emplace(std::piecewise_construct, std::forward_as_tuple(node.node_id_, node.g_, node.h_),
+                std::forward_as_tuple(node.f_));
+        }
+        EXPECT_THROW(min_pri_queue.emplace(my_nodes_.front(), my_nodes_.front().f_), std::logic_error);
+        EXPECT_EQ(min_pri_queue.size(), num_nodes_);
+        auto [std_min_pri_queue, std_max_pri_queue] = this->buildSTDPriQueue();
+        for (size_t i = 0; i < num_nodes_; i++) {
+            EXPECT_TRUE(min_pri_queue.top() == std_min_pri_queue.top());
+            EXPECT_EQ(min_pri_queue.getPriority(std_min_pri_queue.top()), std_min_pri_queue.top().f_);
+            min_pri_queue.pop();
+            std_min_pri_queue.pop();
+        }
+        EXPECT_TRUE(min_pri_queue.empty());
+    }
+
+    TEST_F(TestPriQueueFixture, testBottomUpPopStrategy)
+    {
+        min_pri_queue_.setPopStrategy(PopStrategy::BOTTOM_UP);
+        max_pri_queue_.setPopStrategy(PopStrategy::BOTTOM_UP);
+        EXPECT_EQ(min_pri_queue_.popStrategy(), PopStrategy::BOTTOM_UP);
+        auto [std_min_pri_queue, std_max_pri_queue] = this->buildSTDPriQueue();
+        for (size_t i = 0; i < num_nodes_; i++) {
+            const auto& expected_node = std_min_pri_queue.top();
+            EXPECT_TRUE(min_pri_queue_.top() == expected_node);
+            EXPECT_EQ(min_pri_queue_.getPriority(expected_node), expected_node.f_);
+            auto [node, pri] = min_pri_queue_.popAndReturn();
+            EXPECT_TRUE(node == expected_node);
+            EXPECT_FALSE(min_pri_queue_.contains(node));
+            std_min_pri_queue.pop();
+        }
+        EXPECT_TRUE(min_pri_queue_.empty());
+        for (size_t i = 0; i < num_strings_; i++) {
+            const auto& expected_str = std_max_pri_queue.top();
+            EXPECT_TRUE(max_pri_queue_.top() == expected_str);
+            EXPECT_TRUE(max_pri_queue_.getPriority(expected_str) == expected_str);
+            max_pri_queue_.pop();
+            EXPECT_FALSE(max_pri_queue_.contains(expected_str));
+            std_max_pri_queue.pop();
+        }
+        EXPECT_TRUE(max_pri_queue_.empty());
+    }
+
+    TEST_F(TestPriQueueFixture, testCacheAlignedLayout)
+    {
+        auto max_pri_queue = PriQueue<std::string, std::string, std::hash<std::string>, 4, std::less<>,
+            CacheAlignedLayout>(4, PriQueueTyp::MAX_PRI_QUEUE, std::less<> {}, my_strings_, my_strings_);
+        auto empty_max_pri_queue = PriQueue<std::string, std::string, std::hash<std::string>, DYNAMIC_ARITY,
+            std::less<>, CacheAlignedLayout>(3, PriQueueTyp::MAX_PRI_QUEUE, std::less<> {},
+            std::vector<std::string>(), std::vector<std::string>());
+        for (const auto& str : my_strings_) {
+            empty_max_pri_queue.push(str, str);
+        }
+        auto [std_min_pri_queue, std_max_pri_queue] = this->buildSTDPriQueue();
+        for (size_t i = 0; i < num_strings_; i++) {
+            const auto& expected_str = std_max_pri_queue.top();
+            EXPECT_TRUE(max_pri_queue.getPriority(expected_str) == expected_str);
+            EXPECT_TRUE(max_pri_queue.popAndReturn().first == expected_str);
+            EXPECT_TRUE(empty_max_pri_queue.topNode().second == expected_str);
+            empty_max_pri_queue.pop();
+            std_max_pri_queue.pop();
+        }
+        EXPECT_TRUE(max_pri_queue.empty());
+        EXPECT_TRUE(empty_max_pri_queue.empty());
+    }
+
+    TEST_F(TestPriQueueFixture, testSoaNodeArray)
+    {
+        // 优先级为int且D为16时下沉过程会使用向量指令选择子节点。
+        auto min_pri_queue = PriQueue<MyNode, int, MyNodeHasher, 16, std::greater<>, ImplicitLayout,
+            SoaNodeArray>(16, PriQueueTyp::MIN_PRI_QUEUE, std::greater<> {}, std::vector<MyNode>(), std::vector<int>());
+        for (const auto& node : my_nodes_) {
+            min_pri_queue.push(node, node.f_ + 10);
+        }
+        for (const auto& node : my_nodes_) {
+            min_pri_queue.updatePriority(node, node.f_);
+        }
+        auto max_pri_queue = PriQueue<std::string, std::string, std::hash<std::string>, 4, std::less<>,
+            CacheAlignedLayout, SoaNodeArray>(4, PriQueueTyp::MAX_PRI_QUEUE, std::less<> {}, my_strings_, my_strings_);
+        max_pri_queue.setPopStrategy(PopStrategy::BOTTOM_UP);
+        auto [std_min_pri_queue, std_max_pri_queue] = this->buildSTDPriQueue();
+        for (size_t i = 0; i < num_nodes_; i++) {
+            const auto& expected_node = std_min_pri_queue.top();
+            EXPECT_TRUE(min_pri_queue.topNode().first == expected_node);
+            EXPECT_EQ(min_pri_queue.topNode().second, expected_node.f_);
+            auto [node, pri] = min_pri_queue.popAndReturn();
+            EXPECT_TRUE(node == expected_node);
+            EXPECT_FALSE(min_pri_queue.contains(node));
+            std_min_pri_queue.pop();
+        }
+        EXPECT_TRUE(min_pri_queue.empty());
+        for (size_t i = 0; i < num_strings_; i++) {
+            const auto& expected_str = std_max_pri_queue.top();
+            EXPECT_TRUE(max_pri_queue.getPriority(expected_str) == expected_str);
+            EXPECT_TRUE(max_pri_queue.popAndReturn().first == expected_str);
+            std_max_pri_queue.pop();
+        }
+        EXPECT_TRUE(max_pri_queue.empty());
+    }
+
+    TEST_F(TestPriQueueFixture, testReserveAndReuse)
+    {
+        auto max_pri_queue = createEmptyMaxPriQueue<std::string, std::string>(4);
+        max_pri_queue.reserve(num_strings_);
+        // 元素出队后可以再次入队，此时会复用已释放的存储空间。
+        for (int round = 0; round < 3; round++) {
+            for (const auto& str : my_strings_) {
+                max_pri_queue.push(str, str);
+            }
+            auto [std_min_pri_queue, std_max_pri_queue] = this->buildSTDPriQueue();
+            for (size_t i = 0; i < num_strings_; i++) {
+                EXPECT_TRUE(max_pri_queue.popAndReturn().first == std_max_pri_queue.top());
+                std_max_pri_queue.pop();
+            }
+            EXPECT_TRUE(max_pri_queue.empty());
+        }
+        std::vector<std::string> duplicate_strings { "A-star", "Dijkstra", "A-star" };
+        EXPECT_THROW((buildMinPriQueue<std::string, int>(2, duplicate_strings, std::vector<int> { 1, 2, 3 })),
+            std::logic_error);
+    }
+
+    TEST_F(TestPriQueueFixture, testHandles)
+    {
+        auto min_pri_queue = createEmptyMinPriQueue<MyNode, int, MyNodeHasher>(4);
+        std::vector<PriQueue<MyNode, int, MyNodeHasher>::Handle> handles;
+        for (const auto& node : my_nodes_) {
+            handles.push_back(min_pri_queue.push(node, node.f_));
+        }
+        // 通过句柄移除三分之一的元素，并降低其余元素的优先级。
+        std::vector<int> expected_priorities;
+        for (size_t i = 0; i < my_nodes_.size(); i++) {
+            EXPECT_TRUE(min_pri_queue.getElement(handles[i]) == my_nodes_[i]);
+            if (i % 3 == 0) {
+                min_pri_queue.erase(handles[i]);
+                EXPECT_FALSE(min_pri_queue.contains(handles[i]));
+                EXPECT_FALSE(min_pri_queue.contains(my_nodes_[i]));
+                EXPECT_THROW(min_pri_queue.updatePriority(handles[i], 0), std::out_of_range);
+                EXPECT_THROW(min_pri_queue.erase(handles[i]), std::out_of_range);
+            } else {
+                min_pri_queue.updatePriority(handles[i], my_nodes_[i].f_ - static_cast<int>(i));
+                EXPECT_EQ(min_pri_queue.getPriority(handles[i]), my_nodes_[i].f_ - static_cast<int>(i));
+                expected_priorities.push_back(my_nodes_[i].f_ - static_cast<int>(i));
+            }
+        }
+        EXPECT_EQ(min_pri_queue.size(), expected_priorities.size());
+        // 被移除元素的槽位复用后旧的句柄仍然无效。
+        auto new_handle = min_pri_queue.push(my_nodes_[0], my_nodes_[0].f_);
+        expected_priorities.push_back(my_nodes_[0].f_);
+        EXPECT_FALSE(min_pri_queue.contains(handles[0]));
+        EXPECT_TRUE(min_pri_queue.contains(new_handle));
+        EXPECT_TRUE(min_pri_queue.getHandle(my_nodes_[0]).slot_id_ == new_handle.slot_id_);
+        std::sort(expected_priorities.begin(), expected_priorities.end());
+        for (const auto& expected_pri : expected_priorities) {
+            EXPECT_EQ(min_pri_queue.popAndReturn().second, expected_pri);
+        }
+        EXPECT_TRUE(min_pri_queue.empty());
+        EXPECT_FALSE(min_pri_queue.contains(new_handle));
+    }
+
+    TEST_F(TestPriQueueFixture, testPushRange)
+    {
+        // 先逐个插入少量元素，其余元素分成大小不同的两批插入，分别覆盖逐个上浮和自底向上重建。
+        auto min_pri_queue = createEmptyMinPriQueue<MyNode, int, MyNodeHasher>(4);
+        std::vector<int> priorities;
+        for (const auto& node : my_nodes_) {
+            priorities.push_back(node.f_);
+        }
+        size_t num_pushed = my_nodes_.size() / 8, num_in_first_batch = 2;
+        for (size_t i = 0; i < num_pushed; i++) {
+            min_pri_queue.push(my_nodes_[i], priorities[i]);
+        }
+        min_pri_queue.pushRange(my_nodes_.begin() + num_pushed, my_nodes_.begin() + num_pushed + num_in_first_batch,
+            priorities.begin() + num_pushed);
+        min_pri_queue.pushRange(my_nodes_.begin() + num_pushed + num_in_first_batch, my_nodes_.end(),
+            priorities.begin() + num_pushed + num_in_first_batch);
+        EXPECT_EQ(min_pri_queue.size(), my_nodes_.size());
+        auto [std_min_pri_queue, std_max_pri_queue] = this->buildSTDPriQueue();
+        auto pri_queue_copy = min_pri_queue;
+        for (size_t i = 0; i < num_nodes_; i++) {
+            EXPECT_TRUE(pri_queue_copy.popAndReturn().first == std_min_pri_queue.top());
+            std_min_pri_queue.pop();
+        }
+        // 遇到重复元素时抛出异常，此前插入的元素仍然保留在队列中，队列仍然是合法的堆。
+        std::vector<std::string> strings { "Dijkstra", "A-star", "Dijkstra", "RRT" };
+        auto max_pri_queue = createEmptyMaxPriQueue<std::string, int>(2);
+        max_pri_queue.push("RRT-star", 0);
+        EXPECT_THROW(max_pri_queue.pushRange(strings.begin(), strings.end(), std::vector<int> { 1, 3, 5, 7 }.begin()),
+            std::logic_error);
+        EXPECT_EQ(max_pri_queue.size(), 3u);
+        EXPECT_FALSE(max_pri_queue.contains("RRT"));
+        EXPECT_EQ(max_pri_queue.popAndReturn().first, "A-star");
+        EXPECT_EQ(max_pri_queue.popAndReturn().first, "Dijkstra");
+        EXPECT_EQ(max_pri_queue.popAndReturn().first, "RRT-star");
+    }
+
+    TEST_F(TestPriQueueFixture, testPopN)
+    {
+        // 出队元素较少时逐个出队，较多时选择后排序，全部出队时一次性清空索引。
+        for (size_t k : { 0, 3, 40, 1000 }) {
+            auto min_pri_queue = min_pri_queue_;
+            auto [std_min_pri_queue, std_max_pri_queue] = this->buildSTDPriQueue();
+            std::vector<std::pair<MyNode, int>> popped_nodes;
+            min_pri_queue.popN(k, std::back_inserter(popped_nodes));
+            EXPECT_EQ(popped_nodes.size(), std::min<size_t>(k, num_nodes_));
+            EXPECT_EQ(min_pri_queue.size(), num_nodes_ - popped_nodes.size());
+            for (const auto& [node, pri] : popped_nodes) {
+                EXPECT_TRUE(node == std_min_pri_queue.top());
+                EXPECT_EQ(pri, node.f_);
+                EXPECT_FALSE(min_pri_queue.contains(node));
+                std_min_pri_queue.pop();
+            }
+            // 重新建堆后索引中记录的位置仍然正确。
+            if (!min_pri_queue.empty()) {
+                const auto& next_node = std_min_pri_queue.top();
+                EXPECT_TRUE(min_pri_queue.top() == next_node);
+                EXPECT_EQ(min_pri_queue.getPriority(next_node), next_node.f_);
+            }
+            std::vector<std::pair<MyNode, int>> remaining_nodes;
+            min_pri_queue.drainSorted(std::back_inserter(remaining_nodes));
+            EXPECT_TRUE(min_pri_queue.empty());
+            for (const auto& [node, pri] : remaining_nodes) {
+                EXPECT_TRUE(node == std_min_pri_queue.top());
+                std_min_pri_queue.pop();
+            }
+            EXPECT_TRUE(std_min_pri_queue.empty());
+        }
+        // 清空后旧的句柄失效，队列可以继续使用。
+        auto max_pri_queue = createEmptyMaxPriQueue<std::string, int>(3);
+        auto handle = max_pri_queue.push("A-star", 1);
+        max_pri_queue.push("RRT", 2);
+        std::vector<std::pair<std::string, int>> popped_strs;
+        max_pri_queue.drainSorted(std::back_inserter(popped_strs));
+        EXPECT_EQ(popped_strs, (std::vector<std::pair<std::string, int>> { { "RRT", 2 }, { "A-star", 1 } }));
+        EXPECT_FALSE(max_pri_queue.contains(handle));
+        EXPECT_FALSE(max_pri_queue.contains("A-star"));
+        auto new_handle = max_pri_queue.push("Dijkstra", 3);
+        EXPECT_TRUE(max_pri_queue.contains(new_handle));
+        EXPECT_FALSE(max_pri_queue.contains(handle));
+        EXPECT_EQ(max_pri_queue.top(), "Dijkstra");
+    }
+
+    TEST_F(TestPriQueueFixture, testTopK)
+    {
+        auto [std_min_pri_queue, std_max_pri_queue] = this->buildSTDPriQueue();
+        for (size_t k : { 0, 1, 5, 30, 1000 }) {
+            std::vector<std::pair<std::string, std::string>> peeked_strs;
+            max_pri_queue_.topK(k, std::back_inserter(peeked_strs));
+            EXPECT_EQ(peeked_strs.size(), std::min<size_t>(k, num_strings_));
+            auto std_pri_queue_copy = std_max_pri_queue;
+            for (const auto& [str, pri] : peeked_strs) {
+                EXPECT_EQ(str, std_pri_queue_copy.top());
+                EXPECT_EQ(pri, str);
+                std_pri_queue_copy.pop();
+            }
+            EXPECT_EQ(max_pri_queue_.size(), static_cast<size_t>(num_strings_));
+        }
+        // 也可以只取出对队列中元素和优先级的引用。
+        std::vector<std::pair<const MyNode&, const int&>> peeked_nodes;
+        min_pri_queue_.topK(3, std::back_inserter(peeked_nodes));
+        for (const auto& [node, pri] : peeked_nodes) {
+            EXPECT_TRUE(node == std_min_pri_queue.top());
+            EXPECT_EQ(&node, &min_pri_queue_.getElement(min_pri_queue_.getHandle(node)));
+            std_min_pri_queue.pop();
+        }
+    }
+
+    TEST_F(TestPriQueueFixture, testParallelBuild)
+    {
+        // 节点足够多时并行建立索引和建堆，结果应与在单个线程中构造时相同。
+        std::vector<std::string> elements;
+        std::vector<int> priorities;
+        std::mt19937 rand_gen(RAND_SEED);
+        std::uniform_int_distribution<int> rand_dist(0, 1000);
+        for (int i = 0; i < 100000; i++) {
+            elements.push_back("node" + std::to_string(i));
+            priorities.push_back(rand_dist(rand_gen));
+        }
+        auto serial_pri_queue = buildMinPriQueue<std::string, int, 4>(elements, priorities);
+        auto parallel_pri_queue = buildMinPriQueue<std::string, int, 4>(elements, priorities, 4);
+        auto parallel_pri_queue_d3 = buildMinPriQueue<std::string, int>(3, elements, priorities, 3);
+        for (size_t i = 0; i < elements.size(); i += 97) {
+            EXPECT_TRUE(parallel_pri_queue.contains(elements[i]));
+            EXPECT_EQ(parallel_pri_queue.getPriority(elements[i]), priorities[i]);
+        }
+        EXPECT_FALSE(parallel_pri_queue.contains("node100000"));
+        while (!serial_pri_queue.empty()) {
+            int expected_pri = serial_pri_queue.popAndReturn().second;
+            auto node = parallel_pri_queue.popAndReturn();
+            ASSERT_EQ(node.second, expected_pri);
+            ASSERT_EQ(parallel_pri_queue_d3.popAndReturn().second, expected_pri);
+            EXPECT_FALSE(parallel_pri_queue.contains(node.first));
+        }
+        EXPECT_TRUE(parallel_pri_queue.empty());
+        // 并行构造时同样检测重复的元素。
+        elements.push_back("node12345");
+        priorities.push_back(0);
+        EXPECT_THROW((buildMinPriQueue<std::string, int>(4, elements, priorities, 4)), std::logic_error);
+    }
+
+    TEST_F(TestPriQueueFixture, testBuildFromRvalues)
+    {
+        // 只能移动的元素和优先级也可以用于批量构造。
+        std::vector<std::unique_ptr<int>> ptrs;
+        std::vector<std::unique_ptr<int>> ptr_priorities;
+        for (int i = 0; i < 100; i++) {
+            ptrs.push_back(std::make_unique<int>(i));
+            ptr_priorities.push_back(std::make_unique<int>((i * 37) % 100));
+        }
+        auto ptr_cmp = [](const std::unique_ptr<int>& lhs, const std::unique_ptr<int>& rhs) { return *lhs > *rhs; };
+        auto ptr_pri_queue = PriQueue<std::unique_ptr<int>, std::unique_ptr<int>, std::hash<std::unique_ptr<int>>, 4,
+            decltype(ptr_cmp)>(4, PriQueueTyp::MIN_PRI_QUEUE, ptr_cmp, std::move(ptrs), std::move(ptr_priorities));
+        // 队列可以被移动，移动后依然可以取出元素。
+        auto moved_ptr_pri_queue = std::move(ptr_pri_queue);
+        for (int expected_pri = 0; expected_pri < 100; expected_pri++) {
+            auto [ptr, pri] = moved_ptr_pri_queue.popAndReturn();
+            EXPECT_EQ(*pri, expected_pri);
+            EXPECT_EQ((*ptr * 37) % 100, expected_pri);
+        }
+        // 单线程和多线程构造时元素都被移入队列，结果与从常量引用构造时相同。
+        std::vector<std::string> elements;
+        std::vector<int> priorities;
+        for (int i = 0; i < 50000; i++) {
+            elements.push_back("a long element name to avoid small string optimization " + std::to_string(i));
+            priorities.push_back((i * 7919) % 50000);
+        }
+        auto copied_pri_queue = buildMaxPriQueue<std::string, int, 4>(elements, priorities);
+        for (size_t num_threads : { 1, 4 }) {
+            auto moved_elements = elements;
+            auto moved_priorities = priorities;
+            auto moved_pri_queue = buildMaxPriQueue<std::string, int, 4>(
+                std::move(moved_elements), std::move(moved_priorities), num_threads);
+            EXPECT_TRUE(moved_elements.empty() || moved_elements.front().empty());
+            EXPECT_EQ(moved_pri_queue.size(), elements.size());
+            EXPECT_EQ(moved_pri_queue.getPriority(elements[123]), priorities[123]);
+            auto copied_pri_queue_copy = copied_pri_queue;
+            while (!moved_pri_queue.empty()) {
+                ASSERT_EQ(moved_pri_queue.popAndReturn(), copied_pri_queue_copy.popAndReturn());
+            }
+        }
+        // 元素和优先级的数量不同时在移动元素之前抛出异常，输入保持不变。
+        auto rejected_elements = elements;
+        EXPECT_THROW((buildMaxPriQueue<std::string, int, 4>(std::move(rejected_elements), std::vector<int>(3))),
+            std::invalid_argument);
+        EXPECT_EQ(rejected_elements, elements);
+        std::vector<std::string> duplicate_elements { "RRT", "A-star", "RRT" };
+        EXPECT_THROW((buildMinPriQueue<std::string, int>(2, std::move(duplicate_elements), std::vector<int>(3))),
+            std::logic_error);
+    }
+
+    TEST_F(TestPriQueueFixture, testPmrAllocator)
+    {
+        // 索引和堆都存储于单调缓冲区中，缓冲区不足时才向上游资源申请内存。
+        std::vector<std::byte> buffer(1 << 20);
+        std::pmr::monotonic_buffer_resource arena(buffer.data(), buffer.size(), std::pmr::null_memory_resource());
+        auto min_pri_queue = pmr::createEmptyMinPriQueue<MyNode, int, 4, MyNodeHasher>(&arena);
+        auto [std_min_pri_queue, std_max_pri_queue] = this->buildSTDPriQueue();
+        for (const auto& node : my_nodes_) {
+            min_pri_queue.push(node, node.f_);
+        }
+        EXPECT_THROW(min_pri_queue.push(my_nodes_.front(), 0), std::logic_error);
+        while (!std_min_pri_queue.empty()) {
+            EXPECT_TRUE(min_pri_queue.contains(std_min_pri_queue.top()));
+            EXPECT_TRUE(min_pri_queue.popAndReturn().first == std_min_pri_queue.top());
+            std_min_pri_queue.pop();
+        }
+        // 批量构造时同样使用指定的内存资源。
+        auto max_pri_queue = pmr::PriQueue<std::string, std::string, std::hash<std::string>, 2, std::less<>,
+            ImplicitLayout, SoaNodeArray>(2, PriQueueTyp::MAX_PRI_QUEUE, std::less<> {}, my_strings_, my_strings_,
+            &arena, 2);
+        for (size_t i = 0; i < num_strings_; i++) {
+            EXPECT_EQ(max_pri_queue.popAndReturn().first, std_max_pri_queue.top());
+            std_max_pri_queue.pop();
+        }
+    }
+
+    TEST_F(TestPriQueueFixture, testHugePageLayout)
+    {
+        // 堆中的节点超过一个大页后存储于透明大页中，索引仍然使用默认的分配器。
+        constexpr int NUM_ELEMENTS = 1 << 18;
+        std::vector<int> elements(NUM_ELEMENTS);
+        std::vector<uint64_t> priorities(NUM_ELEMENTS);
+        std::mt19937_64 rand_gen(1995);
+        for (int i = 0; i < NUM_ELEMENTS; i++) {
+            elements[i] = i;
+            priorities[i] = rand_gen() % NUM_ELEMENTS;
+        }
+        auto min_pri_queue = PriQueue<int, uint64_t, std::hash<int>, 8, std::greater<>, HugePageLayout>(8,
+            PriQueueTyp::MIN_PRI_QUEUE, std::greater<> {}, elements, priorities);
+        for (int i = 0; i < NUM_ELEMENTS; i += 3) {
+            min_pri_queue.updatePriority(i, priorities[i] / 2);
+            priorities[i] /= 2;
+        }
+        std::sort(priorities.begin(), priorities.end());
+        for (uint64_t expected_pri : priorities) {
+            ASSERT_EQ(min_pri_queue.popAndReturn().second, expected_pri);
+        }
+        EXPECT_TRUE(min_pri_queue.empty());
+    }
+    // 复制时可以按需抛出异常的优先级，用于模拟向堆中添加节点失败。
+    struct ThrowingPri {
+        static inline bool throw_on_copy_ = false;
+        int value_ { 0 };
+
+        ThrowingPri(int value)
+            : value_(value)
+        {
+        }
+        ThrowingPri(const ThrowingPri& other)
+            : value_(other.value_)
+        {
+            if (throw_on_copy_) {
+                throw std::runtime_error("Failed to copy the priority!!!");
+            }
+        }
+        ThrowingPri(ThrowingPri&&) noexcept = default;
+        ThrowingPri& operator=(const ThrowingPri&) = default;
+        ThrowingPri& operator=(ThrowingPri&&) noexcept = default;
+        bool operator>(const ThrowingPri& other) const noexcept { return value_ > other.value_; }
+    };
+
+    template <template <typename, typename, typename> class NodeArray>
+    void checkPushFailureRollsBack()
+    {
+        auto min_pri_queue = PriQueue<int, ThrowingPri, std::hash<int>, 4, std::greater<>, ImplicitLayout, NodeArray>(
+            4, PriQueueTyp::MIN_PRI_QUEUE, std::greater<> {}, std::vector<int>(), std::vector<ThrowingPri>());
+        min_pri_queue.push(1, ThrowingPri(1));
+        ThrowingPri pri(0);
+        std::vector<int> elements { 2, 3 };
+        std::vector<ThrowingPri> priorities { ThrowingPri(2), ThrowingPri(3) };
+        ThrowingPri::throw_on_copy_ = true;
+        EXPECT_THROW(min_pri_queue.push(0, pri), std::runtime_error);
+        EXPECT_THROW(min_pri_queue.pushOrUpdate(0, pri), std::runtime_error);
+        EXPECT_THROW(min_pri_queue.pushRange(elements.begin(), elements.end(), priorities.begin()), std::runtime_error);
+        ThrowingPri::throw_on_copy_ = false;
+        // 添加节点失败的元素不会留在索引中，之后可以正常插入。
+        EXPECT_EQ(min_pri_queue.size(), 1u);
+        EXPECT_FALSE(min_pri_queue.contains(0));
+        EXPECT_FALSE(min_pri_queue.contains(2));
+        min_pri_queue.push(0, pri);
+        min_pri_queue.pushRange(elements.begin(), elements.end(), priorities.begin());
+        for (int expected_element = 0; expected_element < 4; expected_element++) {
+            EXPECT_EQ(min_pri_queue.popAndReturn().first, expected_element);
+        }
+        EXPECT_TRUE(min_pri_queue.empty());
+    }
+
+    TEST_F(TestPriQueueFixture, testPushFailureRollsBack)
+    {
+        checkPushFailureRollsBack<AosNodeArray>();
+        checkPushFailureRollsBack<SoaNodeArray>();
     }
 }
 }
@@ -0,0 +1,87 @@
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "../src/priority_queue.hpp"
+#include "../src/radix_priority_queue.hpp"
+#include "test_data_generator.h"
+
+namespace custom_cont {
+namespace test_radix_priority_queue {
+    constexpr int RAND_SEED = 20240618;
+
+    TEST(TestRadixPriQueue, testMonotoneHold)
+    {
+        // 每次取出优先级最小的元素后以更大的优先级重新插入，并更新部分元素的优先级，结果应当与PriQueue相同。
+        // 优先级的低10位为元素的编号，使所有优先级互不相同，从而两个队列出队的顺序完全一致。
+        std::mt19937 rand_gen(RAND_SEED);
+        std::uniform_int_distribution<int> rand_dist(0, 2000);
+        auto radix_pri_queue = createEmptyMinRadixPriQueue<MyNode, int, MyNodeHasher>();
+        auto expected_pri_queue = createEmptyMinPriQueue<MyNode, int, MyNodeHasher>(4);
+        auto makePri = [](int f, int node_id) { return f * 1024 + node_id; };
+        for (int i = 0; i < 1000; i++) {
+            MyNode node(i, rand_dist(rand_gen), rand_dist(rand_gen));
+            radix_pri_queue.push(node, makePri(node.f_, i));
+            expected_pri_queue.push(node, makePri(node.f_, i));
+        }
+        for (int i = 0; i < 20000; i++) {
+            auto [expected_node, expected_pri] = expected_pri_queue.popAndReturn();
+            EXPECT_EQ(radix_pri_queue.topNode().second, expected_pri);
+            auto [node, pri] = radix_pri_queue.popAndReturn();
+            EXPECT_TRUE(node == expected_node);
+            EXPECT_EQ(pri, expected_pri);
+            EXPECT_FALSE(radix_pri_queue.contains(node));
+            int new_pri = makePri(pri / 1024 + rand_dist(rand_gen) + 1, node.node_id_);
+            radix_pri_queue.push(node, new_pri);
+            expected_pri_queue.push(node, new_pri);
+            // 将一个元素的优先级向任意方向更新，但不小于当前的最小优先级。
+            MyNode node_to_update(rand_dist(rand_gen) % 1000, 0, 0);
+            int updated_pri = makePri(pri / 1024 + rand_dist(rand_gen) + 1, node_to_update.node_id_);
+            radix_pri_queue.updatePriority(node_to_update, updated_pri);
+            expected_pri_queue.updatePriority(node_to_update, updated_pri);
+            EXPECT_EQ(radix_pri_queue.getPriority(node_to_update), updated_pri);
+        }
+        EXPECT_EQ(radix_pri_queue.size(), expected_pri_queue.size());
+        while (!expected_pri_queue.empty()) {
+            EXPECT_EQ(radix_pri_queue.popAndReturn().second, expected_pri_queue.popAndReturn().second);
+        }
+        EXPECT_TRUE(radix_pri_queue.empty());
+    }
+
+    TEST(TestRadixPriQueue, testEraseAndPushOrUpdate)
+    {
+        auto radix_pri_queue = RadixPriQueue<std::string, int64_t>({ "A-star", "Dijkstra", "RRT", "PRM" },
+            { 40, 7, int64_t(1) << 50, 7 });
+        EXPECT_THROW(radix_pri_queue.push("A-star", 1), std::logic_error);
+        EXPECT_THROW(radix_pri_queue.push("RRT-star", -1), std::invalid_argument);
+        // 可以通过常量引用查看队首元素，查看不修改队列，之后仍可插入优先级更小的元素。
+        const auto& const_pri_queue = radix_pri_queue;
+        EXPECT_EQ(const_pri_queue.topNode().second, 7);
+        EXPECT_EQ(const_pri_queue.top(), const_pri_queue.topNode().first);
+        radix_pri_queue.push("Hybrid A-star", 6);
+        EXPECT_EQ(const_pri_queue.top(), "Hybrid A-star");
+        EXPECT_EQ(radix_pri_queue.popAndReturn().second, 6);
+        // 出队后不得插入优先级更小的元素。
+        EXPECT_THROW(radix_pri_queue.push("Hybrid A-star", 5), std::invalid_argument);
+        EXPECT_THROW(radix_pri_queue.updatePriority("A-star", 5), std::invalid_argument);
+        radix_pri_queue.erase("RRT");
+        EXPECT_THROW(radix_pri_queue.erase("RRT"), std::out_of_range);
+        EXPECT_FALSE(radix_pri_queue.pushOrUpdate("A-star", 8));
+        EXPECT_TRUE(radix_pri_queue.pushOrUpdate("RRT", 7));
+        EXPECT_EQ(radix_pri_queue.size(), 4u);
+        std::vector<int64_t> popped_priorities;
+        while (!radix_pri_queue.empty()) {
+            // 优先级相同时查看的队首元素与出队的元素相同。
+            std::string expected_element = const_pri_queue.top();
+            auto [element, pri] = radix_pri_queue.popAndReturn();
+            EXPECT_EQ(element, expected_element);
+            popped_priorities.push_back(pri);
+        }
+        EXPECT_EQ(popped_priorities, (std::vector<int64_t> { 7, 7, 7, 8 }));
+        EXPECT_THROW(radix_pri_queue.top(), std::out_of_range);
+        EXPECT_THROW(radix_pri_queue.pop(), std::out_of_range);
+    }
+}
+}
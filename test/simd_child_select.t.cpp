@@ -0,0 +1,163 @@
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <gtest/gtest.h>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include "../src/d_ary_heap.hpp"
+#include "../src/simd_child_select.hpp"
+
+namespace custom_cont::test_simd_child_select {
+constexpr int RAND_SEED = 20240417;
+
+// 逐个比较D个连续节点，返回最应该靠近堆顶的那个的序号。
+template <typename T, int D, typename Compare>
+size_t selectBestChildOneByOne(const T* first)
+{
+    size_t best_child_ord = 0;
+    for (size_t child_ord = 1; child_ord < D; ++child_ord) {
+        if (Compare()(first[best_child_ord], first[child_ord])) {
+            best_child_ord = child_ord;
+        }
+    }
+    return best_child_ord;
+}
+
+// 在取值范围较小的随机数据上比较向量化选择和逐个比较的结果，较小的取值范围可以产生大量相同的值。
+template <typename T, int D, typename Compare>
+void expectSameAsOneByOne(int max_value)
+{
+    if constexpr (simd::canSelectBestChild<T, D, Compare>()) {
+        std::mt19937 rand_gen(RAND_SEED);
+        std::uniform_int_distribution<int> rand_dist(0, max_value);
+        std::vector<T> children(D);
+        for (int i = 0; i < 2000; i++) {
+            for (auto& child : children) {
+                child = static_cast<T>(rand_dist(rand_gen)) - static_cast<T>(std::is_signed_v<T> ? max_value / 2 : 0);
+            }
+            EXPECT_EQ((simd::selectBestChild<T, D, Compare>(children.data())),
+                (selectBestChildOneByOne<T, D, Compare>(children.data())));
+        }
+    }
+}
+
+// 比较编译期确定d的堆和std::priority_queue的出队顺序。
+template <typename T, int D, typename Compare>
+void expectSameAsSTDHeap()
+{
+    std::mt19937 rand_gen(RAND_SEED);
+    std::uniform_int_distribution<int> rand_dist(0, 5000);
+    std::vector<T> nodes;
+    auto d_heap = DAryHeap<T, D, Compare>(D, Compare(), std::vector<T>());
+    for (int i = 0; i < 3000; i++) {
+        auto node = static_cast<T>(rand_dist(rand_gen));
+        nodes.push_back(node);
+        d_heap.push(node);
+    }
+    auto built_d_heap = DAryHeap<T, D, Compare>(D, Compare(), nodes);
+    std::make_heap(nodes.begin(), nodes.end(), Compare());
+    while (!nodes.empty()) {
+        EXPECT_EQ(d_heap.popAndReturn(), nodes.front());
+        EXPECT_EQ(built_d_heap.popAndReturn(), nodes.front());
+        std::pop_heap(nodes.begin(), nodes.end(), Compare());
+        nodes.pop_back();
+    }
+    EXPECT_TRUE(d_heap.empty());
+    EXPECT_TRUE(built_d_heap.empty());
+}
+
+template <typename T, int D>
+void expectSelectionCorrect()
+{
+    for (int max_value : { 3, 100, 1 << 20 }) {
+        expectSameAsOneByOne<T, D, std::greater<T>>(max_value);
+        expectSameAsOneByOne<T, D, std::less<T>>(max_value);
+        expectSameAsOneByOne<T, D, std::greater<>>(max_value);
+        expectSameAsOneByOne<T, D, std::less<>>(max_value);
+    }
+    expectSameAsSTDHeap<T, D, std::greater<T>>();
+    expectSameAsSTDHeap<T, D, std::less<T>>();
+}
+
+TEST(TestSimdChildSelect, testInt)
+{
+    expectSelectionCorrect<int, 4>();
+    expectSelectionCorrect<int, 8>();
+    expectSelectionCorrect<int, 16>();
+}
+
+TEST(TestSimdChildSelect, testUInt32)
+{
+    expectSelectionCorrect<uint32_t, 4>();
+    expectSelectionCorrect<uint32_t, 8>();
+    expectSelectionCorrect<uint32_t, 16>();
+}
+
+TEST(TestSimdChildSelect, testFloat)
+{
+    expectSelectionCorrect<float, 4>();
+    expectSelectionCorrect<float, 8>();
+    expectSelectionCorrect<float, 16>();
+}
+
+TEST(TestSimdChildSelect, testDouble)
+{
+    expectSelectionCorrect<double, 4>();
+    expectSelectionCorrect<double, 8>();
+    expectSelectionCorrect<double, 16>();
+}
+
+// 子节点中包含NaN时选出的序号依然在范围内，堆的操作不会越界。
+template <typename T, int D, typename Compare>
+void expectNaNSafe()
+{
+    std::mt19937 rand_gen(RAND_SEED);
+    std::uniform_int_distribution<int> rand_dist(0, 100);
+    if constexpr (simd::canSelectBestChild<T, D, Compare>()) {
+        std::vector<T> children(D);
+        for (int i = 0; i < 2000; i++) {
+            for (auto& child : children) {
+                int value = rand_dist(rand_gen);
+                child = value < 30 ? std::numeric_limits<T>::quiet_NaN() : static_cast<T>(value);
+            }
+            EXPECT_LT((simd::selectBestChild<T, D, Compare>(children.data())), static_cast<size_t>(D));
+        }
+        std::fill(children.begin(), children.end(), std::numeric_limits<T>::quiet_NaN());
+        EXPECT_EQ((simd::selectBestChild<T, D, Compare>(children.data())), 0u);
+    }
+    auto d_heap = DAryHeap<T, D, Compare>(D, Compare(), std::vector<T>());
+    for (int i = 0; i < 3000; i++) {
+        int value = rand_dist(rand_gen);
+        d_heap.push(value < 30 ? std::numeric_limits<T>::quiet_NaN() : static_cast<T>(value));
+    }
+    size_t num_popped = 0;
+    while (!d_heap.empty()) {
+        d_heap.pop();
+        num_popped += 1;
+    }
+    EXPECT_EQ(num_popped, 3000u);
+}
+
+TEST(TestSimdChildSelect, testNaN)
+{
+    expectNaNSafe<float, 8, std::greater<float>>();
+    expectNaNSafe<float, 16, std::less<float>>();
+    expectNaNSafe<double, 4, std::greater<double>>();
+    expectNaNSafe<double, 8, std::less<>>();
+}
+
+TEST(TestSimdChildSelect, testAvailability)
+{
+#if defined(__SSE4_1__)
+    EXPECT_TRUE((simd::canSelectBestChild<int, 4, std::less<int>>()));
+    EXPECT_TRUE((simd::canSelectBestChild<float, 8, std::greater<float>>()));
+    EXPECT_TRUE((simd::canSelectBestChild<double, 16, std::greater<>>()));
+#endif
+    EXPECT_FALSE((simd::canSelectBestChild<int, 2, std::less<int>>()));
+    EXPECT_FALSE((simd::canSelectBestChild<int, 6, std::less<int>>()));
+    EXPECT_FALSE((simd::canSelectBestChild<int, 8, std::function<bool(const int&, const int&)>>()));
+    EXPECT_FALSE((simd::canSelectBestChild<int64_t, 8, std::less<int64_t>>()));
+}
+}
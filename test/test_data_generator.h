@@ -36,13 +36,13 @@ struct MyNodeHasher {
     }
 };
 
-auto genNodeFunc = []() {
+inline auto genNodeFunc = []() {
     int node_id = std::rand() % 100000;
     int g = 0.1 * (std::rand() % 10000), h = 0.1 * (std::rand() % 10000);
     return MyNode(node_id, g, h);
 };
 
-auto genStrFunc = []() {
+inline auto genStrFunc = []() {
     int length = std::rand() % 30;
     std::string rand_str = "";
     if (length <= 0) {
@@ -66,14 +66,14 @@ auto genStrFunc = []() {
 };
 
 template <typename T>
-auto createSTDMinPriQueue = []() {
+inline auto createSTDMinPriQueue = []() {
     auto cmpFunc = [](const T& element1, const T& element2) {
         return element1 > element2;
     };
     return std::priority_queue<T, std::vector<T>, decltype(cmpFunc)>(cmpFunc);
 };
 template <typename T>
-auto createSTDMaxPriQueue = []() {
+inline auto createSTDMaxPriQueue = []() {
     auto cmpFunc = [](const T& element1, const T& element2) {
         return element1 < element2;
     };
@@ -0,0 +1,113 @@
+#include <atomic>
+#include <gtest/gtest.h>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "../src/work_stealing_scheduler.hpp"
+
+namespace custom_cont {
+namespace test_work_stealing_scheduler {
+    TEST(TestWorkStealingScheduler, testRunAllTasks)
+    {
+        WorkStealingScheduler<> scheduler(4);
+        std::atomic<int> num_executed { 0 };
+        for (int round = 0; round < 3; round++) {
+            for (int i = 0; i < 10000; i++) {
+                scheduler.submit(i % 7, [&num_executed]() { num_executed.fetch_add(1); });
+            }
+            scheduler.waitIdle();
+            EXPECT_EQ(num_executed.load(), (round + 1) * 10000);
+        }
+        EXPECT_EQ(scheduler.numWorkers(), 4u);
+        EXPECT_THROW(scheduler.submitTo(4, 0, []() {}), std::out_of_range);
+        EXPECT_THROW(WorkStealingScheduler<>(0), std::invalid_argument);
+        // 默认至少有一个工作线程。
+        EXPECT_GE(WorkStealingScheduler<>().numWorkers(), 1u);
+    }
+
+    TEST(TestWorkStealingScheduler, testPriorityOrder)
+    {
+        // 唯一的工作线程被阻塞时提交的任务，在它恢复后按照优先级从高到低执行，优先级相同时按照提交的顺序执行。
+        WorkStealingScheduler<double> scheduler(1);
+        std::atomic<bool> released { false };
+        scheduler.submit(0.0, [&released]() {
+            while (!released.load()) {
+                std::this_thread::yield();
+            }
+        });
+        std::vector<std::pair<double, int>> executed;
+        std::vector<double> priorities { 0.5, 2.0, -1.0, 2.0, 0.5, 3.0 };
+        for (int i = 0; i < static_cast<int>(priorities.size()); i++) {
+            double pri = priorities[i];
+            scheduler.submit(pri, [&executed, pri, i]() { executed.emplace_back(pri, i); });
+        }
+        released.store(true);
+        scheduler.waitIdle();
+        std::vector<std::pair<double, int>> expected_executed { { 3.0, 5 }, { 2.0, 1 }, { 2.0, 3 }, { 0.5, 0 },
+            { 0.5, 4 }, { -1.0, 2 } };
+        EXPECT_EQ(executed, expected_executed);
+    }
+
+    TEST(TestWorkStealingScheduler, testStealing)
+    {
+        // 一个任务在自己的工作线程中提交大量子任务后等待它们执行完毕，这些子任务只能被其他工作线程窃取。
+        constexpr int NUM_CHILDREN = 1000;
+        WorkStealingScheduler<> scheduler(4);
+        std::atomic<int> num_executed { 0 };
+        scheduler.submitTo(0, 0, [&scheduler, &num_executed]() {
+            for (int i = 0; i < NUM_CHILDREN; i++) {
+                scheduler.submit(i, [&num_executed]() { num_executed.fetch_add(1); });
+            }
+            while (num_executed.load() < NUM_CHILDREN) {
+                std::this_thread::yield();
+            }
+        });
+        scheduler.waitIdle();
+        EXPECT_EQ(num_executed.load(), NUM_CHILDREN);
+        EXPECT_GE(scheduler.numStolen(), static_cast<size_t>(NUM_CHILDREN));
+    }
+
+    TEST(TestWorkStealingScheduler, testException)
+    {
+        WorkStealingScheduler<> scheduler(2);
+        std::atomic<int> num_executed { 0 };
+        for (int i = 0; i < 100; i++) {
+            scheduler.submit(i, [i, &num_executed]() {
+                num_executed.fetch_add(1);
+                if (i == 42) {
+                    throw std::runtime_error("Task failed!!!");
+                }
+            });
+        }
+        EXPECT_THROW(scheduler.waitIdle(), std::runtime_error);
+        EXPECT_EQ(num_executed.load(), 100);
+        scheduler.submit(0, []() {});
+        EXPECT_NO_THROW(scheduler.waitIdle());
+    }
+    // 复制时抛出异常的任务，用于模拟提交任务失败。
+    struct ThrowingTask {
+        ThrowingTask() = default;
+        ThrowingTask(const ThrowingTask&) { throw std::runtime_error("Failed to copy the task!!!"); }
+        void operator()() const { }
+    };
+
+    TEST(TestWorkStealingScheduler, testSubmitFailure)
+    {
+        WorkStealingScheduler<> scheduler(2);
+        std::atomic<int> num_executed { 0 };
+        ThrowingTask throwing_task;
+        EXPECT_THROW(scheduler.submitTo(0, 1, throwing_task), std::runtime_error);
+        EXPECT_THROW(scheduler.submit(1, throwing_task), std::runtime_error);
+        // 提交失败的任务不计入未完成的任务，等待不会一直阻塞。
+        scheduler.waitIdle();
+        for (int i = 0; i < 100; i++) {
+            scheduler.submit(i, [&num_executed]() { num_executed.fetch_add(1); });
+        }
+        scheduler.waitIdle();
+        EXPECT_EQ(num_executed.load(), 100);
+    }
+}
+}